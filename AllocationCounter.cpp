@@ -0,0 +1,66 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<std::uint64_t> allocationCount(0);
+static std::atomic<std::uint64_t> allocatedBytes(0);
+
+/**
+ * @brief Count and perform one allocation
+ * @param byteCount Requested size
+ * @return Allocated memory, or nullptr if malloc failed
+ */
+static void* allocateCounted(std::size_t byteCount) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(byteCount, std::memory_order_relaxed);
+    return std::malloc(byteCount > 0 ? byteCount : 1);
+}
+
+std::uint64_t AllocationCounter::getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::getAllocatedBytes() {
+    return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t byteCount) {
+    void* memory = allocateCounted(byteCount);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t byteCount) {
+    void* memory = allocateCounted(byteCount);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(std::size_t byteCount, const std::nothrow_t&) noexcept {
+    return allocateCounted(byteCount);
+}
+
+void* operator new[](std::size_t byteCount, const std::nothrow_t&) noexcept {
+    return allocateCounted(byteCount);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
@@ -0,0 +1,28 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * @brief AllocationCounter class to count heap allocations made through operator new
+ *
+ * AllocationCounter.cpp replaces the global operator new/delete, so it is linked only
+ * into test and benchmark builds; the interactive system keeps the library allocator.
+ * Counters are process-wide and relaxed, so read them around single-threaded sections.
+ */
+class AllocationCounter {
+public:
+    /**
+     * @brief Get the number of allocations made so far
+     * @return Calls to any form of operator new since program start
+     */
+    static std::uint64_t getAllocationCount();
+
+    /**
+     * @brief Get the number of bytes requested so far
+     * @return Bytes requested from operator new since program start
+     */
+    static std::uint64_t getAllocatedBytes();
+};
+
+#endif // ALLOCATION_COUNTER_H
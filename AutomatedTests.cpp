@@ -3,10 +3,59 @@
 #include <chrono>
 #include <thread>
 #include <sstream>
+#include <fstream>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
 #include "WindshieldWiperController.h"
+#include "SimulationClock.h"
+#include "WiperSpeedThresholdTable.h"
+#include "AutomaticModeTransitionTable.h"
+#include "PackedControllerState.h"
+#include "PeriodicScheduler.h"
+#include "EventLogger.h"
+#include "SensorTraceRecorder.h"
+#include "SensorTraceReplayer.h"
 #include "RainSensor.h"
+#include "CounterBasedRandom.h"
+#include "WorkStealingThreadPool.h"
+#include "FleetSimulationEngine.h"
+#include "HierarchicalTimerWheel.h"
+#include "LatencyTracer.h"
+#include "MetricsRegistry.h"
+#include "MetricsHttpEndpoint.h"
 #include "WiperEnums.h"
 #include "ColorUtilities.h"
+#include "StatusDisplay.h"
+#include "StatusLineRenderer.h"
+#include "AllocationCounter.h"
+#include "WiperSystemManager.h"
+#include "ConsoleEventLoop.h"
+#include "ConsoleInput.h"
+
+#include <fcntl.h>
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+/**
+ * @brief Example vehicle calibration: wipes earlier, flags smaller bursts, shorter turn-off delay
+ */
+struct EarlyWipeCalibration {
+    static constexpr double OFF_MIN_LIGHT_PERCENTAGE = 90.0;
+    static constexpr double LOW_MIN_LIGHT_PERCENTAGE = 60.0;
+    static constexpr double MEDIUM_MIN_LIGHT_PERCENTAGE = 30.0;
+    static constexpr double SUDDEN_BURST_DELTA_PERCENTAGE = 20.0;
+    static constexpr int TURN_OFF_DELAY_SECONDS = 5;
+};
 
 class AutomatedTestSuite {
 private:
@@ -29,6 +78,88 @@ private:
         }
     }
     
+    /**
+     * @brief Create (or truncate) a file that captures a headless system's console lines
+     * @param filePath Path of the capture file
+     * @return Writable descriptor, or -1 on failure
+     */
+    int openConsoleCaptureFile(const std::string& filePath) {
+#if !defined(_WIN32)
+        return ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#else
+        return _open(filePath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#endif
+    }
+    
+    /**
+     * @brief Close a capture descriptor and return everything written to it
+     * @param fileDescriptor Descriptor from openConsoleCaptureFile()
+     * @param filePath Path of the capture file (removed afterwards)
+     * @return Captured console text
+     */
+    std::string readConsoleCaptureFile(int fileDescriptor, const std::string& filePath) {
+#if !defined(_WIN32)
+        ::close(fileDescriptor);
+#else
+        _close(fileDescriptor);
+#endif
+        std::ifstream captureFile(filePath.c_str(), std::ios::binary);
+        std::stringstream capturedText;
+        capturedText << captureFile.rdbuf();
+        captureFile.close();
+        std::remove(filePath.c_str());
+        return capturedText.str();
+    }
+    
+    /**
+     * @brief Count the lines containing a marker in a console capture file that is still open
+     * @param filePath Capture file path
+     * @param lineMarker Text that identifies the lines to count
+     * @return Number of matching lines written so far
+     */
+    std::size_t countCapturedLines(const std::string& filePath, const std::string& lineMarker) {
+        std::ifstream captureFile(filePath.c_str(), std::ios::binary);
+        std::size_t lineCount = 0;
+        std::string capturedLine;
+        while (std::getline(captureFile, capturedLine)) {
+            lineCount += (capturedLine.find(lineMarker) != std::string::npos) ? 1 : 0;
+        }
+        return lineCount;
+    }
+    
+    /**
+     * @brief Send one HTTP GET to a localhost port and return the raw response
+     * @param listenPort Port on 127.0.0.1
+     * @param requestPath Path to request
+     * @return Status line, headers and body, or an empty string if the connection failed
+     */
+    std::string fetchLocalHttp(unsigned short listenPort, const std::string& requestPath) {
+        std::string responseText;
+#if !defined(_WIN32)
+        int clientSocket = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in serverAddress = {};
+        serverAddress.sin_family = AF_INET;
+        serverAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        serverAddress.sin_port = htons(listenPort);
+        if (clientSocket >= 0 && connect(clientSocket, reinterpret_cast<struct sockaddr*>(&serverAddress), sizeof(serverAddress)) == 0) {
+            std::string requestText = "GET " + requestPath + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+            send(clientSocket, requestText.data(), requestText.size(), 0);
+            char receiveBuffer[4096];
+            ssize_t receivedBytes;
+            while ((receivedBytes = recv(clientSocket, receiveBuffer, sizeof(receiveBuffer), 0)) > 0) {
+                responseText.append(receiveBuffer, static_cast<std::size_t>(receivedBytes));
+            }
+        }
+        if (clientSocket >= 0) {
+            close(clientSocket);
+        }
+#else
+        (void)listenPort;
+        (void)requestPath;
+#endif
+        return responseText;
+    }
+    
     void printTestHeader(const std::string& category) {
         std::cout << "\n" << std::string(70, '-') << std::endl;
         std::cout << category << std::endl;
@@ -44,7 +175,28 @@ public:
         // Run all test categories
         testSystemInitialization();
         testAutoModeBasics();
+        testBatchSpeedMapping();
         testTurnOffDelay();
+        testCountdownEvents();
+        testTransitionTable();
+        testPackedControllerState();
+        testVirtualTimeTurnOffDelay();
+        testCalibrationPolicy();
+        testPeriodicScheduler();
+        testEventLogger();
+        testSensorTraceRecorder();
+        testSensorTraceReplay();
+        testQuantizedPipeline();
+        testCounterBasedSensor();
+        testParallelFleetStepping();
+        testTurnOffTimerWheel();
+        testLatencyTracer();
+        testMetricsRegistry();
+        testMetricsHttpEndpoint();
+        testAllocationFreeTickPath();
+        testStatusLineRenderer();
+        testStatusDecimation();
+        testConsoleEventLoop();
         testManualModeBasics();
         testSprayFunctionality();
         testModeSwitching();
@@ -100,6 +252,76 @@ private:
         logTest("TC-004c: Light 20% boundary (MEDIUM)", speed20 == WindshieldWiperSpeed::MEDIUM);
     }
     
+    void testBatchSpeedMapping() {
+        printTestHeader("BATCH SPEED MAPPING TESTS");
+        
+        WiperSpeedThresholdTable defaultTable = WiperSpeedThresholdTable::createDefaultTable();
+        
+        // Boundaries, out-of-range values and an odd count to exercise the scalar tail
+        std::vector<double> lightSamples;
+        const double edgeValues[] = {-1.0, 0.0, 19.999, 20.0, 49.999, 50.0, 79.999, 80.0, 100.0, NAN};
+        for (double edgeValue : edgeValues) {
+            lightSamples.push_back(edgeValue);
+        }
+        for (int sampleIndex = 0; sampleIndex < 1001; sampleIndex++) {
+            lightSamples.push_back((sampleIndex * 37 % 1000) / 10.0);
+        }
+        
+        // TC-024: Batch kernel agrees with the scalar controller mapping
+        std::vector<WindshieldWiperSpeed> batchSpeeds(lightSamples.size());
+        defaultTable.mapLightPercentagesToWiperSpeeds(lightSamples.data(), batchSpeeds.data(), lightSamples.size());
+        bool allSpeedsMatch = true;
+        for (std::size_t sampleIndex = 0; sampleIndex < lightSamples.size(); sampleIndex++) {
+            if (batchSpeeds[sampleIndex] != WindshieldWiperController::mapLightPercentageToWiperSpeed(lightSamples[sampleIndex])) {
+                allSpeedsMatch = false;
+            }
+        }
+        logTest(std::string("TC-024: Batch mapping matches scalar mapping (") + WiperSpeedThresholdTable::getActiveInstructionSet() + ")",
+                allSpeedsMatch);
+        
+        // TC-025: Configurable N-level tables
+        std::vector<double> sixLevelThresholds;
+        for (double threshold = 90.0; threshold > 0.0; threshold -= 20.0) {
+            sixLevelThresholds.push_back(threshold);
+        }
+        WiperSpeedThresholdTable sixLevelTable(sixLevelThresholds);
+        std::vector<std::uint8_t> batchLevels(lightSamples.size());
+        sixLevelTable.mapLightPercentagesToLevels(lightSamples.data(), batchLevels.data(), lightSamples.size());
+        bool allLevelsMatch = sixLevelTable.getLevelCount() == 6;
+        for (std::size_t sampleIndex = 0; sampleIndex < lightSamples.size(); sampleIndex++) {
+            if (batchLevels[sampleIndex] != sixLevelTable.mapLightPercentageToLevel(lightSamples[sampleIndex])) {
+                allLevelsMatch = false;
+            }
+        }
+        logTest("TC-025a: Six-level table batch matches scalar levels", allLevelsMatch);
+        logTest("TC-025b: Six-level table places 95% and 5% at the extremes",
+                sixLevelTable.mapLightPercentageToLevel(95.0) == 0 &&
+                sixLevelTable.mapLightPercentageToLevel(5.0) == 5);
+        
+        bool rejectedUnsortedTable = false;
+        try {
+            std::vector<double> unsortedThresholds;
+            unsortedThresholds.push_back(20.0);
+            unsortedThresholds.push_back(80.0);
+            WiperSpeedThresholdTable unsortedTable(unsortedThresholds);
+        } catch (const std::invalid_argument&) {
+            rejectedUnsortedTable = true;
+        }
+        logTest("TC-025c: Non-descending thresholds are rejected", rejectedUnsortedTable);
+        
+        int rejectedOutOfRangeCount = 0;
+        const double outOfRangeThresholds[][2] = {{150.0, 50.0}, {50.0, -10.0}, {327.68, 20.0}};
+        for (std::size_t tableIndex = 0; tableIndex < 3; tableIndex++) {
+            try {
+                std::vector<double> thresholdList(outOfRangeThresholds[tableIndex], outOfRangeThresholds[tableIndex] + 2);
+                WiperSpeedThresholdTable outOfRangeTable(thresholdList);
+            } catch (const std::invalid_argument&) {
+                rejectedOutOfRangeCount++;
+            }
+        }
+        logTest("TC-025d: Thresholds outside 0-100% are rejected before quantizing", rejectedOutOfRangeCount == 3);
+    }
+    
     void testTurnOffDelay() {
         printTestHeader("10-SECOND TURN-OFF DELAY TESTS");
         
@@ -153,6 +375,1447 @@ private:
                 !controller.isWaitingToTurnOffWipers());
     }
     
+    void testCountdownEvents() {
+        printTestHeader("TURN-OFF COUNTDOWN EVENT TESTS");
+        
+        RainSensor::SensorReadingData clearData;
+        clearData.isValidReading = true;
+        clearData.isSuddenRainBurst = false;
+        clearData.isDewPresent = false;
+        clearData.lightPercentage = 90.0;
+        clearData.dewLevel = 0.0;
+        
+        WindshieldWiperSpeed wiperSpeed = WindshieldWiperSpeed::LOW;
+        bool isWaitingToTurnOff = false;
+        
+        // TC-021: Countdown lifecycle reported by the shared rules
+        TurnOffCountdownEvent startEvent = WindshieldWiperController::applyAutomaticModeRules(clearData, wiperSpeed, isWaitingToTurnOff, false);
+        logTest("TC-021a: Clear sky with wipers on starts countdown",
+                startEvent == TurnOffCountdownEvent::STARTED && isWaitingToTurnOff &&
+                wiperSpeed == WindshieldWiperSpeed::LOW);
+        
+        TurnOffCountdownEvent pendingEvent = WindshieldWiperController::applyAutomaticModeRules(clearData, wiperSpeed, isWaitingToTurnOff, false);
+        logTest("TC-021b: Countdown stays pending until delay elapses",
+                pendingEvent == TurnOffCountdownEvent::NONE && isWaitingToTurnOff);
+        
+        TurnOffCountdownEvent expiredEvent = WindshieldWiperController::applyAutomaticModeRules(clearData, wiperSpeed, isWaitingToTurnOff, true);
+        logTest("TC-021c: Elapsed countdown turns wipers OFF",
+                expiredEvent == TurnOffCountdownEvent::EXPIRED && !isWaitingToTurnOff &&
+                wiperSpeed == WindshieldWiperSpeed::OFF);
+        
+        wiperSpeed = WindshieldWiperSpeed::MEDIUM;
+        WindshieldWiperController::applyAutomaticModeRules(clearData, wiperSpeed, isWaitingToTurnOff, false);
+        RainSensor::SensorReadingData rainData = clearData;
+        rainData.lightPercentage = 40.0;
+        TurnOffCountdownEvent cancelEvent = WindshieldWiperController::applyAutomaticModeRules(rainData, wiperSpeed, isWaitingToTurnOff, false);
+        logTest("TC-021d: Returning rain cancels countdown",
+                cancelEvent == TurnOffCountdownEvent::CANCELLED && !isWaitingToTurnOff &&
+                wiperSpeed == WindshieldWiperSpeed::MEDIUM);
+    }
+    
+    void testTransitionTable() {
+        printTestHeader("TABLE-DRIVEN STATE MACHINE TESTS");
+        
+        AutomaticModeTransitionTable transitionTable;
+        
+        // TC-052: Every state/input combination matches the if/else rules (manual mode is unchanged)
+        bool isEveryEntryMatching = true;
+        for (std::size_t entryIndex = 0; entryIndex < AutomaticModeTransitionTable::ENTRY_COUNT; entryIndex++) {
+            WindshieldWiperSpeed initialSpeed = static_cast<WindshieldWiperSpeed>(entryIndex & 3);
+            bool isInitiallyWaiting = ((entryIndex >> 2) & 1) != 0;
+            OperatingMode operatingMode = ((entryIndex >> 3) & 1) != 0 ? OperatingMode::AUTOMATIC : OperatingMode::MANUAL;
+            RainSensor::SensorReadingData sensorData = RainSensor::SensorReadingData();
+            sensorData.isValidReading = ((entryIndex >> 4) & 1) != 0;
+            sensorData.isSuddenRainBurst = ((entryIndex >> 5) & 1) != 0;
+            WindshieldWiperSpeed targetSpeed = static_cast<WindshieldWiperSpeed>((entryIndex >> 6) & 3);
+            bool hasTurnOffDelayElapsed = ((entryIndex >> 8) & 1) != 0;
+            
+            WindshieldWiperSpeed expectedSpeed = initialSpeed;
+            bool isExpectedWaiting = isInitiallyWaiting;
+            TurnOffCountdownEvent expectedEvent = TurnOffCountdownEvent::NONE;
+            if (operatingMode == OperatingMode::AUTOMATIC) {
+                expectedEvent = WindshieldWiperController::applyAutomaticModeRules(sensorData, targetSpeed, expectedSpeed,
+                                                                                   isExpectedWaiting, hasTurnOffDelayElapsed);
+            }
+            WindshieldWiperSpeed tableSpeed = initialSpeed;
+            bool isTableWaiting = isInitiallyWaiting;
+            TurnOffCountdownEvent tableEvent = transitionTable.applyTransition(sensorData, targetSpeed, operatingMode,
+                                                                               tableSpeed, isTableWaiting, hasTurnOffDelayElapsed);
+            isEveryEntryMatching = isEveryEntryMatching &&
+                AutomaticModeTransitionTable::encodeIndex(initialSpeed, isInitiallyWaiting, operatingMode, sensorData.isValidReading,
+                                                          sensorData.isSuddenRainBurst, targetSpeed, hasTurnOffDelayElapsed) == entryIndex &&
+                tableSpeed == expectedSpeed && isTableWaiting == isExpectedWaiting && tableEvent == expectedEvent;
+        }
+        logTest("TC-052: All 512 transitions match applyAutomaticModeRules", isEveryEntryMatching);
+        
+        // TC-053: Batch stepping tracks individual controllers over a long sensor sequence
+        const std::size_t CONTROLLER_COUNT = 64;
+        std::vector<WindshieldWiperController> controllers(CONTROLLER_COUNT);
+        std::vector<RainSensor> controllerSensors;
+        for (std::size_t controllerIndex = 0; controllerIndex < CONTROLLER_COUNT; controllerIndex++) {
+            controllerSensors.push_back(RainSensor(21, controllerIndex));
+        }
+        std::vector<std::uint8_t> validFlags(CONTROLLER_COUNT), burstFlags(CONTROLLER_COUNT), elapsedFlags(CONTROLLER_COUNT), waitingFlags(CONTROLLER_COUNT, 0);
+        std::vector<WindshieldWiperSpeed> targetSpeeds(CONTROLLER_COUNT), batchSpeeds(CONTROLLER_COUNT, WindshieldWiperSpeed::OFF);
+        std::vector<OperatingMode> operatingModes(CONTROLLER_COUNT, OperatingMode::AUTOMATIC);
+        std::vector<TurnOffCountdownEvent> countdownEvents(CONTROLLER_COUNT);
+        std::vector<int> countdownStartSeconds(CONTROLLER_COUNT, 0);
+        std::chrono::steady_clock::time_point startTime;
+        bool isBatchMatching = true;
+        for (int secondIndex = 0; secondIndex < 2000 && isBatchMatching; secondIndex++) {
+            std::chrono::steady_clock::time_point currentTime = startTime + std::chrono::seconds(secondIndex);
+            for (std::size_t controllerIndex = 0; controllerIndex < CONTROLLER_COUNT; controllerIndex++) {
+                RainSensor::SensorReadingData sensorData = controllerSensors[controllerIndex].readSensorData();
+                validFlags[controllerIndex] = sensorData.isValidReading ? 1 : 0;
+                burstFlags[controllerIndex] = sensorData.isSuddenRainBurst ? 1 : 0;
+                targetSpeeds[controllerIndex] = WindshieldWiperController::mapLightPercentageToWiperSpeed(sensorData.lightPercentage);
+                elapsedFlags[controllerIndex] = (waitingFlags[controllerIndex] != 0 &&
+                    secondIndex - countdownStartSeconds[controllerIndex] >= WindshieldWiperController::TURN_OFF_DELAY_SECONDS) ? 1 : 0;
+                controllers[controllerIndex].processAutomaticModeOperation(sensorData, currentTime);
+            }
+            transitionTable.stepBatch(validFlags.data(), burstFlags.data(), targetSpeeds.data(), elapsedFlags.data(),
+                                      operatingModes.data(), batchSpeeds.data(), waitingFlags.data(),
+                                      countdownEvents.data(), CONTROLLER_COUNT);
+            for (std::size_t controllerIndex = 0; controllerIndex < CONTROLLER_COUNT; controllerIndex++) {
+                if (countdownEvents[controllerIndex] == TurnOffCountdownEvent::STARTED) {
+                    countdownStartSeconds[controllerIndex] = secondIndex;
+                }
+                isBatchMatching = isBatchMatching &&
+                    batchSpeeds[controllerIndex] == controllers[controllerIndex].getCurrentWiperSpeed() &&
+                    (waitingFlags[controllerIndex] != 0) == controllers[controllerIndex].isWaitingToTurnOffWipers();
+            }
+        }
+        logTest("TC-053: stepBatch matches 64 controllers over 2000 virtual seconds", isBatchMatching);
+    }
+    
+    void testPackedControllerState() {
+        printTestHeader("PACKED CONTROLLER STATE TESTS");
+        
+        // TC-054: One word per vehicle, with lossless accessors
+        std::vector<PackedControllerState> packedStates(1000000);
+        bool isRoundTripExact = sizeof(PackedControllerState) == 8 &&
+                                packedStates.size() * sizeof(PackedControllerState) == 8000000;
+        const WindshieldWiperSpeed allSpeeds[] = {WindshieldWiperSpeed::OFF, WindshieldWiperSpeed::LOW,
+                                                  WindshieldWiperSpeed::MEDIUM, WindshieldWiperSpeed::HIGH};
+        const WaterSprayMode allSprayModes[] = {WaterSprayMode::OFF, WaterSprayMode::LIGHT_SPRAY, WaterSprayMode::HEAVY_SPRAY};
+        const OperatingMode allModes[] = {OperatingMode::MANUAL, OperatingMode::AUTOMATIC};
+        for (WindshieldWiperSpeed wiperSpeed : allSpeeds) {
+            for (WaterSprayMode sprayMode : allSprayModes) {
+                for (OperatingMode operatingMode : allModes) {
+                    PackedControllerState packedState;
+                    packedState.setWiperSpeed(wiperSpeed);
+                    packedState.setWaterSprayMode(sprayMode);
+                    packedState.setOperatingMode(operatingMode);
+                    isRoundTripExact = isRoundTripExact &&
+                        packedState.getCurrentWiperSpeed() == wiperSpeed &&
+                        packedState.getCurrentWaterSprayMode() == sprayMode &&
+                        packedState.getCurrentOperatingMode() == operatingMode &&
+                        !packedState.isWaitingToTurnOffWipers();
+                }
+            }
+        }
+        PackedControllerState defaultState;
+        WindshieldWiperController defaultController;
+        isRoundTripExact = isRoundTripExact &&
+            defaultState.getCurrentWiperSpeed() == defaultController.getCurrentWiperSpeed() &&
+            defaultState.getCurrentOperatingMode() == defaultController.getCurrentOperatingMode() &&
+            defaultState.getCurrentWaterSprayMode() == defaultController.getCurrentWaterSprayMode();
+        logTest("TC-054: 1M packed states fit in 8 MB and every field round-trips", isRoundTripExact);
+        
+        // TC-055: Tick-relative countdown tracks the controller on virtual time
+        const std::size_t CONTROLLER_COUNT = 32;
+        const unsigned int TICK_INTERVAL_MILLISECONDS = 1000;
+        std::uint32_t turnOffDelayTicks = PackedControllerState::computeTurnOffDelayTicks(TICK_INTERVAL_MILLISECONDS);
+        std::vector<WindshieldWiperController> controllers(CONTROLLER_COUNT);
+        std::vector<PackedControllerState> trackedStates(CONTROLLER_COUNT);
+        std::vector<RainSensor> controllerSensors;
+        for (std::size_t controllerIndex = 0; controllerIndex < CONTROLLER_COUNT; controllerIndex++) {
+            controllerSensors.push_back(RainSensor(33, controllerIndex));
+        }
+        std::chrono::steady_clock::time_point startTime;
+        bool isPackedMatching = turnOffDelayTicks == 10 &&
+                                PackedControllerState::computeTurnOffDelayTicks(300) == 34;
+        for (std::uint64_t tickIndex = 0; tickIndex < 2000 && isPackedMatching; tickIndex++) {
+            std::chrono::steady_clock::time_point currentTime = startTime + std::chrono::milliseconds(tickIndex * TICK_INTERVAL_MILLISECONDS);
+            for (std::size_t controllerIndex = 0; controllerIndex < CONTROLLER_COUNT; controllerIndex++) {
+                RainSensor::SensorReadingData sensorData = controllerSensors[controllerIndex].readSensorData();
+                TurnOffCountdownEvent controllerEvent = controllers[controllerIndex].processAutomaticModeOperation(sensorData, currentTime);
+                TurnOffCountdownEvent packedEvent = trackedStates[controllerIndex].processAutomaticModeOperation(sensorData, tickIndex,
+                                                                                                                turnOffDelayTicks);
+                isPackedMatching = isPackedMatching && packedEvent == controllerEvent &&
+                    trackedStates[controllerIndex].getCurrentWiperSpeed() == controllers[controllerIndex].getCurrentWiperSpeed() &&
+                    trackedStates[controllerIndex].isWaitingToTurnOffWipers() == controllers[controllerIndex].isWaitingToTurnOffWipers() &&
+                    trackedStates[controllerIndex].getRemainingTurnOffSeconds(tickIndex, TICK_INTERVAL_MILLISECONDS) ==
+                        controllers[controllerIndex].getRemainingTurnOffSeconds(currentTime);
+            }
+        }
+        logTest("TC-055: Packed states match 32 controllers over 2000 ticks", isPackedMatching);
+    }
+    
+    void testVirtualTimeTurnOffDelay() {
+        printTestHeader("VIRTUAL TIME TURN-OFF DELAY TESTS");
+        
+        WindshieldWiperController controller;
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        
+        RainSensor::SensorReadingData rainData;
+        rainData.isValidReading = true;
+        rainData.isSuddenRainBurst = false;
+        rainData.isDewPresent = false;
+        rainData.lightPercentage = 60.0;
+        rainData.dewLevel = 0.0;
+        
+        controller.processAutomaticModeOperation(rainData, virtualClock.now());
+        rainData.lightPercentage = 95.0;
+        controller.processAutomaticModeOperation(rainData, virtualClock.now());
+        
+        // TC-022: Countdown measured against virtual time
+        virtualClock.advance(std::chrono::seconds(4));
+        logTest("TC-022a: Remaining seconds follow virtual time",
+                controller.getRemainingTurnOffSeconds(virtualClock.now()) == 6);
+        
+        virtualClock.advance(std::chrono::seconds(5));
+        controller.processAutomaticModeOperation(rainData, virtualClock.now());
+        logTest("TC-022b: Wipers stay on before virtual delay elapses",
+                controller.getCurrentWiperSpeed() == WindshieldWiperSpeed::LOW &&
+                controller.isWaitingToTurnOffWipers());
+        
+        virtualClock.advance(std::chrono::seconds(1));
+        controller.processAutomaticModeOperation(rainData, virtualClock.now());
+        logTest("TC-022c: Wipers turn OFF after 10 virtual seconds",
+                controller.getCurrentWiperSpeed() == WindshieldWiperSpeed::OFF &&
+                !controller.isWaitingToTurnOffWipers());
+        
+        // TC-023: Virtual clock never follows the wall clock
+        SimulationClock::TimePoint frozenTime = virtualClock.now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        logTest("TC-023: Virtual clock only moves when advanced",
+                virtualClock.now() == frozenTime);
+    }
+    
+    void testCalibrationPolicy() {
+        printTestHeader("CALIBRATION POLICY TESTS");
+        
+        typedef BasicWindshieldWiperController<EarlyWipeCalibration> EarlyWipeController;
+        
+        // TC-050: A calibrated controller uses its own thresholds and turn-off delay
+        EarlyWipeController calibratedController;
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        RainSensor::SensorReadingData sensorData;
+        sensorData.isValidReading = true;
+        sensorData.isSuddenRainBurst = false;
+        sensorData.isDewPresent = false;
+        sensorData.dewLevel = 0.0;
+        sensorData.lightPercentage = 85.0;
+        calibratedController.processAutomaticModeOperation(sensorData, virtualClock.now());
+        bool isLowAtEightyFive = calibratedController.getCurrentWiperSpeed() == WindshieldWiperSpeed::LOW &&
+                                 WindshieldWiperController::mapLightPercentageToWiperSpeed(85.0) == WindshieldWiperSpeed::OFF;
+        sensorData.lightPercentage = 95.0;
+        calibratedController.processAutomaticModeOperation(sensorData, virtualClock.now());
+        virtualClock.advance(std::chrono::seconds(5));
+        TurnOffCountdownEvent countdownEvent = calibratedController.processAutomaticModeOperation(sensorData, virtualClock.now());
+        logTest("TC-050: Calibrated controller maps 85% to LOW and turns off after 5 s",
+                isLowAtEightyFive && EarlyWipeController::TURN_OFF_DELAY_SECONDS == 5 &&
+                countdownEvent == TurnOffCountdownEvent::EXPIRED &&
+                calibratedController.getCurrentWiperSpeed() == WindshieldWiperSpeed::OFF);
+        
+        // TC-051: Sensor bursts and batch tables follow the same policy
+        RainSensor calibratedSensor(11, 0);
+        calibratedSensor.applyCalibration<EarlyWipeCalibration>();
+        WiperSpeedThresholdTable calibratedTable = WiperSpeedThresholdTable::createCalibratedTable<EarlyWipeCalibration>();
+        bool isTableMatching = true;
+        for (int lightPercentage = 0; lightPercentage <= 100; lightPercentage++) {
+            isTableMatching = isTableMatching &&
+                calibratedTable.mapLightPercentageToLevel(lightPercentage) ==
+                static_cast<std::uint8_t>(EarlyWipeController::mapLightPercentageToWiperSpeed(lightPercentage));
+        }
+        logTest("TC-051: Sensor burst delta and threshold table come from the calibration",
+                calibratedSensor.getSuddenBurstDeltaPercentage() == 20.0 &&
+                RainSensor(11, 0).getSuddenBurstDeltaPercentage() == 30.0 && isTableMatching);
+    }
+    
+    void testPeriodicScheduler() {
+        printTestHeader("PERIODIC SCHEDULER TESTS");
+        
+        // TC-026: Rate limits
+        PeriodicScheduler fastScheduler(5000);
+        logTest("TC-026: Tick rate is clamped to 1 kHz",
+                fastScheduler.getTickRate() == PeriodicScheduler::MAX_TICK_RATE_HZ &&
+                fastScheduler.getTickPeriod() == std::chrono::milliseconds(1));
+        
+        // TC-027: Deadlines stay on the absolute grid and lateness is bucketed
+        PeriodicScheduler tickScheduler(100);
+        tickScheduler.start();
+        PeriodicScheduler::TimePoint firstDeadline = tickScheduler.getNextDeadline();
+        tickScheduler.recordTickStart(firstDeadline + std::chrono::microseconds(3));
+        logTest("TC-027a: Next deadline ignores time spent late",
+                tickScheduler.getNextDeadline() == firstDeadline + std::chrono::milliseconds(10));
+        logTest("TC-027b: 3 us lateness lands in the [2, 4) us bucket",
+                tickScheduler.getLatenessHistogram().bucketCounts[2] == 1 &&
+                tickScheduler.getLatenessHistogram().maxLatenessNanoseconds == 3000);
+        
+        // TC-028: A stall skips passed deadlines instead of bursting
+        tickScheduler.recordTickStart(firstDeadline + std::chrono::milliseconds(35));
+        logTest("TC-028: Stalled tick counts missed deadlines and realigns",
+                tickScheduler.getLatenessHistogram().missedDeadlineCount == 2 &&
+                tickScheduler.getNextDeadline() == firstDeadline + std::chrono::milliseconds(40));
+    }
+    
+    void testEventLogger() {
+        printTestHeader("BINARY EVENT LOG TESTS");
+        
+        const std::string logFilePath = "AutomatedTests_events.bin";
+        EventLogger eventLogger;
+        bool isOpened = eventLogger.open(logFilePath);
+        eventLogger.logEvent(SystemEventId::SYSTEM_STARTED, 1, static_cast<std::int32_t>(OperatingMode::AUTOMATIC));
+        eventLogger.logEvent(SystemEventId::AUTOMATIC_MODE_TICK, 5, 4207, 1, 1,
+                             static_cast<std::int32_t>(WindshieldWiperSpeed::HIGH), 0);
+        eventLogger.logEvent(SystemEventId::AUTOMATIC_MODE_TICK, 5, -100, 0, 1,
+                             static_cast<std::int32_t>(WindshieldWiperSpeed::LOW), 0);
+        eventLogger.logEvent(SystemEventId::SPRAY_MODE_SET, 1, static_cast<std::int32_t>(WaterSprayMode::LIGHT_SPRAY));
+        eventLogger.close();
+        
+        // TC-029: Status ticks decode back into the console status line text
+        std::ostringstream decodedText;
+        bool isDecoded = decodeEventLog(logFilePath, decodedText);
+        std::string decodedLines = decodedText.str();
+        logTest("TC-029a: Log opens and decodes",
+                isOpened && isDecoded && eventLogger.getDroppedEventCount() == 0);
+        logTest("TC-029b: Decoded records keep their order and arguments",
+                decodedLines.find("System started in AUTO mode") < decodedLines.find("] Mode: AUTO | Sensor: 42% | Wiper: HIGH (Sudden Rain Burst)\n") &&
+                decodedLines.find("] Mode: AUTO | Sensor: ERROR | Wiper: LOW (Sensor Failure - Switch to Manual)\n") != std::string::npos &&
+                decodedLines.find("] Setting: Spray LIGHT SPRAY\n") != std::string::npos);
+        std::string lastDecodedLine = decodedLines.substr(decodedLines.rfind('\n', decodedLines.size() - 2) + 1);
+        logTest("TC-029c: Footer reports the dropped event count on the last line",
+                lastDecodedLine.find("] Log closed, 0 events dropped\n") == lastDecodedLine.find(']') &&
+                lastDecodedLine.find(']') != std::string::npos);
+        
+        // A log cut short before close() has no footer, and the decoder says so
+        std::string logBytes;
+        std::FILE* logFile = std::fopen(logFilePath.c_str(), "rb");
+        if (logFile != nullptr) {
+            char readChunk[4096];
+            std::size_t chunkSize;
+            while ((chunkSize = std::fread(readChunk, 1, sizeof(readChunk), logFile)) > 0) {
+                logBytes.append(readChunk, chunkSize);
+            }
+            std::fclose(logFile);
+        }
+        logFile = std::fopen(logFilePath.c_str(), "wb");
+        if (logFile != nullptr) {
+            std::fwrite(logBytes.data(), 1, logBytes.size() - sizeof(EventLogRecord), logFile);
+            std::fclose(logFile);
+        }
+        std::ostringstream truncatedText;
+        logTest("TC-029d: Log without footer is reported as not closed cleanly",
+                logBytes.size() > sizeof(EventLogRecord) && decodeEventLog(logFilePath, truncatedText) &&
+                truncatedText.str().find("Log closed") == std::string::npos &&
+                truncatedText.str().find("Log not closed cleanly, dropped event count unknown\n") != std::string::npos);
+        std::remove(logFilePath.c_str());
+        
+        // TC-063: Events dropped on a full ring are persisted, and every logged event is either in the file or counted
+        const std::uint64_t floodEventCount = 20 * EventLogger::RING_CAPACITY;
+        EventLogger floodLogger;
+        bool isFloodOpened = floodLogger.open(logFilePath);
+        for (std::uint64_t eventIndex = 0; eventIndex < floodEventCount; eventIndex++) {
+            floodLogger.logEvent(SystemEventId::MANUAL_MODE_TICK, 2, static_cast<std::int32_t>(WindshieldWiperSpeed::LOW), 0);
+        }
+        floodLogger.close();
+        std::ostringstream floodText;
+        bool isFloodDecoded = decodeEventLog(logFilePath, floodText);
+        std::string floodLines = floodText.str();
+        std::uint64_t decodedTickCount = 0;
+        for (std::size_t linePosition = floodLines.find("Mode: MANUAL"); linePosition != std::string::npos;
+             linePosition = floodLines.find("Mode: MANUAL", linePosition + 1)) {
+            decodedTickCount++;
+        }
+        std::uint64_t droppedEventCount = floodLogger.getDroppedEventCount();
+        std::remove(logFilePath.c_str());
+        logTest("TC-063: Dropped event count is written on close and decoded",
+                isFloodOpened && isFloodDecoded && decodedTickCount + droppedEventCount == floodEventCount &&
+                floodLines.find("] Log closed, " + std::to_string(droppedEventCount) + " events dropped\n") != std::string::npos,
+                std::to_string(droppedEventCount) + " dropped");
+        
+        // TC-030: Files without the log header are rejected
+        std::ostringstream rejectedText;
+        logTest("TC-030: Non-log file is rejected",
+                !decodeEventLog("AutomatedTests.cpp", rejectedText) && rejectedText.str().empty());
+    }
+    
+    void testSensorTraceRecorder() {
+        printTestHeader("SENSOR TRACE RECORDING TESTS");
+        
+        const std::string traceFilePath = "AutomatedTests_trace.bin";
+        const std::size_t recordCount = SensorTraceRecorder::RECORD_BUFFER_CAPACITY + 3;
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        WindshieldWiperController controller;
+        controller.setOperatingMode(OperatingMode::AUTOMATIC);
+        
+        SensorTraceRecorder traceRecorder;
+        bool isOpened = traceRecorder.open(traceFilePath, virtualClock.now());
+        for (std::size_t recordIndex = 0; recordIndex < recordCount; recordIndex++) {
+            virtualClock.advance(std::chrono::milliseconds(10));
+            RainSensor::SensorReadingData sensorData = {15.0, true, recordIndex == 0, true, 0.5};
+            controller.processAutomaticModeOperation(sensorData, virtualClock.now());
+            traceRecorder.recordReading(virtualClock.now(), sensorData, controller);
+        }
+        traceRecorder.close();
+        
+        // TC-031: Header plus one fixed-size record per reading, including the partial last buffer
+        SensorTraceFileHeader fileHeader;
+        SensorTraceRecord firstRecord;
+        std::size_t trailingRecordCount = 0;
+        std::FILE* traceFile = std::fopen(traceFilePath.c_str(), "rb");
+        bool isReadBack = traceFile != nullptr &&
+                          std::fread(&fileHeader, sizeof(fileHeader), 1, traceFile) == 1 &&
+                          std::fread(&firstRecord, sizeof(firstRecord), 1, traceFile) == 1;
+        if (traceFile != nullptr) {
+            SensorTraceRecord traceRecord;
+            while (std::fread(&traceRecord, sizeof(traceRecord), 1, traceFile) == 1) {
+                trailingRecordCount++;
+            }
+            std::fclose(traceFile);
+        }
+        std::remove(traceFilePath.c_str());
+        
+        logTest("TC-031a: Every reading is written across buffer flushes",
+                isOpened && isReadBack && traceRecorder.getRecordedCount() == recordCount &&
+                trailingRecordCount + 1 == recordCount);
+        logTest("TC-031b: Header carries version and record size",
+                fileHeader.formatVersion == SensorTraceRecorder::FILE_FORMAT_VERSION &&
+                fileHeader.recordSize == sizeof(SensorTraceRecord));
+        logTest("TC-031c: Record keeps reading, flags, timestamp and controller state",
+                firstRecord.timestampNanoseconds == 10000000ULL &&
+                firstRecord.lightCentiPercent == 1500 && firstRecord.dewLevelCentiPercent == 50 &&
+                firstRecord.sensorFlags == (SensorTraceRecord::FLAG_VALID_READING |
+                                            SensorTraceRecord::FLAG_SUDDEN_RAIN_BURST |
+                                            SensorTraceRecord::FLAG_DEW_PRESENT) &&
+                firstRecord.wiperSpeed == static_cast<std::uint8_t>(WindshieldWiperSpeed::HIGH));
+    }
+    
+    void testSensorTraceReplay() {
+        printTestHeader("SENSOR TRACE REPLAY TESTS");
+        
+        // Record a drive with the live controller: rain, a dry spell past the turn-off delay, then a failure
+        const std::string traceFilePath = "AutomatedTests_replay.bin";
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        WindshieldWiperController recordingController;
+        recordingController.setOperatingMode(OperatingMode::AUTOMATIC);
+        SensorTraceRecorder traceRecorder;
+        traceRecorder.open(traceFilePath, virtualClock.now());
+        for (int secondIndex = 0; secondIndex < 30; secondIndex++) {
+            virtualClock.advance(std::chrono::seconds(1));
+            double lightPercentage = (secondIndex < 5) ? 10.0 : 95.0;
+            RainSensor::SensorReadingData sensorData = {lightPercentage, secondIndex != 25, false, false, 0.0};
+            recordingController.processAutomaticModeOperation(sensorData, virtualClock.now());
+            traceRecorder.recordReading(virtualClock.now(), sensorData, recordingController);
+        }
+        traceRecorder.close();
+        
+        // A half-written record at the end (recording cut short) must be ignored
+        std::FILE* traceFile = std::fopen(traceFilePath.c_str(), "ab");
+        if (traceFile != nullptr) {
+            std::fwrite("junk", 1, 4, traceFile);
+            std::fclose(traceFile);
+        }
+        
+        // TC-032: Replay reproduces the recorded decisions
+        SensorTraceReplayer traceReplayer;
+        bool isOpened = traceReplayer.open(traceFilePath);
+        WindshieldWiperController replayController;
+        std::ostringstream timelineText;
+        SensorTraceReplayer::ReplayStatistics replayStatistics =
+            traceReplayer.replayThroughController(replayController, &timelineText);
+        logTest("TC-032a: Trace maps and ignores a partial trailing record",
+                isOpened && traceReplayer.getRecordCount() == 30);
+        logTest("TC-032b: Replayed speeds match the recording",
+                replayStatistics.replayedCount == 30 && replayStatistics.mismatchCount == 0);
+        logTest("TC-032c: Timeline lists HIGH, the delayed OFF and the failure fallback",
+                replayStatistics.timelineEntryCount == 3 &&
+                timelineText.str().find("Wiper: HIGH") < timelineText.str().find("Wiper: OFF") &&
+                timelineText.str().find("Wiper: OFF") < timelineText.str().rfind("Wiper: LOW"));
+        
+        // TC-033: Replayer stands in for the live sensor
+        RainSensor::SensorReadingData replayedReading;
+        traceReplayer.rewind();
+        bool hasFirstReading = traceReplayer.readNextReading(replayedReading);
+        logTest("TC-033: Replayed reading matches the recorded one",
+                hasFirstReading && replayedReading.lightPercentage == 10.0 && replayedReading.isValidReading);
+        traceReplayer.close();
+        std::remove(traceFilePath.c_str());
+        
+        // TC-062: An AUTO -> MANUAL -> AUTO session, left while a turn-off countdown is pending, replays without mismatches.
+        // The session runs the real manager on a scripted drive (rain, then dry) and records its own trace.
+        const std::string driveTracePath = "AutomatedTests_drive_trace.bin";
+        const std::string sessionTracePath = "AutomatedTests_session_trace.bin";
+        const std::string consoleFilePath = "AutomatedTests_session_console.txt";
+        traceRecorder.open(driveTracePath, virtualClock.now());
+        for (int readingIndex = 0; readingIndex < 400; readingIndex++) {
+            RainSensor::SensorReadingData sensorData = {(readingIndex < 20) ? 30.0 : 95.0, true, false, false, 0.0};
+            traceRecorder.recordReading(virtualClock.now(), sensorData, recordingController);
+        }
+        traceRecorder.close();
+        
+        WiperSystemManager::SystemTimingConfiguration timingConfiguration = {10, 10, -1, false};
+        int consoleDescriptor = openConsoleCaptureFile(consoleFilePath);
+        SimulationClock::TimePoint tickTime = std::chrono::steady_clock::now();
+        std::uint64_t automaticTickCount = 0;
+        bool wasCountdownPending = false;
+        bool isManualSpeedKept = false;
+        {
+            WiperSystemManager wiperSystem;
+            wiperSystem.enableHeadlessConsole(consoleDescriptor);
+            wiperSystem.configureTiming(timingConfiguration);
+            wiperSystem.enableSensorReplay(driveTracePath);
+            wiperSystem.enableSensorTrace(sessionTracePath);
+            for (int tickIndex = 0; tickIndex < 25; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                wiperSystem.runControlTick(tickTime);
+                automaticTickCount++;
+            }
+            wasCountdownPending = wiperSystem.getWiperController().isWaitingToTurnOffWipers();
+            wiperSystem.handleUserCommand('m');
+            wiperSystem.handleUserCommand('3');
+            for (int tickIndex = 0; tickIndex < 10; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                wiperSystem.runControlTick(tickTime);
+            }
+            wiperSystem.handleUserCommand('a');
+            
+            // Until the original countdown runs out, auto mode holds the manual HIGH speed
+            while (wiperSystem.isRunning()) {
+                tickTime += std::chrono::milliseconds(100);
+                wiperSystem.runControlTick(tickTime);
+                automaticTickCount += wiperSystem.isRunning() ? 1 : 0;
+                if (automaticTickCount == 30) {
+                    isManualSpeedKept = wiperSystem.getWiperController().getCurrentWiperSpeed() == WindshieldWiperSpeed::HIGH;
+                }
+            }
+        }
+        readConsoleCaptureFile(consoleDescriptor, consoleFilePath);
+        
+        SensorTraceReplayer sessionReplayer;
+        WindshieldWiperController sessionController;
+        bool isSessionOpened = sessionReplayer.open(sessionTracePath);
+        SensorTraceReplayer::ReplayStatistics sessionStatistics = sessionReplayer.replayThroughController(sessionController, nullptr);
+        std::uint64_t liveReadingCount = 0;
+        while (sessionReplayer.readNextReading(replayedReading)) {
+            liveReadingCount++;
+        }
+        logTest("TC-062: Manual interval is resynced from the trace, so replay reports no mismatches",
+                isSessionOpened && wasCountdownPending && isManualSpeedKept && sessionStatistics.mismatchCount == 0 &&
+                sessionStatistics.resyncCount >= 3 && sessionStatistics.replayedCount == automaticTickCount &&
+                liveReadingCount == automaticTickCount,
+                "mismatches: " + std::to_string(sessionStatistics.mismatchCount) + ", resyncs: " +
+                std::to_string(sessionStatistics.resyncCount));
+        
+        // TC-070: Live --replay-trace of the same session, on a later host clock, finishes the pending countdown as recorded
+        const std::string liveReplayTracePath = "AutomatedTests_live_replay_trace.bin";
+        consoleDescriptor = openConsoleCaptureFile(consoleFilePath);
+        tickTime += std::chrono::seconds(3600);
+        {
+            WiperSystemManager replaySystem;
+            replaySystem.enableHeadlessConsole(consoleDescriptor);
+            replaySystem.configureTiming(timingConfiguration);
+            replaySystem.enableSensorReplay(sessionTracePath);
+            replaySystem.enableSensorTrace(liveReplayTracePath);
+            for (std::uint64_t tickIndex = 0; tickIndex <= automaticTickCount && replaySystem.isRunning(); tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                replaySystem.runControlTick(tickTime);
+            }
+        }
+        readConsoleCaptureFile(consoleDescriptor, consoleFilePath);
+        
+        SensorTraceReplayer liveReplayer;
+        bool isLiveReplayOpened = liveReplayer.open(liveReplayTracePath);
+        std::uint64_t comparedCount = 0;
+        std::uint64_t liveMismatchCount = 0;
+        std::uint64_t liveRecordIndex = 0;
+        for (std::uint64_t recordIndex = 0; isLiveReplayOpened && recordIndex < sessionReplayer.getRecordCount(); recordIndex++) {
+            const SensorTraceRecord& sessionRecord = sessionReplayer.getRecord(recordIndex);
+            if ((sessionRecord.sensorFlags & SensorTraceRecord::FLAG_STATE_RESYNC) != 0) {
+                continue;
+            }
+            if (liveRecordIndex < liveReplayer.getRecordCount()) {
+                liveMismatchCount += (liveReplayer.getRecord(liveRecordIndex).wiperSpeed != sessionRecord.wiperSpeed) ? 1 : 0;
+                comparedCount++;
+            }
+            liveRecordIndex++;
+        }
+        liveReplayer.close();
+        sessionReplayer.close();
+        std::remove(liveReplayTracePath.c_str());
+        std::remove(driveTracePath.c_str());
+        std::remove(sessionTracePath.c_str());
+        logTest("TC-070: Live trace replay through runControlTick reproduces the recorded speeds",
+                isLiveReplayOpened && comparedCount == automaticTickCount && liveMismatchCount == 0,
+                "compared: " + std::to_string(comparedCount) + ", mismatches: " + std::to_string(liveMismatchCount));
+    }
+    
+    void testQuantizedPipeline() {
+        printTestHeader("FIXED-POINT SENSOR PIPELINE TESTS");
+        
+        // TC-056: Quantized readings are the full-precision readings truncated to 0.01 %
+        const std::size_t READING_COUNT = 5000;
+        bool isQuantizationExact = sizeof(RainSensor::QuantizedReadingData) == 8 &&
+            RainSensor::quantizePercentage(-1.0) == RainSensor::INVALID_QUANTIZED_PERCENTAGE &&
+            RainSensor::quantizePercentage(100.0) == RainSensor::QUANTIZED_FULL_SCALE &&
+            RainSensor::quantizeThreshold(85.555) == 8556 && RainSensor::quantizeThreshold(80.0) == 8000;
+        std::size_t invalidCount = 0;
+        
+        // Failures latch, so one pass without the failure channel covers valid readings and one with it covers the rest
+        const std::uint8_t channelMasks[] = {RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_DEW,
+                                             RainSensor::CHANNEL_ALL};
+        for (std::uint8_t channelMask : channelMasks) {
+            RainSensor fullPrecisionSensor(56, 0);
+            RainSensor scalarSensor(56, 0);
+            RainSensor batchSensor(56, 0);
+            fullPrecisionSensor.subscribeChannels(channelMask);
+            scalarSensor.subscribeChannels(channelMask);
+            batchSensor.subscribeChannels(channelMask);
+            std::vector<RainSensor::QuantizedReadingData> batchReadings(READING_COUNT);
+            batchSensor.readQuantizedSensorBatch(batchReadings.data(), READING_COUNT);
+            for (std::size_t readingIndex = 0; readingIndex < READING_COUNT; readingIndex++) {
+                RainSensor::SensorReadingData sensorData = fullPrecisionSensor.readSensorData();
+                RainSensor::QuantizedReadingData quantizedData = scalarSensor.readQuantizedSensorData();
+                const RainSensor::QuantizedReadingData& batchData = batchReadings[readingIndex];
+                double expandedLight = RainSensor::dequantizePercentage(quantizedData.lightCentiPercent);
+                invalidCount += sensorData.isValidReading ? 0 : 1;
+                isQuantizationExact = isQuantizationExact &&
+                    quantizedData.lightCentiPercent == batchData.lightCentiPercent &&
+                    quantizedData.dewLevelCentiPercent == batchData.dewLevelCentiPercent &&
+                    quantizedData.isValidReading == batchData.isValidReading &&
+                    quantizedData.isSuddenRainBurst == batchData.isSuddenRainBurst &&
+                    quantizedData.isDewPresent == batchData.isDewPresent &&
+                    quantizedData.isValidReading == sensorData.isValidReading &&
+                    quantizedData.isSuddenRainBurst == sensorData.isSuddenRainBurst &&
+                    quantizedData.isDewPresent == sensorData.isDewPresent &&
+                    (sensorData.isValidReading ? (expandedLight <= sensorData.lightPercentage &&
+                                                  sensorData.lightPercentage - expandedLight < 0.01)
+                                               : quantizedData.lightCentiPercent == RainSensor::INVALID_QUANTIZED_PERCENTAGE) &&
+                    WindshieldWiperController::mapQuantizedLightToWiperSpeed(quantizedData.lightCentiPercent) ==
+                        WindshieldWiperController::mapLightPercentageToWiperSpeed(sensorData.lightPercentage);
+            }
+        }
+        logTest("TC-056: Scalar and batch quantized readings truncate the double readings",
+                isQuantizationExact && invalidCount > 0);
+        
+        // TC-057: Fixed-point controller, SIMD levels and trace replay make the same decisions
+        WindshieldWiperController fullPrecisionController;
+        WindshieldWiperController quantizedController;
+        RainSensor driveSensor(57, 0);
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        const std::string traceFilePath = "AutomatedTests_quantized.bin";
+        SensorTraceRecorder traceRecorder;
+        traceRecorder.open(traceFilePath, virtualClock.now());
+        std::vector<std::uint16_t> lightCentiPercents;
+        bool isDecisionMatching = true;
+        for (int secondIndex = 0; secondIndex < 3000; secondIndex++) {
+            virtualClock.advance(std::chrono::seconds(1));
+            RainSensor::SensorReadingData sensorData = driveSensor.readSensorData();
+            RainSensor::QuantizedReadingData quantizedData = RainSensor::quantizeReading(sensorData);
+            TurnOffCountdownEvent fullPrecisionEvent = fullPrecisionController.processAutomaticModeOperation(sensorData, virtualClock.now());
+            TurnOffCountdownEvent quantizedEvent = quantizedController.processAutomaticModeOperation(quantizedData, virtualClock.now());
+            traceRecorder.recordReading(virtualClock.now(), quantizedData, quantizedController);
+            lightCentiPercents.push_back(quantizedData.lightCentiPercent);
+            isDecisionMatching = isDecisionMatching && fullPrecisionEvent == quantizedEvent &&
+                fullPrecisionController.getCurrentWiperSpeed() == quantizedController.getCurrentWiperSpeed();
+            if (!sensorData.isValidReading && secondIndex % 5 == 0) {
+                driveSensor.resetSensorFailureState();
+            }
+        }
+        traceRecorder.close();
+        
+        WiperSpeedThresholdTable thresholdTable = WiperSpeedThresholdTable::createDefaultTable();
+        std::vector<std::uint8_t> batchLevels(lightCentiPercents.size());
+        thresholdTable.mapQuantizedLightToLevels(lightCentiPercents.data(), batchLevels.data(), lightCentiPercents.size());
+        for (std::size_t sampleIndex = 0; sampleIndex < lightCentiPercents.size(); sampleIndex++) {
+            isDecisionMatching = isDecisionMatching &&
+                batchLevels[sampleIndex] == thresholdTable.mapLightPercentageToLevel(RainSensor::dequantizePercentage(lightCentiPercents[sampleIndex]));
+        }
+        
+        SensorTraceReplayer traceReplayer;
+        WindshieldWiperController replayController;
+        bool isReplayed = traceReplayer.open(traceFilePath) && traceReplayer.getRecordCount() == 3000;
+        SensorTraceReplayer::ReplayStatistics replayStatistics = traceReplayer.replayThroughController(replayController, nullptr);
+        traceReplayer.close();
+        std::remove(traceFilePath.c_str());
+        logTest("TC-057: Fixed-point controller, 16-bit SIMD levels and replay match full precision",
+                isDecisionMatching && isReplayed && replayStatistics.mismatchCount == 0 && sizeof(SensorTraceRecord) == 24);
+    }
+    
+    void testCounterBasedSensor() {
+        printTestHeader("COUNTER-BASED SENSOR TESTS");
+        
+        // TC-034: Philox4x32-10 known-answer vectors (Random123)
+        CounterBasedRandom::RandomBlock zeroBlock = CounterBasedRandom::generateBlock(0, 0, 0);
+        CounterBasedRandom::RandomBlock onesBlock = CounterBasedRandom::generateBlock(~0ULL, ~0ULL, ~0ULL);
+        logTest("TC-034: Generator matches Philox4x32-10 reference output",
+                zeroBlock.words[0] == 0x6627e8d5u && zeroBlock.words[1] == 0xe169c58du &&
+                zeroBlock.words[2] == 0xbc57ac4cu && zeroBlock.words[3] == 0x9b00dbd8u &&
+                onesBlock.words[0] == 0x408f276du && onesBlock.words[1] == 0x41c83b0eu &&
+                onesBlock.words[2] == 0xa20bc7c6u && onesBlock.words[3] == 0x6d5451fdu);
+        
+        // TC-035: Same seed and stream reproduce, other streams diverge
+        RainSensor firstSensor(42, 7);
+        RainSensor repeatSensor(42, 7);
+        RainSensor otherStreamSensor(42, 8);
+        bool isReproduced = true;
+        bool isStreamIndependent = false;
+        std::vector<RainSensor::SensorReadingData> sequentialReadings;
+        for (int tickIndex = 0; tickIndex < 20; tickIndex++) {
+            RainSensor::SensorReadingData firstReading = firstSensor.readSensorData();
+            RainSensor::SensorReadingData repeatReading = repeatSensor.readSensorData();
+            RainSensor::SensorReadingData otherReading = otherStreamSensor.readSensorData();
+            isReproduced = isReproduced && firstReading.lightPercentage == repeatReading.lightPercentage &&
+                           firstReading.dewLevel == repeatReading.dewLevel &&
+                           firstReading.isSuddenRainBurst == repeatReading.isSuddenRainBurst;
+            isStreamIndependent = isStreamIndependent || firstReading.lightPercentage != otherReading.lightPercentage;
+            sequentialReadings.push_back(firstReading);
+        }
+        logTest("TC-035a: Seeded sensors are reproducible", isReproduced && firstSensor.isCounterBased());
+        logTest("TC-035b: Stream IDs give independent sequences", isStreamIndependent);
+        
+        // TC-036: Any tick is reachable by index without replaying history (tick 4 is a burst)
+        RainSensor seekingSensor(42, 7);
+        seekingSensor.seekToTick(4);
+        RainSensor::SensorReadingData soughtReading = seekingSensor.readSensorData();
+        logTest("TC-036: Reading after seekToTick matches the sequential run",
+                sequentialReadings[4].isValidReading && sequentialReadings[4].isSuddenRainBurst &&
+                soughtReading.lightPercentage == sequentialReadings[4].lightPercentage &&
+                soughtReading.isSuddenRainBurst == sequentialReadings[4].isSuddenRainBurst &&
+                seekingSensor.getTickIndex() == 5);
+        
+        // TC-037: Counter mode keeps the per-sensor footprint small
+        RainSensor clockSeededSensor;
+        logTest("TC-037: Sensor state fits in one cache line",
+                sizeof(RainSensor) <= 64 && !clockSeededSensor.isCounterBased());
+        
+        // TC-038: Batch readings equal the scalar path, across chunks and a failure latch
+        const std::size_t batchReadingCount = 600;
+        bool isBatchIdentical = true;
+        for (std::uint64_t streamId = 0; streamId < 8; streamId++) {
+            RainSensor scalarSensor(42, streamId);
+            RainSensor batchSensor(42, streamId);
+            std::vector<RainSensor::SensorReadingData> batchReadings(batchReadingCount);
+            batchSensor.readSensorBatch(batchReadings.data(), 100);
+            batchSensor.readSensorBatch(batchReadings.data() + 100, batchReadingCount - 100);
+            for (std::size_t readingIndex = 0; readingIndex < batchReadingCount; readingIndex++) {
+                RainSensor::SensorReadingData scalarReading = scalarSensor.readSensorData();
+                const RainSensor::SensorReadingData& batchReading = batchReadings[readingIndex];
+                isBatchIdentical = isBatchIdentical &&
+                                   scalarReading.lightPercentage == batchReading.lightPercentage &&
+                                   scalarReading.isValidReading == batchReading.isValidReading &&
+                                   scalarReading.isSuddenRainBurst == batchReading.isSuddenRainBurst &&
+                                   scalarReading.isDewPresent == batchReading.isDewPresent &&
+                                   scalarReading.dewLevel == batchReading.dewLevel;
+            }
+            isBatchIdentical = isBatchIdentical && batchSensor.getTickIndex() == batchReadingCount;
+        }
+        logTest("TC-038a: readSensorBatch matches readSensorData reading for reading", isBatchIdentical);
+        
+        RainSensor::SensorReadingData clockSeededReadings[16];
+        clockSeededSensor.readSensorBatch(clockSeededReadings, 16);
+        bool isFallbackInRange = true;
+        for (const RainSensor::SensorReadingData& clockSeededReading : clockSeededReadings) {
+            isFallbackInRange = isFallbackInRange && (!clockSeededReading.isValidReading ||
+                                (clockSeededReading.lightPercentage >= 0.0 && clockSeededReading.lightPercentage <= 100.0));
+        }
+        logTest("TC-038b: Clock-seeded sensor batch falls back to scalar readings", isFallbackInRange);
+        
+        // TC-039: Unsubscribed channels cost nothing and leave the others unchanged
+        RainSensor fullSensor(42, 3);
+        RainSensor rainOnlySensor(42, 3);
+        RainSensor rainOnlyBatchSensor(42, 3);
+        const std::uint8_t rainChannels = RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_FAILURE;
+        rainOnlySensor.subscribeChannels(rainChannels);
+        rainOnlyBatchSensor.subscribeChannels(rainChannels);
+        std::vector<RainSensor::SensorReadingData> rainOnlyBatch(300);
+        rainOnlyBatchSensor.readSensorBatch(rainOnlyBatch.data(), rainOnlyBatch.size());
+        bool isRainUnchanged = true;
+        bool isDewSkipped = true;
+        for (std::size_t readingIndex = 0; readingIndex < rainOnlyBatch.size(); readingIndex++) {
+            RainSensor::SensorReadingData fullReading = fullSensor.readSensorData();
+            RainSensor::SensorReadingData rainOnlyReading = rainOnlySensor.readSensorData();
+            isRainUnchanged = isRainUnchanged && rainOnlyReading.lightPercentage == fullReading.lightPercentage &&
+                              rainOnlyReading.isSuddenRainBurst == fullReading.isSuddenRainBurst &&
+                              rainOnlyReading.isValidReading == fullReading.isValidReading &&
+                              rainOnlyBatch[readingIndex].lightPercentage == fullReading.lightPercentage &&
+                              rainOnlyBatch[readingIndex].isSuddenRainBurst == fullReading.isSuddenRainBurst;
+            isDewSkipped = isDewSkipped && !rainOnlyReading.isDewPresent && rainOnlyReading.dewLevel == 0.0 &&
+                           !rainOnlyBatch[readingIndex].isDewPresent && rainOnlyBatch[readingIndex].dewLevel == 0.0;
+        }
+        logTest("TC-039a: Rain channels are identical without dew", isRainUnchanged);
+        logTest("TC-039b: Dew fields stay clear when not subscribed", isDewSkipped);
+        
+        RainSensor reliableSensor(42, 7);
+        reliableSensor.subscribeChannels(RainSensor::CHANNEL_LIGHT);
+        std::vector<RainSensor::SensorReadingData> reliableReadings(1000);
+        reliableSensor.readSensorBatch(reliableReadings.data(), reliableReadings.size());
+        bool isAlwaysValid = true;
+        for (const RainSensor::SensorReadingData& reliableReading : reliableReadings) {
+            isAlwaysValid = isAlwaysValid && reliableReading.isValidReading && !reliableReading.isSuddenRainBurst;
+        }
+        logTest("TC-039c: Without the failure channel the sensor never fails", isAlwaysValid);
+    }
+    
+    void testParallelFleetStepping() {
+        printTestHeader("PARALLEL FLEET STEPPING TESTS");
+        
+        // TC-040: Every task runs exactly once, job after job
+        WorkStealingThreadPool threadPool(4);
+        std::vector<std::atomic<int>> taskRunCounts(1000);
+        for (std::atomic<int>& taskRunCount : taskRunCounts) {
+            taskRunCount.store(0);
+        }
+        for (int jobIndex = 0; jobIndex < 50; jobIndex++) {
+            threadPool.parallelFor(taskRunCounts.size(), [&taskRunCounts](std::size_t taskIndex) {
+                taskRunCounts[taskIndex].fetch_add(1);
+            });
+        }
+        bool isEachTaskRunOnce = true;
+        for (const std::atomic<int>& taskRunCount : taskRunCounts) {
+            isEachTaskRunOnce = isEachTaskRunOnce && taskRunCount.load() == 50;
+        }
+        logTest("TC-040: Work-stealing pool runs every task exactly once",
+                threadPool.getThreadCount() == 4 && isEachTaskRunOnce);
+        
+        // TC-041: Fleet state is bit-identical regardless of thread count
+        const std::size_t vehicleCount = 3 * FleetSimulationEngine::PARALLEL_SHARD_SIZE + 123;
+        FleetSimulationEngine serialFleet(vehicleCount, 1000, 7);
+        FleetSimulationEngine parallelFleet(vehicleCount, 1000, 7);
+        parallelFleet.setWorkerThreadCount(3);
+        serialFleet.runTicks(25);
+        FleetSimulationEngine::FleetRunStatistics parallelStatistics = parallelFleet.runTicks(25);
+        logTest("TC-041: Serial and 3-thread fleets end in identical state",
+                parallelStatistics.coresUsed == 3 &&
+                serialFleet.computeStateChecksum() == parallelFleet.computeStateChecksum() &&
+                serialFleet.countVehiclesAtSpeed(WindshieldWiperSpeed::HIGH) == parallelFleet.countVehiclesAtSpeed(WindshieldWiperSpeed::HIGH));
+    }
+    
+    void testTurnOffTimerWheel() {
+        printTestHeader("TURN-OFF TIMER WHEEL TESTS");
+        
+        // TC-042: Timers fire on their exact tick from every level, cancelled ones never fire
+        HierarchicalTimerWheel timerWheel(6, 5);
+        const std::uint64_t expiryTicks[] = {6, 69, 5 + 64 * 64 + 3, 5 + 64 * 64 * 64 + 1, 200};
+        for (std::uint32_t timerId = 0; timerId < 5; timerId++) {
+            timerWheel.schedule(timerId, expiryTicks[timerId]);
+        }
+        timerWheel.schedule(5, 100);
+        timerWheel.cancel(4);
+        timerWheel.schedule(5, 150); // Rescheduling replaces the earlier deadline
+        
+        bool isEachFiredOnTime = true;
+        std::vector<std::uint32_t> firedTimerIds;
+        std::vector<std::uint32_t> expiredTimerIds;
+        for (std::uint64_t tick = 6; tick <= expiryTicks[3]; tick++) {
+            expiredTimerIds.clear();
+            timerWheel.advanceTo(tick, expiredTimerIds);
+            for (std::uint32_t timerId : expiredTimerIds) {
+                std::uint64_t expectedTick = (timerId == 5) ? 150 : expiryTicks[timerId];
+                isEachFiredOnTime = isEachFiredOnTime && expectedTick == tick;
+                firedTimerIds.push_back(timerId);
+            }
+        }
+        logTest("TC-042: Timer wheel fires each deadline once on its exact tick",
+                isEachFiredOnTime && firedTimerIds.size() == 5 && timerWheel.getScheduledCount() == 0);
+        
+        // TC-043: Fleet countdowns match individual controllers on virtual time
+        const std::size_t vehicleCount = 300;
+        const unsigned int tickIntervalMilliseconds = 2500; // The delay lands exactly on the fourth tick
+        FleetSimulationEngine fleetEngine(vehicleCount, tickIntervalMilliseconds, 11);
+        std::vector<RainSensor> vehicleSensors;
+        std::vector<WindshieldWiperController> vehicleControllers(vehicleCount);
+        for (std::size_t vehicleIndex = 0; vehicleIndex < vehicleCount; vehicleIndex++) {
+            vehicleSensors.emplace_back(11, static_cast<std::uint64_t>(vehicleIndex));
+            vehicleSensors.back().subscribeChannels(RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_FAILURE);
+        }
+        bool isFleetMatching = true;
+        std::size_t expiredCountdownCount = 0;
+        for (std::uint64_t tick = 0; tick < 400; tick++) {
+            fleetEngine.stepTick();
+            std::chrono::steady_clock::time_point virtualTime =
+                std::chrono::steady_clock::time_point() + std::chrono::milliseconds(tick * tickIntervalMilliseconds);
+            for (std::size_t vehicleIndex = 0; vehicleIndex < vehicleCount; vehicleIndex++) {
+                WindshieldWiperController& controller = vehicleControllers[vehicleIndex];
+                bool wasWaiting = controller.isWaitingToTurnOffWipers();
+                controller.processAutomaticModeOperation(vehicleSensors[vehicleIndex].readSensorData(), virtualTime);
+                if (wasWaiting && controller.getCurrentWiperSpeed() == WindshieldWiperSpeed::OFF) {
+                    expiredCountdownCount++;
+                }
+                isFleetMatching = isFleetMatching &&
+                    fleetEngine.getWiperSpeed(vehicleIndex) == controller.getCurrentWiperSpeed() &&
+                    fleetEngine.isWaitingToTurnOffWipers(vehicleIndex) == controller.isWaitingToTurnOffWipers();
+            }
+        }
+        std::size_t waitingVehicleCount = 0;
+        for (std::size_t vehicleIndex = 0; vehicleIndex < vehicleCount; vehicleIndex++) {
+            waitingVehicleCount += fleetEngine.isWaitingToTurnOffWipers(vehicleIndex) ? 1 : 0;
+        }
+        logTest("TC-043: Timer-wheel fleet matches per-vehicle controllers",
+                isFleetMatching && expiredCountdownCount > 0 && fleetEngine.getPendingTurnOffCount() == waitingVehicleCount);
+    }
+    
+    void testLatencyTracer() {
+        printTestHeader("LATENCY TRACING TESTS");
+        
+        // TC-044: Spans from several threads land in per-thread buffers and export as Chrome trace events
+        LatencyTracer::clear();
+        {
+            ScopedTraceSpan outerSpan("testOuterSpan");
+            std::thread tracedThread([]() {
+                ScopedTraceSpan workerSpan("testWorkerSpan");
+            });
+            tracedThread.join();
+        }
+        std::size_t recordedSpanCount = LatencyTracer::getRecordedSpanCount();
+        const char* traceFilePath = "test_latency_trace.json";
+        bool isTraceWritten = LatencyTracer::writeChromeTrace(traceFilePath);
+        std::ifstream traceFile(traceFilePath);
+        std::stringstream traceText;
+        traceText << traceFile.rdbuf();
+        traceFile.close();
+        std::remove(traceFilePath);
+        logTest("TC-044: Spans from two threads export as complete trace events",
+                isTraceWritten && recordedSpanCount == 2 &&
+                traceText.str().find("\"name\":\"testOuterSpan\",\"cat\":\"wiper\",\"ph\":\"X\",\"pid\":1,\"tid\":") != std::string::npos &&
+                traceText.str().find("testWorkerSpan") != std::string::npos);
+        
+        // TC-045: Instrumented code records spans only when tracing is compiled in
+        LatencyTracer::clear();
+        RainSensor tracedSensor(3, 0);
+        tracedSensor.readSensorData();
+        logTest("TC-045: WIPER_TRACE_SCOPE follows the WIPER_ENABLE_TRACING switch",
+                LatencyTracer::getRecordedSpanCount() == (LatencyTracer::isCompiledIn() ? 1u : 0u));
+        LatencyTracer::clear();
+    }
+    
+    void testMetricsRegistry() {
+        printTestHeader("METRICS REGISTRY TESTS");
+        
+        // TC-046: Histogram buckets tile the value range and percentiles stay within bucket precision
+        bool areBucketsContiguous = true;
+        for (std::size_t bucketIndex = 0; bucketIndex < LatencyHistogram::BUCKET_COUNT; bucketIndex++) {
+            std::uint64_t lowerBound = LatencyHistogram::getBucketLowerBound(bucketIndex);
+            std::uint64_t upperBound = LatencyHistogram::getBucketUpperBound(bucketIndex);
+            areBucketsContiguous = areBucketsContiguous &&
+                LatencyHistogram::getBucketIndex(lowerBound) == bucketIndex &&
+                LatencyHistogram::getBucketIndex(upperBound) == bucketIndex &&
+                (bucketIndex + 1 == LatencyHistogram::BUCKET_COUNT ||
+                 LatencyHistogram::getBucketLowerBound(bucketIndex + 1) == upperBound + 1);
+        }
+        LatencyHistogram latencyHistogram;
+        for (std::uint64_t latencyValue = 1; latencyValue <= 100000; latencyValue++) {
+            latencyHistogram.recordValue(latencyValue);
+        }
+        HistogramSnapshot histogramSnapshot = latencyHistogram.takeSnapshot();
+        double medianError = std::fabs(static_cast<double>(histogramSnapshot.getValueAtPercentile(50.0)) - 50000.0) / 50000.0;
+        double tailError = std::fabs(static_cast<double>(histogramSnapshot.getValueAtPercentile(99.0)) - 99000.0) / 99000.0;
+        logTest("TC-046: HDR histogram percentiles within 1/32 of the exact value",
+                areBucketsContiguous && LatencyHistogram::getBucketUpperBound(LatencyHistogram::BUCKET_COUNT - 1) == UINT64_MAX &&
+                histogramSnapshot.sampleCount == 100000 && histogramSnapshot.maxValue == 100000 &&
+                histogramSnapshot.getValueAtPercentile(100.0) == 100000 &&
+                medianError <= 1.0 / 32.0 && tailError <= 1.0 / 32.0);
+        
+        // TC-047: Controller events become counters and per-speed dwell times on virtual time
+        MetricsRegistry systemMetrics;
+        WindshieldWiperController controller;
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        systemMetrics.recordWiperSpeed(controller.getCurrentWiperSpeed(), virtualClock.now());
+        
+        RainSensor::SensorReadingData sensorData;
+        sensorData.isValidReading = true;
+        sensorData.isDewPresent = false;
+        sensorData.dewLevel = 0.0;
+        const double samplePercentages[] = {60.0, 95.0, 95.0, 95.0, 95.0, 95.0, 95.0, 95.0, 95.0, 95.0, 95.0, 95.0, 95.0, 60.0, 95.0, 30.0};
+        for (std::size_t sampleIndex = 0; sampleIndex < sizeof(samplePercentages) / sizeof(samplePercentages[0]); sampleIndex++) {
+            // One sample per virtual second; the last one is a burst that cancels the second countdown
+            sensorData.lightPercentage = samplePercentages[sampleIndex];
+            sensorData.isSuddenRainBurst = (sampleIndex == 15);
+            systemMetrics.controlTicks.increment();
+            if (sensorData.isSuddenRainBurst) {
+                systemMetrics.rainBursts.increment();
+            }
+            systemMetrics.recordTurnOffCountdownEvent(controller.processAutomaticModeOperation(sensorData, virtualClock.now()));
+            systemMetrics.recordWiperSpeed(controller.getCurrentWiperSpeed(), virtualClock.now());
+            virtualClock.advance(std::chrono::seconds(1));
+        }
+        virtualClock.advance(std::chrono::seconds(4));
+        MetricsSnapshot metricsSnapshot = systemMetrics.takeSnapshot(virtualClock.now());
+        logTest("TC-047: Registry counts transitions, countdowns and dwell time per speed",
+                metricsSnapshot.controlTickCount == 16 && metricsSnapshot.rainBurstCount == 1 &&
+                metricsSnapshot.wiperSpeedTransitionCount == 4 &&
+                metricsSnapshot.turnOffCountdownStartCount == 2 &&
+                metricsSnapshot.turnOffCountdownCancelCount == 1 &&
+                metricsSnapshot.turnOffCountdownExpiryCount == 1 &&
+                metricsSnapshot.speedDwellNanoseconds[0] == 2000000000ULL &&
+                metricsSnapshot.speedDwellNanoseconds[1] == 13000000000ULL &&
+                metricsSnapshot.speedDwellNanoseconds[2] == 0 &&
+                metricsSnapshot.speedDwellNanoseconds[3] == 5000000000ULL);
+        
+        // TC-071: Snapshots taken during speed changes see the speed and its start time as a pair
+        const std::uint64_t transitionLimit = 1000000000;
+        const std::uint64_t transitionStepNanoseconds = 1000000;
+        MetricsRegistry racedMetrics;
+        MetricsRegistry::TimePoint baseTime = std::chrono::steady_clock::now();
+        MetricsRegistry::TimePoint snapshotTime = baseTime + std::chrono::nanoseconds((transitionLimit + 1) * transitionStepNanoseconds);
+        racedMetrics.recordWiperSpeed(WindshieldWiperSpeed::OFF, baseTime);
+        std::atomic<bool> isReaderRunning(false);
+        std::atomic<bool> isReaderDone(false);
+        std::thread speedWriter([&]() {
+            while (!isReaderRunning.load()) {
+                std::this_thread::yield();
+            }
+            for (std::uint64_t transitionIndex = 1; transitionIndex <= transitionLimit && !isReaderDone.load(); transitionIndex++) {
+                racedMetrics.recordWiperSpeed(static_cast<WindshieldWiperSpeed>(transitionIndex % 4),
+                    baseTime + std::chrono::nanoseconds(transitionIndex * transitionStepNanoseconds));
+            }
+        });
+        // Scrape for long enough that the scheduler also preempts the writer mid-update on a single core
+        std::chrono::steady_clock::time_point readerDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        std::uint64_t snapshotCount = 0;
+        std::uint64_t inconsistentSnapshotCount = 0;
+        while (std::chrono::steady_clock::now() < readerDeadline) {
+            MetricsSnapshot racedSnapshot = racedMetrics.takeSnapshot(snapshotTime);
+            isReaderRunning.store(true);
+            // After n transitions each speed s holds 1ms per earlier interval j < n with j % 4 == s,
+            // and the open interval of speed n % 4 runs from n ms to the snapshot time
+            std::uint64_t transitionCount = racedSnapshot.wiperSpeedTransitionCount;
+            for (std::uint64_t speedIndex = 0; speedIndex < MetricsSnapshot::WIPER_SPEED_COUNT; speedIndex++) {
+                std::uint64_t closedIntervals = transitionCount / 4 + (speedIndex < transitionCount % 4 ? 1 : 0);
+                std::uint64_t expectedDwell = closedIntervals * transitionStepNanoseconds;
+                if (speedIndex == transitionCount % 4) {
+                    expectedDwell += (transitionLimit + 1 - transitionCount) * transitionStepNanoseconds;
+                }
+                if (racedSnapshot.speedDwellNanoseconds[speedIndex] != expectedDwell) {
+                    inconsistentSnapshotCount++;
+                    break;
+                }
+            }
+            snapshotCount++;
+        }
+        isReaderDone.store(true);
+        speedWriter.join();
+        std::cout << "  Snapshots during speed changes: " << snapshotCount
+                  << ", inconsistent: " << inconsistentSnapshotCount << std::endl;
+        logTest("TC-071: Concurrent snapshots never mix old and new speed dwell state",
+                snapshotCount > 0 && inconsistentSnapshotCount == 0);
+    }
+    
+    void testMetricsHttpEndpoint() {
+        printTestHeader("PROMETHEUS METRICS ENDPOINT TESTS");
+        
+        MetricsRegistry systemMetrics;
+        systemMetrics.controlTicks.increment(3);
+        systemMetrics.turnOffCountdownStarts.increment();
+        systemMetrics.controlTickLatency.recordValue(3000);     // 3 us
+        systemMetrics.controlTickLatency.recordValue(40000);    // 40 us
+        systemMetrics.controlTickLatency.recordValue(2000000);  // 2 ms
+        
+        // TC-048: Text format has cumulative histogram buckets ending in +Inf == count
+        std::string metricsText = MetricsHttpEndpoint::formatPrometheusText(systemMetrics.takeSnapshot(std::chrono::steady_clock::now()));
+        logTest("TC-048: Prometheus text format has counters and cumulative latency buckets",
+                metricsText.find("# TYPE wiper_control_ticks_total counter\nwiper_control_ticks_total 3\n") != std::string::npos &&
+                metricsText.find("wiper_turn_off_countdowns_total{event=\"started\"} 1\n") != std::string::npos &&
+                metricsText.find("wiper_control_tick_duration_seconds_bucket{le=\"2.5e-06\"} 0\n") != std::string::npos &&
+                metricsText.find("wiper_control_tick_duration_seconds_bucket{le=\"5e-06\"} 1\n") != std::string::npos &&
+                metricsText.find("wiper_control_tick_duration_seconds_bucket{le=\"5e-05\"} 2\n") != std::string::npos &&
+                metricsText.find("wiper_control_tick_duration_seconds_bucket{le=\"0.0025\"} 3\n") != std::string::npos &&
+                metricsText.find("wiper_control_tick_duration_seconds_bucket{le=\"+Inf\"} 3\n") != std::string::npos &&
+                metricsText.find("wiper_control_tick_duration_seconds_count 3\n") != std::string::npos);
+        
+        // TC-049: Scrapes are served over loopback from the endpoint's own thread
+        MetricsHttpEndpoint metricsEndpoint;
+        bool isEndpointOpen = metricsEndpoint.open(0, [&systemMetrics]() {
+            return systemMetrics.takeSnapshot(std::chrono::steady_clock::now());
+        });
+#if !defined(_WIN32)
+        systemMetrics.controlTicks.increment();
+        std::string metricsResponse = fetchLocalHttp(metricsEndpoint.getListenPort(), "/metrics");
+        std::string missingResponse = fetchLocalHttp(metricsEndpoint.getListenPort(), "/");
+        metricsEndpoint.close();
+        logTest("TC-049: GET /metrics returns a live snapshot, other paths 404",
+                isEndpointOpen &&
+                metricsResponse.compare(0, 15, "HTTP/1.1 200 OK") == 0 &&
+                metricsResponse.find("Content-Type: text/plain; version=0.0.4") != std::string::npos &&
+                metricsResponse.find("\nwiper_control_ticks_total 4\n") != std::string::npos &&
+                missingResponse.compare(0, 22, "HTTP/1.1 404 Not Found") == 0 &&
+                metricsEndpoint.getServedRequestCount() == 2 && !metricsEndpoint.isOpen());
+#else
+        logTest("TC-049: Metrics endpoint reports unavailable without POSIX sockets", !isEndpointOpen);
+#endif
+    }
+    
+    void testAllocationFreeTickPath() {
+        printTestHeader("ALLOCATION-FREE TICK PATH TESTS");
+        
+        // The real WiperSystemManager::runControlTick, headless, with event log and sensor trace enabled
+        const std::string logFilePath = "AutomatedTests_tick_events.bin";
+        const std::string traceFilePath = "AutomatedTests_tick_trace.bin";
+        const std::string consoleFilePath = "AutomatedTests_tick_console.txt";
+        const std::size_t automaticTickCount = SensorTraceRecorder::RECORD_BUFFER_CAPACITY + 100;
+        WiperSystemManager::SystemTimingConfiguration timingConfiguration = {10, 10, -1, false};
+        int consoleDescriptor = openConsoleCaptureFile(consoleFilePath);
+        SimulationClock::TimePoint tickTime = std::chrono::steady_clock::now();
+        std::uint64_t automaticAllocationCount = 0;
+        std::uint64_t manualAllocationCount = 0;
+        bool isRecordingSystemValid = false;
+        {
+            WiperSystemManager wiperSystem;
+            wiperSystem.enableHeadlessConsole(consoleDescriptor);
+            wiperSystem.configureTiming(timingConfiguration);
+            wiperSystem.setSensorSeed(11);
+            bool isOpened = wiperSystem.enableEventLog(logFilePath) && wiperSystem.enableSensorTrace(traceFilePath);
+            
+            // TC-058: After warm-up (time zone load, first-use buffers), automatic ticks never touch the heap
+            for (int tickIndex = 0; tickIndex < 16; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                wiperSystem.runControlTick(tickTime);
+            }
+            std::uint64_t firstAllocationCount = AllocationCounter::getAllocationCount();
+            for (std::size_t tickIndex = 0; tickIndex < automaticTickCount; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                wiperSystem.runControlTick(tickTime);
+            }
+            automaticAllocationCount = AllocationCounter::getAllocationCount() - firstAllocationCount;
+            MetricsSnapshot metricsSnapshot = wiperSystem.takeMetricsSnapshot();
+            isRecordingSystemValid = isOpened && wiperSystem.isRunning() &&
+                wiperSystem.getWiperController().getCurrentOperatingMode() == OperatingMode::AUTOMATIC &&
+                metricsSnapshot.controlTickCount == automaticTickCount + 16 &&
+                metricsSnapshot.wiperSpeedTransitionCount > 0 && metricsSnapshot.turnOffCountdownStartCount > 0;
+            
+            // Manual ticks with spray active, after the commands that get there
+            wiperSystem.handleUserCommand('m');
+            wiperSystem.handleUserCommand('3');
+            wiperSystem.handleUserCommand('s');
+            tickTime += std::chrono::milliseconds(100);
+            wiperSystem.runControlTick(tickTime);
+            firstAllocationCount = AllocationCounter::getAllocationCount();
+            for (int tickIndex = 0; tickIndex < 1000; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                wiperSystem.runControlTick(tickTime);
+            }
+            manualAllocationCount = AllocationCounter::getAllocationCount() - firstAllocationCount;
+        }
+        logTest("TC-058: runControlTick in auto mode, across a trace buffer flush, makes zero heap allocations",
+                isRecordingSystemValid && automaticAllocationCount == 0,
+                "allocations: " + std::to_string(automaticAllocationCount));
+        
+        // TC-059: Manual ticks and replayed ticks are allocation-free too
+        std::uint64_t replayAllocationCount = 0;
+        bool isReplayRunning = false;
+        {
+            WiperSystemManager replaySystem;
+            replaySystem.enableHeadlessConsole(consoleDescriptor);
+            replaySystem.configureTiming(timingConfiguration);
+            bool isReplayOpened = replaySystem.enableSensorReplay(traceFilePath);
+            for (int tickIndex = 0; tickIndex < 16; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                replaySystem.runControlTick(tickTime);
+            }
+            std::uint64_t firstAllocationCount = AllocationCounter::getAllocationCount();
+            for (std::size_t tickIndex = 0; tickIndex < SensorTraceRecorder::RECORD_BUFFER_CAPACITY; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                replaySystem.runControlTick(tickTime);
+            }
+            replayAllocationCount = AllocationCounter::getAllocationCount() - firstAllocationCount;
+            isReplayRunning = isReplayOpened && replaySystem.isRunning();
+        }
+        std::string consoleText = readConsoleCaptureFile(consoleDescriptor, consoleFilePath);
+        std::remove(logFilePath.c_str());
+        std::remove(traceFilePath.c_str());
+        logTest("TC-059: Manual and replayed runControlTick make zero heap allocations",
+                manualAllocationCount == 0 && replayAllocationCount == 0 && isReplayRunning &&
+                consoleText.find("] " COLOR_RESET "Mode: MANUAL | Wiper: HIGH | Spray: LIGHT SPRAY\n") != std::string::npos &&
+                consoleText.find(COLOR_GREEN "Mode: AUTO" COLOR_RESET " | Sensor: ") != std::string::npos,
+                "allocations: " + std::to_string(manualAllocationCount) + " manual, " +
+                std::to_string(replayAllocationCount) + " replayed");
+    }
+    
+    void testStatusDecimation() {
+        printTestHeader("STATUS LINE DECIMATION TESTS");
+        
+        // TC-064: Status lines are decimated to a rounded whole number of control ticks (100 Hz / 3 Hz -> every 33 ticks)
+        const std::string consoleFilePath = "AutomatedTests_decimation_console.txt";
+        struct DecimationCase {
+            unsigned int controlRateHz;
+            unsigned int statusRateHz;
+            unsigned int expectedTicksPerLine;
+        };
+        const DecimationCase decimationCases[] = {{100, 3, 33}, {100, 7, 14}, {100, 40, 3}, {10, 20, 1}};
+        bool isDecimationRounded = true;
+        std::string decimationDetails;
+        for (const DecimationCase& decimationCase : decimationCases) {
+            WiperSystemManager::SystemTimingConfiguration timingConfiguration = {decimationCase.controlRateHz, decimationCase.statusRateHz, -1, false};
+            int consoleDescriptor = openConsoleCaptureFile(consoleFilePath);
+            SimulationClock::TimePoint tickTime = std::chrono::steady_clock::now();
+            std::size_t linesBeforeTenth = 0;
+            std::size_t linesAtTenth = 0;
+            {
+                WiperSystemManager wiperSystem;
+                wiperSystem.enableHeadlessConsole(consoleDescriptor);
+                wiperSystem.configureTiming(timingConfiguration);
+                wiperSystem.setSensorSeed(64);
+                for (unsigned int tickIndex = 1; tickIndex <= 10 * decimationCase.expectedTicksPerLine; tickIndex++) {
+                    if (tickIndex == 10 * decimationCase.expectedTicksPerLine) {
+                        linesBeforeTenth = countCapturedLines(consoleFilePath, "Mode: AUTO");
+                    }
+                    tickTime += std::chrono::milliseconds(10);
+                    wiperSystem.runControlTick(tickTime);
+                }
+                linesAtTenth = countCapturedLines(consoleFilePath, "Mode: AUTO");
+            }
+            readConsoleCaptureFile(consoleDescriptor, consoleFilePath);
+            
+            // Ten lines exactly at the tenth interval, one tick earlier only nine
+            isDecimationRounded = isDecimationRounded && linesBeforeTenth == 9 && linesAtTenth == 10;
+            decimationDetails += std::to_string(decimationCase.controlRateHz) + "/" + std::to_string(decimationCase.statusRateHz) + ": " +
+                                 std::to_string(linesBeforeTenth) + "," + std::to_string(linesAtTenth) + " ";
+        }
+        logTest("TC-064: Status decimation rounds to whole ticks at non-divisible rates",
+                isDecimationRounded, decimationDetails);
+        
+        // TC-065: A burst between two status lines is still reported on the next line, and only on that one
+        const std::string driveTracePath = "AutomatedTests_burst_trace.bin";
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        WindshieldWiperController recordingController;
+        SensorTraceRecorder traceRecorder;
+        traceRecorder.open(driveTracePath, virtualClock.now());
+        for (int readingIndex = 0; readingIndex < 20; readingIndex++) {
+            RainSensor::SensorReadingData sensorData = {95.0, true, readingIndex == 4, false, 0.0};
+            traceRecorder.recordReading(virtualClock.now(), sensorData, recordingController);
+        }
+        traceRecorder.close();
+        
+        WiperSystemManager::SystemTimingConfiguration burstTimingConfiguration = {10, 1, -1, false};
+        int consoleDescriptor = openConsoleCaptureFile(consoleFilePath);
+        SimulationClock::TimePoint tickTime = std::chrono::steady_clock::now();
+        {
+            WiperSystemManager wiperSystem;
+            wiperSystem.enableHeadlessConsole(consoleDescriptor);
+            wiperSystem.configureTiming(burstTimingConfiguration);
+            wiperSystem.enableSensorReplay(driveTracePath);
+            for (int tickIndex = 0; tickIndex < 20; tickIndex++) {
+                tickTime += std::chrono::milliseconds(100);
+                wiperSystem.runControlTick(tickTime);
+            }
+        }
+        std::string consoleText = readConsoleCaptureFile(consoleDescriptor, consoleFilePath);
+        std::remove(driveTracePath.c_str());
+        std::size_t firstLineEnd = consoleText.find('\n');
+        std::size_t secondLineEnd = (firstLineEnd != std::string::npos) ? consoleText.find('\n', firstLineEnd + 1) : std::string::npos;
+        std::string firstStatusLine = consoleText.substr(0, firstLineEnd);
+        std::string secondStatusLine = (secondLineEnd != std::string::npos) ? consoleText.substr(firstLineEnd + 1, secondLineEnd - firstLineEnd - 1) : "";
+        logTest("TC-065: Burst in the middle of a status window is reported once",
+                firstStatusLine.find("Mode: AUTO") != std::string::npos &&
+                firstStatusLine.find("(Sudden Rain Burst)") != std::string::npos &&
+                secondStatusLine.find("Mode: AUTO") != std::string::npos &&
+                secondStatusLine.find("(Sudden Rain Burst)") == std::string::npos &&
+                consoleText.find('\n', secondLineEnd + 1) == std::string::npos);
+    }
+    
+    void testConsoleEventLoop() {
+        printTestHeader("CONSOLE EVENT LOOP TESTS");
+        
+#if defined(__linux__)
+        // Each loop reads a pipe in place of the terminal; a timer two seconds out is a watchdog against hangs
+        const std::chrono::seconds watchdogDelay(2);
+        
+        // TC-066: Keystrokes buffered before the wakeup are all delivered by that one wakeup
+        int keystrokePipe[2];
+        bool isPipeCreated = pipe(keystrokePipe) == 0;
+        std::string deliveredKeys;
+        std::uint64_t keystrokeTimerCount = 0;
+        std::uint64_t keystrokeWakeupCount = 0;
+        bool isKeystrokeLoopSupported = false;
+        if (isPipeCreated) {
+            isPipeCreated = write(keystrokePipe[1], "m3sa", 4) == 4;
+            ConsoleEventLoop eventLoop(keystrokePipe[0]);
+            isKeystrokeLoopSupported = eventLoop.isSupported();
+            eventLoop.setPeriodicTimer(std::chrono::steady_clock::now() + watchdogDelay, watchdogDelay);
+            eventLoop.run(
+                [&eventLoop, &deliveredKeys](char typedCharacter) {
+                    deliveredKeys += typedCharacter;
+                    if (deliveredKeys.size() == 4) {
+                        eventLoop.stop();
+                    }
+                },
+                [&eventLoop, &keystrokeTimerCount](std::uint64_t) {
+                    keystrokeTimerCount++;
+                    eventLoop.stop();
+                });
+            keystrokeWakeupCount = eventLoop.getWakeupCount();
+            close(keystrokePipe[0]);
+            close(keystrokePipe[1]);
+        }
+        logTest("TC-066: Buffered keystrokes are drained in order by a single wakeup",
+                isPipeCreated && isKeystrokeLoopSupported && deliveredKeys == "m3sa" &&
+                keystrokeWakeupCount == 1 && keystrokeTimerCount == 0,
+                "keys: " + deliveredKeys + ", wakeups: " + std::to_string(keystrokeWakeupCount));
+        
+        // TC-067: The timer wakes the loop on its deadline with no input present
+        int idlePipe[2];
+        bool isIdlePipeCreated = pipe(idlePipe) == 0;
+        std::uint64_t timerCallCount = 0;
+        std::uint64_t expirationCount = 0;
+        std::uint64_t idleWakeupCount = 0;
+        std::size_t idleKeyCount = 0;
+        std::chrono::steady_clock::duration waitDuration = std::chrono::steady_clock::duration::zero();
+        const std::chrono::milliseconds timerDelay(20);
+        if (isIdlePipeCreated) {
+            ConsoleEventLoop eventLoop(idlePipe[0]);
+            std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+            eventLoop.setPeriodicTimer(startTime + timerDelay, watchdogDelay);
+            eventLoop.run(
+                [&eventLoop, &idleKeyCount](char) {
+                    idleKeyCount++;
+                    eventLoop.stop();
+                },
+                [&eventLoop, &timerCallCount, &expirationCount](std::uint64_t timerExpirations) {
+                    timerCallCount++;
+                    expirationCount += timerExpirations;
+                    eventLoop.stop();
+                });
+            waitDuration = std::chrono::steady_clock::now() - startTime;
+            idleWakeupCount = eventLoop.getWakeupCount();
+            
+            // TC-068: Closing the write end ends the loop without stop()
+            close(idlePipe[1]);
+            eventLoop.run([](char) {}, [&eventLoop](std::uint64_t) { eventLoop.stop(); });
+            idleWakeupCount = eventLoop.getWakeupCount() - idleWakeupCount;
+            close(idlePipe[0]);
+        }
+        logTest("TC-067: Timer alone wakes the loop after its deadline",
+                isIdlePipeCreated && timerCallCount == 1 && expirationCount == 1 && idleKeyCount == 0 &&
+                waitDuration >= timerDelay && waitDuration < watchdogDelay);
+        logTest("TC-068: End of input stops the loop on the next wakeup",
+                isIdlePipeCreated && idleWakeupCount == 1);
+        
+        // TC-069: Non-blocking availability check and single-key reads on the same pipe-backed stdin
+        int inputPipe[2];
+        int savedStandardInput = dup(STDIN_FILENO);
+        bool isInputRedirected = savedStandardInput >= 0 && pipe(inputPipe) == 0 && dup2(inputPipe[0], STDIN_FILENO) >= 0;
+        bool isInputHandled = false;
+        if (isInputRedirected) {
+            bool wasAvailableWhenEmpty = isConsoleInputAvailable();
+            bool isWritten = write(inputPipe[1], "q", 1) == 1;
+            bool isAvailableAfterWrite = isConsoleInputAvailable();
+            char readCharacter = readConsoleCharacter();
+            isInputHandled = !wasAvailableWhenEmpty && isWritten && isAvailableAfterWrite && readCharacter == 'q' &&
+                             !isConsoleInputAvailable();
+            dup2(savedStandardInput, STDIN_FILENO);
+            close(inputPipe[0]);
+            close(inputPipe[1]);
+        }
+        if (savedStandardInput >= 0) {
+            close(savedStandardInput);
+        }
+        logTest("TC-069: Console input polls and reads one keystroke without blocking", isInputHandled);
+#else
+        // Other platforms keep the polling loop, so the reactor must report itself unsupported
+        ConsoleEventLoop eventLoop;
+        logTest("TC-066: Event loop reports no reactor support on this platform", !eventLoop.isSupported());
+#endif
+    }
+    
+    void testStatusLineRenderer() {
+        printTestHeader("SINGLE-WRITE STATUS LINE TESTS");
+        
+        // TC-060: Rendered lines carry the expected text after the time prefix, and the StatusDisplay printers wrap the renderer
+        const std::size_t timePrefixLength = sizeof(COLOR_CYAN "[") - 1 + TIME_STRING_BUFFER_SIZE - 1 + sizeof("] " COLOR_RESET) - 1;
+        SimulationClock virtualClock(SimulationClock::ClockMode::VIRTUAL_TIME);
+        WindshieldWiperController controller;
+        controller.setOperatingMode(OperatingMode::AUTOMATIC);
+        StatusLineRenderer statusLineRenderer;
+        RainSensor::SensorReadingData rainyReading = {60.0, true, false, false, 0.0};
+        RainSensor::SensorReadingData dryReading = {95.0, true, false, false, 0.0};
+        RainSensor::SensorReadingData failedReading = {-1.0, false, false, false, 0.0};
+        controller.processAutomaticModeOperation(rainyReading, virtualClock.now());
+        virtualClock.advance(std::chrono::seconds(1));
+        controller.processAutomaticModeOperation(dryReading, virtualClock.now());
+        virtualClock.advance(std::chrono::seconds(2));
+        
+        static const char* const EXPECTED_LINES[] = {
+            COLOR_GREEN "Mode: AUTO" COLOR_RESET " | Sensor: " COLOR_WHITE "95%" COLOR_RESET " | Wiper: " COLOR_GREEN "LOW" COLOR_RESET
+            COLOR_YELLOW " (Turning OFF in 8s)" COLOR_RESET "\n",
+            COLOR_GREEN "Mode: AUTO" COLOR_RESET " | Sensor: " COLOR_WHITE "95%" COLOR_RESET " | Wiper: " COLOR_GREEN "LOW" COLOR_RESET
+            COLOR_RED " (Sudden Rain Burst)" COLOR_RESET COLOR_YELLOW " (Turning OFF in 8s)" COLOR_RESET "\n",
+            COLOR_GREEN "Mode: AUTO" COLOR_RESET " | Sensor: " COLOR_RED "ERROR" COLOR_RESET " | Wiper: " COLOR_GREEN "LOW" COLOR_RESET
+            COLOR_RED " (Sensor Failure - Switch to Manual)" COLOR_RESET "\n",
+            "Mode: MANUAL | Wiper: MEDIUM | Spray: HEAVY SPRAY\n"
+        };
+        bool areLinesMatching = controller.isWaitingToTurnOffWipers();
+        for (int lineIndex = 0; lineIndex < 4; lineIndex++) {
+            std::ostringstream printedLine;
+            if (lineIndex == 0 || lineIndex == 1) {
+                printAutomaticModeStatusLine(printedLine, dryReading, lineIndex == 1, controller, virtualClock.now());
+                statusLineRenderer.renderAutomaticModeStatusLine(dryReading, lineIndex == 1, controller, virtualClock.now());
+            } else if (lineIndex == 2) {
+                printAutomaticModeStatusLine(printedLine, failedReading, true, controller, virtualClock.now());
+                statusLineRenderer.renderAutomaticModeStatusLine(failedReading, true, controller, virtualClock.now());
+            } else {
+                WindshieldWiperController manualController;
+                manualController.setOperatingMode(OperatingMode::MANUAL);
+                manualController.setWiperSpeed(WindshieldWiperSpeed::MEDIUM);
+                manualController.setWaterSprayMode(WaterSprayMode::HEAVY_SPRAY);
+                printManualModeStatusLine(printedLine, manualController);
+                statusLineRenderer.renderManualModeStatusLine(manualController);
+            }
+            std::string renderedLine(statusLineRenderer.getLineData(), statusLineRenderer.getLineLength());
+            areLinesMatching = areLinesMatching &&
+                renderedLine.find(COLOR_CYAN "[") == 0 &&
+                renderedLine.compare(timePrefixLength, std::string::npos, EXPECTED_LINES[lineIndex]) == 0 &&
+                printedLine.str().size() == renderedLine.size() &&
+                printedLine.str().compare(timePrefixLength, std::string::npos, EXPECTED_LINES[lineIndex]) == 0;
+        }
+        
+        WindshieldWiperController manualController;
+        manualController.setOperatingMode(OperatingMode::MANUAL);
+        manualController.setWaterSprayMode(WaterSprayMode::LIGHT_SPRAY);
+        RainSensor::SensorReadingData dewReading = {42.0, true, true, true, 17.9};
+        statusLineRenderer.renderSystemStatusLine(dewReading, manualController, "Check sensor");
+        std::string systemLine(statusLineRenderer.getLineData(), statusLineRenderer.getLineLength());
+        logTest("TC-060: Rendered status lines carry the expected text and the printers wrap the renderer",
+                areLinesMatching &&
+                systemLine.compare(timePrefixLength, std::string::npos,
+                                   "Mode: " COLOR_BLUE "MANUAL" COLOR_RESET " | Sensor: " COLOR_WHITE "42%" COLOR_RESET
+                                   " | Wiper: " COLOR_GRAY "OFF" COLOR_RESET " | Spray: " COLOR_CYAN "LIGHT SPRAY" COLOR_RESET
+                                   COLOR_RED " (Sudden Rain Burst)" COLOR_RESET COLOR_MAGENTA " (Dew Detected: 17%)" COLOR_RESET
+                                   COLOR_RED " (Check sensor)" COLOR_RESET "\n") == 0);
+        
+        // TC-061: One write per frame, no allocations, and the time prefix is rebuilt at most once per second
+        bool isWrittenWhole = true;
+        std::uint64_t allocationCount = 0;
+        std::uint64_t rebuildCount = 0;
+        std::chrono::steady_clock::time_point firstRenderTime = std::chrono::steady_clock::now();
+#if !defined(_WIN32)
+        int pipeDescriptors[2];
+        isWrittenWhole = pipe(pipeDescriptors) == 0;
+        std::uint64_t firstRebuildCount = statusLineRenderer.getTimePrefixRebuildCount();
+        std::uint64_t firstAllocationCount = AllocationCounter::getAllocationCount();
+        for (int lineIndex = 0; lineIndex < 2000 && isWrittenWhole; lineIndex++) {
+            statusLineRenderer.renderAutomaticModeStatusLine(dryReading, (lineIndex & 1) != 0, controller, virtualClock.now());
+            isWrittenWhole = statusLineRenderer.writeToFileDescriptor(pipeDescriptors[1]);
+            
+            // Each read returns exactly one line, so each line went out as one write
+            char readBuffer[StatusLineRenderer::LINE_BUFFER_CAPACITY];
+            ssize_t readLength = read(pipeDescriptors[0], readBuffer, sizeof(readBuffer));
+            isWrittenWhole = isWrittenWhole && readLength == static_cast<ssize_t>(statusLineRenderer.getLineLength()) &&
+                             std::memcmp(readBuffer, statusLineRenderer.getLineData(), statusLineRenderer.getLineLength()) == 0;
+        }
+        allocationCount = AllocationCounter::getAllocationCount() - firstAllocationCount;
+        rebuildCount = statusLineRenderer.getTimePrefixRebuildCount() - firstRebuildCount;
+        close(pipeDescriptors[0]);
+        close(pipeDescriptors[1]);
+#endif
+        std::uint64_t elapsedSeconds = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - firstRenderTime).count());
+        logTest("TC-061: Each line leaves in one write(2) without allocating; time prefix cached per second",
+                isWrittenWhole && allocationCount == 0 && rebuildCount <= elapsedSeconds + 1,
+                "allocations: " + std::to_string(allocationCount) + ", prefix rebuilds: " + std::to_string(rebuildCount));
+    }
+    
     void testManualModeBasics() {
         printTestHeader("MANUAL MODE BASIC TESTS");
         
@@ -340,7 +2003,28 @@ private:
         std::cout << "\nTest Coverage Areas:" << std::endl;
         std::cout << "  - System Initialization" << std::endl;
         std::cout << "  - Auto Mode Basic Functionality" << std::endl;
+        std::cout << "  - Batch Speed Mapping" << std::endl;
         std::cout << "  - 10-Second Turn-Off Delay (Critical Feature)" << std::endl;
+        std::cout << "  - Turn-Off Countdown Events" << std::endl;
+        std::cout << "  - Table-Driven State Machine" << std::endl;
+        std::cout << "  - Packed Controller State" << std::endl;
+        std::cout << "  - Virtual Time Turn-Off Delay" << std::endl;
+        std::cout << "  - Calibration Policies" << std::endl;
+        std::cout << "  - Periodic Scheduler" << std::endl;
+        std::cout << "  - Binary Event Log" << std::endl;
+        std::cout << "  - Sensor Trace Recording" << std::endl;
+        std::cout << "  - Sensor Trace Replay" << std::endl;
+        std::cout << "  - Fixed-Point Sensor Pipeline" << std::endl;
+        std::cout << "  - Counter-Based Sensor" << std::endl;
+        std::cout << "  - Parallel Fleet Stepping" << std::endl;
+        std::cout << "  - Turn-Off Timer Wheel" << std::endl;
+        std::cout << "  - Latency Tracing" << std::endl;
+        std::cout << "  - Metrics Registry" << std::endl;
+        std::cout << "  - Prometheus Metrics Endpoint" << std::endl;
+        std::cout << "  - Allocation-Free Tick Path" << std::endl;
+        std::cout << "  - Single-Write Status Lines" << std::endl;
+        std::cout << "  - Status Line Decimation" << std::endl;
+        std::cout << "  - Console Event Loop" << std::endl;
         std::cout << "  - Manual Mode Controls" << std::endl;
         std::cout << "  - Spray Functionality" << std::endl;
         std::cout << "  - Mode Switching" << std::endl;
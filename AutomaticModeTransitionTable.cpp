@@ -0,0 +1,79 @@
+#include "AutomaticModeTransitionTable.h"
+#include "WindshieldWiperController.h"
+
+const std::size_t AutomaticModeTransitionTable::ENTRY_COUNT;
+
+AutomaticModeTransitionTable::AutomaticModeTransitionTable() {
+    for (std::size_t entryIndex = 0; entryIndex < ENTRY_COUNT; entryIndex++) {
+        WindshieldWiperSpeed wiperSpeed = static_cast<WindshieldWiperSpeed>(entryIndex & 3);
+        bool isWaitingToTurnOff = ((entryIndex >> 2) & 1) != 0;
+        bool isAutomaticMode = ((entryIndex >> 3) & 1) != 0;
+        WindshieldWiperSpeed targetSpeed = static_cast<WindshieldWiperSpeed>((entryIndex >> 6) & 3);
+        bool hasTurnOffDelayElapsed = ((entryIndex >> 8) & 1) != 0;
+
+        RainSensor::SensorReadingData sensorData = RainSensor::SensorReadingData();
+        sensorData.isValidReading = ((entryIndex >> 4) & 1) != 0;
+        sensorData.isSuddenRainBurst = ((entryIndex >> 5) & 1) != 0;
+
+        // Manual mode never runs the automatic rules, so its entries are the identity
+        TurnOffCountdownEvent countdownEvent = TurnOffCountdownEvent::NONE;
+        if (isAutomaticMode) {
+            countdownEvent = WindshieldWiperController::applyAutomaticModeRules(sensorData, targetSpeed, wiperSpeed,
+                                                                                isWaitingToTurnOff, hasTurnOffDelayElapsed);
+        }
+        transitionEntries[entryIndex] = static_cast<std::uint8_t>(static_cast<unsigned int>(wiperSpeed) |
+                                                                  (isWaitingToTurnOff ? 4u : 0u) |
+                                                                  (static_cast<unsigned int>(countdownEvent) << 3));
+    }
+}
+
+std::size_t AutomaticModeTransitionTable::encodeIndex(WindshieldWiperSpeed wiperSpeed, bool isWaitingToTurnOff, OperatingMode operatingMode,
+                                                      bool isValidReading, bool isSuddenRainBurst, WindshieldWiperSpeed targetSpeed,
+                                                      bool hasTurnOffDelayElapsed) {
+    return (static_cast<std::size_t>(wiperSpeed) & 3) |
+           (static_cast<std::size_t>(isWaitingToTurnOff) << 2) |
+           (static_cast<std::size_t>(operatingMode == OperatingMode::AUTOMATIC) << 3) |
+           (static_cast<std::size_t>(isValidReading) << 4) |
+           (static_cast<std::size_t>(isSuddenRainBurst) << 5) |
+           ((static_cast<std::size_t>(targetSpeed) & 3) << 6) |
+           (static_cast<std::size_t>(hasTurnOffDelayElapsed) << 8);
+}
+
+TurnOffCountdownEvent AutomaticModeTransitionTable::applyTransition(const RainSensor::SensorReadingData& sensorData,
+                                                                    WindshieldWiperSpeed targetSpeed,
+                                                                    OperatingMode operatingMode,
+                                                                    WindshieldWiperSpeed& wiperSpeed,
+                                                                    bool& isWaitingToTurnOff,
+                                                                    bool hasTurnOffDelayElapsed) const {
+    std::uint8_t transitionEntry = transitionEntries[encodeIndex(wiperSpeed, isWaitingToTurnOff, operatingMode,
+                                                                 sensorData.isValidReading, sensorData.isSuddenRainBurst,
+                                                                 targetSpeed, hasTurnOffDelayElapsed)];
+    wiperSpeed = static_cast<WindshieldWiperSpeed>(transitionEntry & 3);
+    isWaitingToTurnOff = (transitionEntry & 4) != 0;
+    return static_cast<TurnOffCountdownEvent>(transitionEntry >> 3);
+}
+
+void AutomaticModeTransitionTable::stepBatch(const std::uint8_t* validReadingFlags,
+                                             const std::uint8_t* suddenRainBurstFlags,
+                                             const WindshieldWiperSpeed* targetSpeeds,
+                                             const std::uint8_t* turnOffDelayElapsedFlags,
+                                             const OperatingMode* operatingModes,
+                                             WindshieldWiperSpeed* wiperSpeeds,
+                                             std::uint8_t* waitingToTurnOffFlags,
+                                             TurnOffCountdownEvent* countdownEvents,
+                                             std::size_t controllerCount) const {
+    for (std::size_t controllerIndex = 0; controllerIndex < controllerCount; controllerIndex++) {
+        // Arithmetic index build: no branch depends on the controller's state or inputs
+        std::size_t entryIndex = (static_cast<std::size_t>(wiperSpeeds[controllerIndex]) & 3) |
+                                 ((static_cast<std::size_t>(waitingToTurnOffFlags[controllerIndex]) & 1) << 2) |
+                                 (static_cast<std::size_t>(operatingModes[controllerIndex] == OperatingMode::AUTOMATIC) << 3) |
+                                 ((static_cast<std::size_t>(validReadingFlags[controllerIndex]) & 1) << 4) |
+                                 ((static_cast<std::size_t>(suddenRainBurstFlags[controllerIndex]) & 1) << 5) |
+                                 ((static_cast<std::size_t>(targetSpeeds[controllerIndex]) & 3) << 6) |
+                                 ((static_cast<std::size_t>(turnOffDelayElapsedFlags[controllerIndex]) & 1) << 8);
+        std::uint8_t transitionEntry = transitionEntries[entryIndex];
+        wiperSpeeds[controllerIndex] = static_cast<WindshieldWiperSpeed>(transitionEntry & 3);
+        waitingToTurnOffFlags[controllerIndex] = static_cast<std::uint8_t>((transitionEntry >> 2) & 1);
+        countdownEvents[controllerIndex] = static_cast<TurnOffCountdownEvent>(transitionEntry >> 3);
+    }
+}
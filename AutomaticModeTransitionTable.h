@@ -0,0 +1,91 @@
+#ifndef AUTOMATIC_MODE_TRANSITION_TABLE_H
+#define AUTOMATIC_MODE_TRANSITION_TABLE_H
+
+#include "WiperEnums.h"
+#include "RainSensor.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief AutomaticModeTransitionTable class for branch-free automatic mode stepping
+ *
+ * The controller state (speed, waiting flag, operating mode) and the sample's inputs
+ * (valid, burst, target speed, delay elapsed) are packed into a 9-bit index:
+ *
+ *   bits 0-1 speed, bit 2 waiting, bit 3 automatic mode, bit 4 valid reading,
+ *   bit 5 sudden burst, bits 6-7 target speed, bit 8 turn-off delay elapsed
+ *
+ * Each of the 512 one-byte entries holds the next speed, waiting flag and countdown
+ * event. The table is filled by running WindshieldWiperController::applyAutomaticModeRules
+ * on every index, so it is equivalent by construction; manual mode entries leave the
+ * state unchanged. Spray mode is not part of the rules and is never touched. At 512
+ * bytes the table stays in L1, and stepBatch() is a straight-line gather per vehicle.
+ */
+class AutomaticModeTransitionTable {
+public:
+    static const std::size_t ENTRY_COUNT = 512;
+
+    /**
+     * @brief Constructor that builds the table from the automatic mode rules
+     */
+    AutomaticModeTransitionTable();
+
+    /**
+     * @brief Pack a controller state and sample into a table index
+     * @param wiperSpeed Current wiper speed
+     * @param isWaitingToTurnOff Current turn-off countdown flag
+     * @param operatingMode Current operating mode (manual entries never change state)
+     * @param isValidReading Whether the sensor reading is valid
+     * @param isSuddenRainBurst Whether the reading is a sudden rain burst
+     * @param targetSpeed Speed mapped from the reading's light percentage
+     * @param hasTurnOffDelayElapsed Whether a pending countdown has run for the full delay
+     * @return Index in [0, ENTRY_COUNT)
+     */
+    static std::size_t encodeIndex(WindshieldWiperSpeed wiperSpeed, bool isWaitingToTurnOff, OperatingMode operatingMode,
+                                   bool isValidReading, bool isSuddenRainBurst, WindshieldWiperSpeed targetSpeed,
+                                   bool hasTurnOffDelayElapsed);
+
+    /**
+     * @brief Step one controller with a table lookup
+     * @param sensorData The sensor data to process
+     * @param targetSpeed Speed mapped from the sample's light percentage
+     * @param operatingMode Current operating mode
+     * @param wiperSpeed Wiper speed, updated in place
+     * @param isWaitingToTurnOff Turn-off countdown flag, updated in place
+     * @param hasTurnOffDelayElapsed Whether a pending countdown has run for the full delay
+     * @return The change this sample made to the turn-off countdown
+     */
+    TurnOffCountdownEvent applyTransition(const RainSensor::SensorReadingData& sensorData,
+                                          WindshieldWiperSpeed targetSpeed,
+                                          OperatingMode operatingMode,
+                                          WindshieldWiperSpeed& wiperSpeed,
+                                          bool& isWaitingToTurnOff,
+                                          bool hasTurnOffDelayElapsed) const;
+
+    /**
+     * @brief Step many controllers stored as parallel arrays, without data-dependent branches
+     * @param validReadingFlags 0/1 per controller
+     * @param suddenRainBurstFlags 0/1 per controller
+     * @param targetSpeeds Speed mapped from each controller's light percentage
+     * @param turnOffDelayElapsedFlags 0/1 per controller
+     * @param operatingModes Operating mode per controller
+     * @param wiperSpeeds Wiper speeds, updated in place
+     * @param waitingToTurnOffFlags 0/1 countdown flags, updated in place
+     * @param countdownEvents Receives the countdown change per controller
+     * @param controllerCount Number of controllers
+     */
+    void stepBatch(const std::uint8_t* validReadingFlags,
+                   const std::uint8_t* suddenRainBurstFlags,
+                   const WindshieldWiperSpeed* targetSpeeds,
+                   const std::uint8_t* turnOffDelayElapsedFlags,
+                   const OperatingMode* operatingModes,
+                   WindshieldWiperSpeed* wiperSpeeds,
+                   std::uint8_t* waitingToTurnOffFlags,
+                   TurnOffCountdownEvent* countdownEvents,
+                   std::size_t controllerCount) const;
+
+private:
+    std::uint8_t transitionEntries[ENTRY_COUNT]; // bits 0-1 speed, bit 2 waiting, bits 3-4 countdown event
+};
+
+#endif // AUTOMATIC_MODE_TRANSITION_TABLE_H
@@ -1,5 +1,7 @@
 #include "ColorUtilities.h"
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 void enableAnsiColorSupport() {
     #ifdef _WIN32
@@ -12,5 +14,17 @@ void enableAnsiColorSupport() {
 }
 
 void printColoredText(const std::string& textMessage, const std::string& colorCode) {
-    std::cout << colorCode << textMessage << COLOR_RESET;
+    printColoredText(std::cout, textMessage, colorCode);
+}
+
+void printColoredText(std::ostream& outputStream, const std::string& textMessage, const std::string& colorCode) {
+    outputStream << colorCode << textMessage << COLOR_RESET;
+}
+
+void printColoredText(const char* textMessage, const char* colorCode) {
+    printColoredText(std::cout, textMessage, colorCode);
+}
+
+void printColoredText(std::ostream& outputStream, const char* textMessage, const char* colorCode) {
+    outputStream << colorCode << textMessage << COLOR_RESET;
 }
\ No newline at end of file
@@ -33,4 +33,27 @@ void enableAnsiColorSupport();
  */
 void printColoredText(const std::string& textMessage, const std::string& colorCode);
 
+/**
+ * @brief Print colored text to any output stream
+ * @param outputStream The stream to print to
+ * @param textMessage The text to print
+ * @param colorCode The ANSI color code to use
+ */
+void printColoredText(std::ostream& outputStream, const std::string& textMessage, const std::string& colorCode);
+
+/**
+ * @brief Print colored text to console without building std::string temporaries
+ * @param textMessage The null-terminated text to print
+ * @param colorCode The ANSI color code to use
+ */
+void printColoredText(const char* textMessage, const char* colorCode);
+
+/**
+ * @brief Print colored text to any output stream without building std::string temporaries
+ * @param outputStream The stream to print to
+ * @param textMessage The null-terminated text to print
+ * @param colorCode The ANSI color code to use
+ */
+void printColoredText(std::ostream& outputStream, const char* textMessage, const char* colorCode);
+
 #endif // COLOR_UTILITIES_H
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "ConsoleEventLoop.h"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+ConsoleEventLoop::ConsoleEventLoop()
+    : inputDescriptor(0), // Standard input (STDIN_FILENO)
+      epollDescriptor(-1),
+      timerDescriptor(-1),
+      isLoopRunning(false),
+      wakeupCount(0) {
+    initializeReactor();
+}
+
+ConsoleEventLoop::ConsoleEventLoop(int inputFileDescriptor)
+    : inputDescriptor(inputFileDescriptor),
+      epollDescriptor(-1),
+      timerDescriptor(-1),
+      isLoopRunning(false),
+      wakeupCount(0) {
+    initializeReactor();
+}
+
+void ConsoleEventLoop::initializeReactor() {
+#if defined(__linux__)
+    epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+    timerDescriptor = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (epollDescriptor < 0 || timerDescriptor < 0) {
+        return;
+    }
+
+    struct epoll_event inputEvent = {};
+    inputEvent.events = EPOLLIN;
+    inputEvent.data.fd = inputDescriptor;
+    struct epoll_event timerEvent = {};
+    timerEvent.events = EPOLLIN;
+    timerEvent.data.fd = timerDescriptor;
+    if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, inputDescriptor, &inputEvent) != 0 ||
+        epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, timerDescriptor, &timerEvent) != 0) {
+        close(epollDescriptor);
+        epollDescriptor = -1;
+    }
+#endif
+}
+
+ConsoleEventLoop::~ConsoleEventLoop() {
+#if defined(__linux__)
+    if (epollDescriptor >= 0) {
+        close(epollDescriptor);
+    }
+    if (timerDescriptor >= 0) {
+        close(timerDescriptor);
+    }
+#endif
+}
+
+bool ConsoleEventLoop::isSupported() const {
+    return epollDescriptor >= 0 && timerDescriptor >= 0;
+}
+
+void ConsoleEventLoop::setPeriodicTimer(std::chrono::steady_clock::time_point firstDeadline, std::chrono::nanoseconds timerInterval) {
+#if defined(__linux__)
+    if (!isSupported()) {
+        return;
+    }
+    // steady_clock is CLOCK_MONOTONIC, so the deadline can be armed with TFD_TIMER_ABSTIME
+    std::chrono::nanoseconds deadlineSinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(firstDeadline.time_since_epoch());
+    struct itimerspec timerSpecification = {};
+    timerSpecification.it_value.tv_sec = static_cast<time_t>(deadlineSinceEpoch.count() / 1000000000);
+    timerSpecification.it_value.tv_nsec = static_cast<long>(deadlineSinceEpoch.count() % 1000000000);
+    timerSpecification.it_interval.tv_sec = static_cast<time_t>(timerInterval.count() / 1000000000);
+    timerSpecification.it_interval.tv_nsec = static_cast<long>(timerInterval.count() % 1000000000);
+    timerfd_settime(timerDescriptor, TFD_TIMER_ABSTIME, &timerSpecification, nullptr);
+#else
+    (void)firstDeadline;
+    (void)timerInterval;
+#endif
+}
+
+void ConsoleEventLoop::run(const KeyPressedHandler& onKeyPressed, const TimerExpiredHandler& onTimerExpired) {
+#if defined(__linux__)
+    if (!isSupported()) {
+        return;
+    }
+
+    const int MAX_EVENTS_PER_WAKEUP = 2;
+    struct epoll_event readyEvents[MAX_EVENTS_PER_WAKEUP];
+    isLoopRunning = true;
+
+    while (isLoopRunning) {
+        // Block until stdin is readable or the timer fires - no polling interval
+        int readyCount = epoll_wait(epollDescriptor, readyEvents, MAX_EVENTS_PER_WAKEUP, -1);
+        if (readyCount < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        wakeupCount++;
+
+        for (int eventIndex = 0; eventIndex < readyCount && isLoopRunning; eventIndex++) {
+            if (readyEvents[eventIndex].data.fd == timerDescriptor) {
+                std::uint64_t expirationCount = 0;
+                if (read(timerDescriptor, &expirationCount, sizeof(expirationCount)) == sizeof(expirationCount)) {
+                    onTimerExpired(expirationCount);
+                }
+            } else if ((readyEvents[eventIndex].events & (EPOLLHUP | EPOLLERR)) != 0 &&
+                       (readyEvents[eventIndex].events & EPOLLIN) == 0) {
+                // Input closed - nothing more can arrive
+                isLoopRunning = false;
+            } else {
+                drainConsoleInput(onKeyPressed);
+            }
+        }
+    }
+#else
+    (void)onKeyPressed;
+    (void)onTimerExpired;
+#endif
+}
+
+void ConsoleEventLoop::stop() {
+    isLoopRunning = false;
+}
+
+std::uint64_t ConsoleEventLoop::getWakeupCount() const {
+    return wakeupCount;
+}
+
+void ConsoleEventLoop::drainConsoleInput(const KeyPressedHandler& onKeyPressed) {
+#if defined(__linux__)
+    // Take one keystroke at a time and re-check what is buffered, because a handler may
+    // itself read stdin (menu prompts) and stdin stays in blocking mode for those reads
+    int pendingByteCount = 1;
+    while (pendingByteCount > 0 && isLoopRunning) {
+        char typedCharacter = 0;
+        ssize_t receivedByteCount = read(inputDescriptor, &typedCharacter, 1);
+        if (receivedByteCount <= 0) {
+            if (receivedByteCount == 0) {
+                isLoopRunning = false; // End of input
+            }
+            return;
+        }
+        onKeyPressed(typedCharacter);
+
+        if (ioctl(inputDescriptor, FIONREAD, &pendingByteCount) != 0) {
+            pendingByteCount = 0;
+        }
+    }
+#else
+    (void)onKeyPressed;
+#endif
+}
@@ -0,0 +1,89 @@
+#ifndef CONSOLE_EVENT_LOOP_H
+#define CONSOLE_EVENT_LOOP_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief ConsoleEventLoop class to wait on keyboard input and a periodic timer together
+ *
+ * On Linux the loop is an epoll reactor over stdin (or a given descriptor) and a timerfd, so the process only
+ * wakes when a key arrives or the timer expires, and every pending keystroke is drained
+ * per wakeup. Other platforms report isSupported() == false and keep their polling loop.
+ */
+class ConsoleEventLoop {
+public:
+    typedef std::function<void(char)> KeyPressedHandler;
+    typedef std::function<void(std::uint64_t)> TimerExpiredHandler;
+
+    /**
+     * @brief Constructor for ConsoleEventLoop on standard input
+     */
+    ConsoleEventLoop();
+
+    /**
+     * @brief Constructor for ConsoleEventLoop on another input descriptor (e.g. a pipe in tests)
+     * @param inputFileDescriptor Descriptor to read keystrokes from (not closed by the loop)
+     */
+    explicit ConsoleEventLoop(int inputFileDescriptor);
+
+    /**
+     * @brief Destructor that closes the epoll and timer descriptors
+     */
+    ~ConsoleEventLoop();
+
+    /**
+     * @brief Check if the reactor could be created on this platform
+     * @return True if run() can be used
+     */
+    bool isSupported() const;
+
+    /**
+     * @brief Arm the timer on absolute deadlines
+     * @param firstDeadline Absolute steady_clock time of the first expiration
+     * @param timerInterval Time between expirations (deadlines stay firstDeadline + k * interval)
+     */
+    void setPeriodicTimer(std::chrono::steady_clock::time_point firstDeadline, std::chrono::nanoseconds timerInterval);
+
+    /**
+     * @brief Dispatch events until stop() is called
+     * @param onKeyPressed Called once per drained keystroke
+     * @param onTimerExpired Called per timer wakeup with the number of expirations since the last one
+     */
+    void run(const KeyPressedHandler& onKeyPressed, const TimerExpiredHandler& onTimerExpired);
+
+    /**
+     * @brief Ask run() to return after the current wakeup
+     */
+    void stop();
+
+    /**
+     * @brief Get how many times run() woke up with events ready
+     * @return Wakeup count since construction
+     */
+    std::uint64_t getWakeupCount() const;
+
+private:
+    ConsoleEventLoop(const ConsoleEventLoop&);
+    ConsoleEventLoop& operator=(const ConsoleEventLoop&);
+
+    int inputDescriptor;
+    int epollDescriptor;
+    int timerDescriptor;
+    bool isLoopRunning;
+    std::uint64_t wakeupCount;
+
+    /**
+     * @brief Create the epoll set over the input descriptor and the timer
+     */
+    void initializeReactor();
+
+    /**
+     * @brief Read every keystroke currently buffered on the input descriptor
+     * @param onKeyPressed Handler to call per keystroke
+     */
+    void drainConsoleInput(const KeyPressedHandler& onKeyPressed);
+};
+
+#endif // CONSOLE_EVENT_LOOP_H
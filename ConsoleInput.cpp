@@ -0,0 +1,63 @@
+#include "ConsoleInput.h"
+#include <cstdlib>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <conio.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+char readConsoleCharacter() {
+#if defined(_WIN32)
+    return static_cast<char>(_getch());
+#else
+    char typedCharacter = 0;
+    if (read(STDIN_FILENO, &typedCharacter, 1) != 1) {
+        return 0;
+    }
+    return typedCharacter;
+#endif
+}
+
+bool isConsoleInputAvailable() {
+#if defined(_WIN32)
+    return _kbhit() != 0;
+#else
+    struct pollfd inputDescriptor;
+    inputDescriptor.fd = STDIN_FILENO;
+    inputDescriptor.events = POLLIN;
+    inputDescriptor.revents = 0;
+    return poll(&inputDescriptor, 1, 0) > 0 && (inputDescriptor.revents & POLLIN) != 0;
+#endif
+}
+
+void clearConsoleScreen() {
+#if defined(_WIN32)
+    system("cls");
+#else
+    std::cout << "\033[2J\033[H" << std::flush;
+#endif
+}
+
+ConsoleRawModeGuard::ConsoleRawModeGuard() {
+#if !defined(_WIN32)
+    hasOriginalTerminalSettings = (tcgetattr(STDIN_FILENO, &originalTerminalSettings) == 0);
+    if (hasOriginalTerminalSettings) {
+        struct termios rawTerminalSettings = originalTerminalSettings;
+        rawTerminalSettings.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+        rawTerminalSettings.c_cc[VMIN] = 1;
+        rawTerminalSettings.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &rawTerminalSettings);
+    }
+#endif
+}
+
+ConsoleRawModeGuard::~ConsoleRawModeGuard() {
+#if !defined(_WIN32)
+    if (hasOriginalTerminalSettings) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &originalTerminalSettings);
+    }
+#endif
+}
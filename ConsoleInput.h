@@ -0,0 +1,53 @@
+#ifndef CONSOLE_INPUT_H
+#define CONSOLE_INPUT_H
+
+#if !defined(_WIN32)
+#include <termios.h>
+#endif
+
+/**
+ * @brief Read one keystroke without waiting for Enter (blocks until a key is pressed)
+ * @return The character that was typed
+ */
+char readConsoleCharacter();
+
+/**
+ * @brief Check whether a keystroke is waiting to be read
+ * @return True if readConsoleCharacter() would not block
+ */
+bool isConsoleInputAvailable();
+
+/**
+ * @brief Clear the console screen
+ */
+void clearConsoleScreen();
+
+/**
+ * @brief ConsoleRawModeGuard class to switch the terminal to unbuffered, no-echo input
+ *
+ * Windows consoles already deliver keystrokes through _getch(), so the guard does
+ * nothing there. On POSIX terminals the previous settings are restored on destruction.
+ */
+class ConsoleRawModeGuard {
+public:
+    /**
+     * @brief Constructor for ConsoleRawModeGuard
+     */
+    ConsoleRawModeGuard();
+
+    /**
+     * @brief Destructor that restores the original terminal settings
+     */
+    ~ConsoleRawModeGuard();
+
+private:
+    ConsoleRawModeGuard(const ConsoleRawModeGuard&);
+    ConsoleRawModeGuard& operator=(const ConsoleRawModeGuard&);
+
+#if !defined(_WIN32)
+    struct termios originalTerminalSettings;
+    bool hasOriginalTerminalSettings;
+#endif
+};
+
+#endif // CONSOLE_INPUT_H
@@ -0,0 +1,76 @@
+#include "CounterBasedRandom.h"
+
+namespace {
+
+const std::uint32_t PHILOX_MULTIPLIER_0 = 0xD2511F53u;
+const std::uint32_t PHILOX_MULTIPLIER_1 = 0xCD9E8D57u;
+const std::uint32_t PHILOX_KEY_INCREMENT_0 = 0x9E3779B9u;
+const std::uint32_t PHILOX_KEY_INCREMENT_1 = 0xBB67AE85u;
+const int PHILOX_ROUND_COUNT = 10;
+
+} // namespace
+
+CounterBasedRandom::RandomBlock CounterBasedRandom::generateBlock(std::uint64_t seed, std::uint64_t streamId, std::uint64_t counter) {
+    // 128-bit counter = (counter, stream ID), 64-bit key = seed
+    std::uint32_t counterWords[4] = {
+        static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32),
+        static_cast<std::uint32_t>(streamId), static_cast<std::uint32_t>(streamId >> 32)
+    };
+    std::uint32_t keyWords[2] = {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+
+    for (int roundIndex = 0; roundIndex < PHILOX_ROUND_COUNT; roundIndex++) {
+        std::uint64_t product0 = static_cast<std::uint64_t>(PHILOX_MULTIPLIER_0) * counterWords[0];
+        std::uint64_t product1 = static_cast<std::uint64_t>(PHILOX_MULTIPLIER_1) * counterWords[2];
+        std::uint32_t mixedWords[4] = {
+            static_cast<std::uint32_t>(product1 >> 32) ^ counterWords[1] ^ keyWords[0],
+            static_cast<std::uint32_t>(product1),
+            static_cast<std::uint32_t>(product0 >> 32) ^ counterWords[3] ^ keyWords[1],
+            static_cast<std::uint32_t>(product0)
+        };
+        counterWords[0] = mixedWords[0];
+        counterWords[1] = mixedWords[1];
+        counterWords[2] = mixedWords[2];
+        counterWords[3] = mixedWords[3];
+        keyWords[0] += PHILOX_KEY_INCREMENT_0;
+        keyWords[1] += PHILOX_KEY_INCREMENT_1;
+    }
+
+    RandomBlock randomBlock;
+    for (int wordIndex = 0; wordIndex < 4; wordIndex++) {
+        randomBlock.words[wordIndex] = counterWords[wordIndex];
+    }
+    return randomBlock;
+}
+
+void CounterBasedRandom::generateBlocks(std::uint64_t seed, std::uint64_t streamId, std::uint64_t firstCounter, std::size_t blockCount,
+                                        std::uint32_t* words0, std::uint32_t* words1, std::uint32_t* words2, std::uint32_t* words3) {
+    for (std::size_t blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+        std::uint64_t counter = firstCounter + blockIndex;
+        words0[blockIndex] = static_cast<std::uint32_t>(counter);
+        words1[blockIndex] = static_cast<std::uint32_t>(counter >> 32);
+        words2[blockIndex] = static_cast<std::uint32_t>(streamId);
+        words3[blockIndex] = static_cast<std::uint32_t>(streamId >> 32);
+    }
+
+    std::uint32_t keyWord0 = static_cast<std::uint32_t>(seed);
+    std::uint32_t keyWord1 = static_cast<std::uint32_t>(seed >> 32);
+    for (int roundIndex = 0; roundIndex < PHILOX_ROUND_COUNT; roundIndex++) {
+        // Same round as generateBlock(), applied lane-wise with no dependency between blocks
+        for (std::size_t blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+            std::uint64_t product0 = static_cast<std::uint64_t>(PHILOX_MULTIPLIER_0) * words0[blockIndex];
+            std::uint64_t product1 = static_cast<std::uint64_t>(PHILOX_MULTIPLIER_1) * words2[blockIndex];
+            std::uint32_t mixedWord0 = static_cast<std::uint32_t>(product1 >> 32) ^ words1[blockIndex] ^ keyWord0;
+            std::uint32_t mixedWord2 = static_cast<std::uint32_t>(product0 >> 32) ^ words3[blockIndex] ^ keyWord1;
+            words0[blockIndex] = mixedWord0;
+            words1[blockIndex] = static_cast<std::uint32_t>(product1);
+            words2[blockIndex] = mixedWord2;
+            words3[blockIndex] = static_cast<std::uint32_t>(product0);
+        }
+        keyWord0 += PHILOX_KEY_INCREMENT_0;
+        keyWord1 += PHILOX_KEY_INCREMENT_1;
+    }
+}
+
+double CounterBasedRandom::convertToUnitInterval(std::uint32_t randomWord) {
+    return static_cast<double>(randomWord) * (1.0 / 4294967296.0);
+}
@@ -0,0 +1,21 @@
+#include "EventLogger.h"
+#include <iostream>
+
+/**
+ * @brief Offline decoder that prints a binary event log as text
+ *
+ * Usage: WiperEventLogDecoder <logFile>
+ * @return Exit status code
+ */
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <logFile>" << std::endl;
+        return 1;
+    }
+
+    if (!decodeEventLog(argv[1], std::cout)) {
+        std::cerr << "Not a readable event log: " << argv[1] << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include "EventLogger.h"
+#include "WiperEnums.h"
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+
+namespace {
+
+const char EVENT_LOG_MAGIC[8] = {'W', 'I', 'P', 'E', 'V', 'L', 'O', 'G'};
+
+/**
+ * @brief Structure for the binary log file header
+ */
+struct EventLogFileHeader {
+    char magic[8];
+    std::uint32_t formatVersion;
+    std::uint32_t recordSize;
+    std::int64_t steadyStartNanoseconds; // steady_clock time when the log was opened
+    std::int64_t wallStartNanoseconds;   // system_clock time at the same instant
+};
+
+std::int64_t getSteadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* convertOperatingModeToString(std::int32_t operatingMode) {
+    return (static_cast<OperatingMode>(operatingMode) == OperatingMode::AUTOMATIC) ? "AUTO" : "MANUAL";
+}
+
+std::uint64_t convertDroppedEventCount(const EventLogRecord& eventRecord) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(eventRecord.arguments[0])) |
+           (static_cast<std::uint64_t>(static_cast<std::uint32_t>(eventRecord.arguments[1])) << 32);
+}
+
+void formatEventRecord(const EventLogRecord& eventRecord, std::ostream& outputStream) {
+    const std::int32_t* arguments = eventRecord.arguments;
+    switch (static_cast<SystemEventId>(eventRecord.eventId)) {
+        case SystemEventId::SYSTEM_STARTED:
+            outputStream << "System started in " << convertOperatingModeToString(arguments[0]) << " mode";
+            break;
+        case SystemEventId::SYSTEM_SHUTDOWN:
+            outputStream << "System shut down";
+            break;
+        case SystemEventId::OPERATING_MODE_CHANGED:
+            outputStream << "Switched to " << convertOperatingModeToString(arguments[0]) << " mode";
+            break;
+        case SystemEventId::WIPER_SPEED_SET:
+            // Setting records have no console line of their own; the console message depends on the command
+            outputStream << "Setting: Wiper speed " << convertWiperSpeedToString(static_cast<WindshieldWiperSpeed>(arguments[0]));
+            break;
+        case SystemEventId::SPRAY_MODE_SET:
+            outputStream << "Setting: Spray " << convertSprayModeToString(static_cast<WaterSprayMode>(arguments[0]));
+            break;
+        case SystemEventId::AUTOMATIC_MODE_TICK:
+            // Same text as StatusLineRenderer::renderAutomaticModeStatusLine() for this tick
+            outputStream << "Mode: AUTO | Sensor: ";
+            if (arguments[1] == 0) {
+                outputStream << "ERROR";
+            } else {
+                outputStream << (arguments[0] / 100) << "%";
+            }
+            outputStream << " | Wiper: " << convertWiperSpeedToString(static_cast<WindshieldWiperSpeed>(arguments[3]));
+            if (arguments[1] == 0) {
+                outputStream << " (Sensor Failure - Switch to Manual)";
+            } else {
+                if (arguments[2] != 0) {
+                    outputStream << " (Sudden Rain Burst)";
+                }
+                if (arguments[4] > 0) {
+                    outputStream << " (Turning OFF in " << arguments[4] << "s)";
+                }
+            }
+            break;
+        case SystemEventId::MANUAL_MODE_TICK:
+            outputStream << "Mode: MANUAL | Wiper: " << convertWiperSpeedToString(static_cast<WindshieldWiperSpeed>(arguments[0]));
+            if (static_cast<WaterSprayMode>(arguments[1]) != WaterSprayMode::OFF) {
+                outputStream << " | Spray: " << convertSprayModeToString(static_cast<WaterSprayMode>(arguments[1]));
+            }
+            break;
+        case SystemEventId::LOG_CLOSED:
+            outputStream << "Log closed, " << convertDroppedEventCount(eventRecord) << " events dropped";
+            break;
+        default:
+            outputStream << "Unknown event " << eventRecord.eventId;
+            for (std::uint16_t argumentIndex = 0; argumentIndex < eventRecord.argumentCount && argumentIndex < 5; argumentIndex++) {
+                outputStream << " " << arguments[argumentIndex];
+            }
+            break;
+    }
+}
+
+} // namespace
+
+EventLogger::EventLogger()
+    : ringBuffer(RING_CAPACITY),
+      writeIndex(0),
+      readIndex(0),
+      droppedEventCount(0),
+      isWriterRunning(false),
+      logFile(nullptr) {
+}
+
+EventLogger::~EventLogger() {
+    close();
+}
+
+bool EventLogger::open(const std::string& logFilePath) {
+    close();
+
+    logFile = std::fopen(logFilePath.c_str(), "wb");
+    if (logFile == nullptr) {
+        return false;
+    }
+
+    EventLogFileHeader fileHeader;
+    std::memcpy(fileHeader.magic, EVENT_LOG_MAGIC, sizeof(fileHeader.magic));
+    fileHeader.formatVersion = FILE_FORMAT_VERSION;
+    fileHeader.recordSize = static_cast<std::uint32_t>(sizeof(EventLogRecord));
+    fileHeader.steadyStartNanoseconds = getSteadyNanoseconds();
+    fileHeader.wallStartNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::fwrite(&fileHeader, sizeof(fileHeader), 1, logFile);
+
+    writeIndex.store(0, std::memory_order_relaxed);
+    readIndex.store(0, std::memory_order_relaxed);
+    droppedEventCount.store(0, std::memory_order_relaxed);
+    isWriterRunning.store(true, std::memory_order_release);
+    writerThread = std::thread(&EventLogger::runWriterThread, this);
+    return true;
+}
+
+void EventLogger::close() {
+    if (logFile == nullptr) {
+        return;
+    }
+    isWriterRunning.store(false, std::memory_order_release);
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+
+    // The writer has stopped, so the footer lands after every drained record
+    std::uint64_t finalDroppedCount = droppedEventCount.load(std::memory_order_relaxed);
+    EventLogRecord footerRecord;
+    std::memset(&footerRecord, 0, sizeof(footerRecord));
+    footerRecord.timestampNanoseconds = static_cast<std::uint64_t>(getSteadyNanoseconds());
+    footerRecord.eventId = static_cast<std::uint16_t>(SystemEventId::LOG_CLOSED);
+    footerRecord.argumentCount = 2;
+    footerRecord.arguments[0] = static_cast<std::int32_t>(finalDroppedCount & 0xFFFFFFFFu);
+    footerRecord.arguments[1] = static_cast<std::int32_t>(finalDroppedCount >> 32);
+    std::fwrite(&footerRecord, sizeof(footerRecord), 1, logFile);
+    std::fclose(logFile);
+    logFile = nullptr;
+}
+
+bool EventLogger::isOpen() const {
+    return logFile != nullptr;
+}
+
+void EventLogger::logEvent(SystemEventId eventId, std::uint16_t argumentCount,
+                           std::int32_t argument0, std::int32_t argument1, std::int32_t argument2,
+                           std::int32_t argument3, std::int32_t argument4) {
+    if (logFile == nullptr) {
+        return;
+    }
+
+    // Single producer: only this thread writes writeIndex, so a relaxed load is enough
+    std::uint64_t currentWriteIndex = writeIndex.load(std::memory_order_relaxed);
+    if (currentWriteIndex - readIndex.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    EventLogRecord& eventRecord = ringBuffer[currentWriteIndex & (RING_CAPACITY - 1)];
+    eventRecord.timestampNanoseconds = static_cast<std::uint64_t>(getSteadyNanoseconds());
+    eventRecord.eventId = static_cast<std::uint16_t>(eventId);
+    eventRecord.argumentCount = argumentCount;
+    eventRecord.arguments[0] = argument0;
+    eventRecord.arguments[1] = argument1;
+    eventRecord.arguments[2] = argument2;
+    eventRecord.arguments[3] = argument3;
+    eventRecord.arguments[4] = argument4;
+
+    // Publish the record to the writer thread
+    writeIndex.store(currentWriteIndex + 1, std::memory_order_release);
+}
+
+std::uint64_t EventLogger::getDroppedEventCount() const {
+    return droppedEventCount.load(std::memory_order_relaxed);
+}
+
+void EventLogger::runWriterThread() {
+    while (isWriterRunning.load(std::memory_order_acquire)) {
+        if (drainRingBuffer() == 0) {
+            // Nothing pending - back off instead of making the producer signal us
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    drainRingBuffer();
+    std::fflush(logFile);
+}
+
+std::size_t EventLogger::drainRingBuffer() {
+    std::uint64_t currentReadIndex = readIndex.load(std::memory_order_relaxed);
+    std::uint64_t currentWriteIndex = writeIndex.load(std::memory_order_acquire);
+    std::size_t pendingCount = static_cast<std::size_t>(currentWriteIndex - currentReadIndex);
+
+    std::size_t writtenCount = 0;
+    while (writtenCount < pendingCount) {
+        // Write the contiguous run up to the end of the ring, then wrap
+        std::size_t ringPosition = static_cast<std::size_t>((currentReadIndex + writtenCount) & (RING_CAPACITY - 1));
+        std::size_t contiguousCount = RING_CAPACITY - ringPosition;
+        if (contiguousCount > pendingCount - writtenCount) {
+            contiguousCount = pendingCount - writtenCount;
+        }
+        std::fwrite(&ringBuffer[ringPosition], sizeof(EventLogRecord), contiguousCount, logFile);
+        writtenCount += contiguousCount;
+    }
+
+    readIndex.store(currentReadIndex + writtenCount, std::memory_order_release);
+    return writtenCount;
+}
+
+bool decodeEventLog(const std::string& logFilePath, std::ostream& outputStream) {
+    std::FILE* logFile = std::fopen(logFilePath.c_str(), "rb");
+    if (logFile == nullptr) {
+        return false;
+    }
+
+    EventLogFileHeader fileHeader;
+    bool isValidHeader = std::fread(&fileHeader, sizeof(fileHeader), 1, logFile) == 1 &&
+                         std::memcmp(fileHeader.magic, EVENT_LOG_MAGIC, sizeof(fileHeader.magic)) == 0 &&
+                         fileHeader.formatVersion == EventLogger::FILE_FORMAT_VERSION &&
+                         fileHeader.recordSize == sizeof(EventLogRecord);
+    if (!isValidHeader) {
+        std::fclose(logFile);
+        return false;
+    }
+
+    EventLogRecord eventRecord;
+    bool hasFooter = false;
+    while (std::fread(&eventRecord, sizeof(eventRecord), 1, logFile) == 1) {
+        hasFooter = static_cast<SystemEventId>(eventRecord.eventId) == SystemEventId::LOG_CLOSED;
+        // Rebase the steady timestamp onto the wall clock captured when the log was opened
+        std::int64_t wallNanoseconds = fileHeader.wallStartNanoseconds +
+            (static_cast<std::int64_t>(eventRecord.timestampNanoseconds) - fileHeader.steadyStartNanoseconds);
+        std::time_t wallSeconds = static_cast<std::time_t>(wallNanoseconds / 1000000000);
+        std::tm timeStructure = *std::localtime(&wallSeconds);
+
+        outputStream << "[" << std::put_time(&timeStructure, "%H:%M:%S") << "."
+                     << std::setw(6) << std::setfill('0') << ((wallNanoseconds / 1000) % 1000000)
+                     << std::setfill(' ') << "] ";
+        formatEventRecord(eventRecord, outputStream);
+        outputStream << "\n";
+    }
+    if (!hasFooter) {
+        // Crashed or killed before close(), so the drop count never reached the file
+        outputStream << "Log not closed cleanly, dropped event count unknown\n";
+    }
+
+    std::fclose(logFile);
+    return true;
+}
@@ -0,0 +1,135 @@
+#ifndef EVENT_LOGGER_H
+#define EVENT_LOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Enum for binary log event identifiers (values are part of the file format)
+ */
+enum class SystemEventId : std::uint16_t {
+    SYSTEM_STARTED = 1,          // args: operating mode
+    SYSTEM_SHUTDOWN = 2,         // args: none
+    OPERATING_MODE_CHANGED = 3,  // args: operating mode
+    WIPER_SPEED_SET = 4,         // args: wiper speed
+    SPRAY_MODE_SET = 5,          // args: spray mode
+    AUTOMATIC_MODE_TICK = 6,     // args: light (0.01 %), valid, burst, wiper speed, remaining turn-off seconds
+    MANUAL_MODE_TICK = 7,        // args: wiper speed, spray mode
+    LOG_CLOSED = 8               // args: dropped event count (low, high 32 bits); written once by close()
+};
+
+/**
+ * @brief Structure for one fixed-size binary log record
+ */
+struct EventLogRecord {
+    std::uint64_t timestampNanoseconds;
+    std::uint16_t eventId;
+    std::uint16_t argumentCount;
+    std::int32_t arguments[5];
+};
+
+/**
+ * @brief EventLogger class to record events with deferred formatting
+ *
+ * The control thread only copies an event ID, raw integer arguments and a timestamp
+ * into a single-producer/single-consumer lock-free ring. A background thread writes
+ * the raw records to a binary file, and decodeEventLog() turns them into text offline.
+ * If the ring is full the event is dropped and counted rather than blocking the caller;
+ * close() writes the count as a final LOG_CLOSED record.
+ */
+class EventLogger {
+public:
+    static const std::size_t RING_CAPACITY = 4096; // Must be a power of two
+    static const std::uint32_t FILE_FORMAT_VERSION = 2; // 2: LOG_CLOSED footer
+
+    /**
+     * @brief Constructor for EventLogger (closed until open() is called)
+     */
+    EventLogger();
+
+    /**
+     * @brief Destructor that flushes pending records and stops the writer thread
+     */
+    ~EventLogger();
+
+    /**
+     * @brief Create the log file and start the background writer
+     * @param logFilePath Path of the binary log to create
+     * @return True if the file could be created
+     */
+    bool open(const std::string& logFilePath);
+
+    /**
+     * @brief Flush pending records, stop the writer, append the LOG_CLOSED footer and close the file
+     */
+    void close();
+
+    /**
+     * @brief Check if events are being recorded
+     * @return True if open
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Record an event from the control thread (no formatting, no allocation)
+     * @param eventId The event to record
+     * @param argumentCount Number of meaningful arguments (at most 5)
+     * @param argument0 First raw argument
+     * @param argument1 Second raw argument
+     * @param argument2 Third raw argument
+     * @param argument3 Fourth raw argument
+     * @param argument4 Fifth raw argument
+     */
+    void logEvent(SystemEventId eventId, std::uint16_t argumentCount = 0,
+                  std::int32_t argument0 = 0, std::int32_t argument1 = 0, std::int32_t argument2 = 0,
+                  std::int32_t argument3 = 0, std::int32_t argument4 = 0);
+
+    /**
+     * @brief Get the number of events dropped because the ring was full
+     * @return Dropped event count
+     */
+    std::uint64_t getDroppedEventCount() const;
+
+private:
+    EventLogger(const EventLogger&);
+    EventLogger& operator=(const EventLogger&);
+
+    std::vector<EventLogRecord> ringBuffer;
+    alignas(64) std::atomic<std::uint64_t> writeIndex;
+    alignas(64) std::atomic<std::uint64_t> readIndex;
+    alignas(64) std::atomic<std::uint64_t> droppedEventCount;
+    std::atomic<bool> isWriterRunning;
+    std::FILE* logFile;
+    std::thread writerThread;
+
+    /**
+     * @brief Background loop that moves records from the ring to the file
+     */
+    void runWriterThread();
+
+    /**
+     * @brief Write every record currently in the ring
+     * @return Number of records written
+     */
+    std::size_t drainRingBuffer();
+};
+
+/**
+ * @brief Decode a binary event log into readable text
+ * @param logFilePath Path of the binary log
+ * @param outputStream Stream to write the text to
+ * @return True if the file was a valid event log
+ *
+ * Status ticks decode to the console status line text (without colors); mode and
+ * setting changes decode to a short description. The last line reports how many
+ * events were dropped, or that the log was not closed cleanly.
+ */
+bool decodeEventLog(const std::string& logFilePath, std::ostream& outputStream);
+
+#endif // EVENT_LOGGER_H
@@ -0,0 +1,158 @@
+#include "FleetSimulationEngine.h"
+#include "PeriodicScheduler.h"
+#include "WiperEnums.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Step fresh fleets with 1 to maxThreadCount threads and report scaling efficiency
+ * @param vehicleCount Number of simulated vehicles
+ * @param tickCount Ticks per run
+ * @param tickIntervalMilliseconds Simulated tick interval
+ * @param randomSeed Sensor seed shared by every run
+ * @param maxThreadCount Largest thread count to measure
+ * @return True if every run ended in bit-identical state
+ */
+static bool reportScalingEfficiency(std::size_t vehicleCount, std::uint64_t tickCount, unsigned int tickIntervalMilliseconds,
+                                    std::uint64_t randomSeed, unsigned int maxThreadCount) {
+    std::vector<unsigned int> threadCounts;
+    for (unsigned int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2) {
+        threadCounts.push_back(threadCount);
+    }
+    threadCounts.push_back(maxThreadCount);
+
+    std::cout << std::setw(8) << "Threads" << std::setw(16) << "Ticks/s" << std::setw(10) << "Speedup"
+              << std::setw(12) << "Efficiency" << "  State checksum" << std::endl;
+
+    double serialTicksPerSecond = 0.0;
+    std::uint64_t serialChecksum = 0;
+    bool isDeterministic = true;
+    for (unsigned int threadCount : threadCounts) {
+        FleetSimulationEngine fleetEngine(vehicleCount, tickIntervalMilliseconds, randomSeed);
+        fleetEngine.setWorkerThreadCount(threadCount);
+        FleetSimulationEngine::FleetRunStatistics runStatistics = fleetEngine.runTicks(tickCount);
+        std::uint64_t stateChecksum = fleetEngine.computeStateChecksum();
+        if (threadCount == 1) {
+            serialTicksPerSecond = runStatistics.ticksPerSecond;
+            serialChecksum = stateChecksum;
+        }
+        isDeterministic = isDeterministic && (stateChecksum == serialChecksum);
+
+        double speedup = runStatistics.ticksPerSecond / serialTicksPerSecond;
+        std::cout << std::setw(8) << threadCount << std::setw(16) << std::fixed << std::setprecision(1)
+                  << runStatistics.ticksPerSecond << std::setw(9) << std::setprecision(2) << speedup << "x"
+                  << std::setw(11) << std::setprecision(1) << (100.0 * speedup / threadCount) << "%"
+                  << "  " << std::hex << stateChecksum << std::dec
+                  << (stateChecksum == serialChecksum ? "" : "  MISMATCH") << std::endl;
+    }
+    std::cout << (isDeterministic ? "All runs bit-identical" : "Runs diverged - stepping is not deterministic") << std::endl;
+    return isDeterministic;
+}
+
+/**
+ * @brief Headless entry point that steps a fleet of simulated vehicles
+ *
+ * Usage: WiperFleetSimulation [vehicleCount] [tickCount] [tickIntervalMilliseconds] [options]
+ * Options: --rate-hz=N paces ticks on absolute deadlines (1-1000 Hz) and reports lateness,
+ *          --realtime-cpu=K pins the paced loop to CPU K with SCHED_FIFO,
+ *          --seed=S selects the reproducible sensor sequence (default 1),
+ *          --threads=N steps the fleet on N threads (0 = all hardware threads),
+ *          --scaling measures 1..N threads and reports scaling efficiency
+ * @return Exit status code
+ */
+int main(int argc, char* argv[]) {
+    std::size_t vehicleCount = 100000;
+    std::uint64_t tickCount = 100;
+    unsigned int tickIntervalMilliseconds = 1000;
+    unsigned int pacedTickRateHz = 0;
+    int realtimeCpuIndex = -1;
+    std::uint64_t randomSeed = 1;
+    unsigned int workerThreadCount = 1;
+    bool isScalingReportRequested = false;
+
+    int positionalIndex = 0;
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        const char* argument = argv[argumentIndex];
+        if (std::strncmp(argument, "--rate-hz=", 10) == 0) {
+            pacedTickRateHz = static_cast<unsigned int>(std::strtoul(argument + 10, nullptr, 10));
+        } else if (std::strncmp(argument, "--realtime-cpu=", 15) == 0) {
+            realtimeCpuIndex = std::atoi(argument + 15);
+        } else if (std::strncmp(argument, "--seed=", 7) == 0) {
+            randomSeed = std::strtoull(argument + 7, nullptr, 10);
+        } else if (std::strncmp(argument, "--threads=", 10) == 0) {
+            workerThreadCount = static_cast<unsigned int>(std::strtoul(argument + 10, nullptr, 10));
+        } else if (std::strcmp(argument, "--scaling") == 0) {
+            isScalingReportRequested = true;
+        } else if (positionalIndex == 0) {
+            vehicleCount = static_cast<std::size_t>(std::strtoull(argument, nullptr, 10));
+            positionalIndex++;
+        } else if (positionalIndex == 1) {
+            tickCount = std::strtoull(argument, nullptr, 10);
+            positionalIndex++;
+        } else if (positionalIndex == 2) {
+            tickIntervalMilliseconds = static_cast<unsigned int>(std::strtoul(argument, nullptr, 10));
+            positionalIndex++;
+        }
+    }
+
+    if (vehicleCount == 0 || tickCount == 0 || tickIntervalMilliseconds == 0) {
+        std::cerr << "Usage: " << argv[0] << " [vehicleCount] [tickCount] [tickIntervalMilliseconds]"
+                  << " [--rate-hz=N] [--realtime-cpu=K] [--seed=S] [--threads=N] [--scaling]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Simulating " << vehicleCount << " vehicles for " << tickCount
+              << " ticks of " << tickIntervalMilliseconds << " ms..." << std::endl;
+
+    if (workerThreadCount == 0) {
+        workerThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (isScalingReportRequested) {
+        // Default to every hardware thread unless --threads picked a limit
+        unsigned int maxThreadCount = (workerThreadCount > 1) ? workerThreadCount : std::max(1u, std::thread::hardware_concurrency());
+        return reportScalingEfficiency(vehicleCount, tickCount, tickIntervalMilliseconds, randomSeed, maxThreadCount) ? 0 : 2;
+    }
+
+    FleetSimulationEngine fleetEngine(vehicleCount, tickIntervalMilliseconds, randomSeed);
+    fleetEngine.setWorkerThreadCount(workerThreadCount);
+
+    if (pacedTickRateHz > 0) {
+        // Paced mode: one fleet tick per scheduler deadline, then prove deadline adherence
+        if (realtimeCpuIndex >= 0 && !PeriodicScheduler::enableRealtimeScheduling(realtimeCpuIndex, 50)) {
+            std::cerr << "Realtime scheduling unavailable - continuing with default scheduling" << std::endl;
+        }
+        PeriodicScheduler tickScheduler(pacedTickRateHz);
+        tickScheduler.start();
+        for (std::uint64_t tickIndex = 0; tickIndex < tickCount; tickIndex++) {
+            tickScheduler.waitForNextTick();
+            fleetEngine.stepTick();
+        }
+        tickScheduler.printLatenessReport(std::cout);
+        return 0;
+    }
+
+    FleetSimulationEngine::FleetRunStatistics runStatistics = fleetEngine.runTicks(tickCount);
+
+    std::cout << "Elapsed: " << runStatistics.elapsedSeconds << " s" << std::endl;
+    std::cout << "Ticks/s: " << runStatistics.ticksPerSecond << std::endl;
+    std::cout << "Ticks/s per core: " << runStatistics.ticksPerSecondPerCore
+              << " (" << runStatistics.coresUsed << (runStatistics.coresUsed == 1 ? " core)" : " cores)") << std::endl;
+    std::cout << "Vehicle steps/s: " << runStatistics.vehicleStepsPerSecond << std::endl;
+
+    std::cout << "Wiper speeds after run:";
+    const WindshieldWiperSpeed reportedSpeeds[] = {
+        WindshieldWiperSpeed::OFF, WindshieldWiperSpeed::LOW, WindshieldWiperSpeed::MEDIUM, WindshieldWiperSpeed::HIGH
+    };
+    for (WindshieldWiperSpeed wiperSpeed : reportedSpeeds) {
+        std::cout << " " << convertWiperSpeedToString(wiperSpeed) << "=" << fleetEngine.countVehiclesAtSpeed(wiperSpeed);
+    }
+    std::cout << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "FleetSimulationEngine.h"
+#include <algorithm>
+#include <chrono>
+
+FleetSimulationEngine::FleetSimulationEngine(std::size_t vehicleCount, unsigned int tickIntervalMilliseconds, std::uint64_t randomSeed)
+    : vehicleSensors(),
+      lightPercentages(vehicleCount, 0.0),
+      validReadingFlags(vehicleCount, 0),
+      suddenRainBurstFlags(vehicleCount, 0),
+      speedThresholdTable(WiperSpeedThresholdTable::createDefaultTable()),
+      targetWiperSpeeds(vehicleCount, WindshieldWiperSpeed::OFF),
+      wiperSpeeds(vehicleCount, WindshieldWiperSpeed::OFF),
+      operatingModes(vehicleCount, OperatingMode::AUTOMATIC),
+      waterSprayModes(vehicleCount, WaterSprayMode::OFF),
+      waitingToTurnOffFlags(vehicleCount, 0),
+      countdownEvents(vehicleCount, TurnOffCountdownEvent::NONE),
+      turnOffDelayElapsedFlags(vehicleCount, 0),
+      currentTick(0),
+      tickIntervalMilliseconds(tickIntervalMilliseconds) {
+    // Counter-based sensors keep a few bytes of state each and make runs reproducible;
+    // the fleet only simulates rain, so dew is never generated
+    vehicleSensors.reserve(vehicleCount);
+    for (std::size_t vehicleIndex = 0; vehicleIndex < vehicleCount; vehicleIndex++) {
+        vehicleSensors.emplace_back(randomSeed, static_cast<std::uint64_t>(vehicleIndex));
+        vehicleSensors.back().subscribeChannels(RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_FAILURE);
+    }
+
+    // The countdown ends on the first tick at least TURN_OFF_DELAY_SECONDS after it started
+    // (with a zero interval simulated time never advances, so the countdown never ends)
+    std::uint64_t turnOffDelayMilliseconds = static_cast<std::uint64_t>(WindshieldWiperController::TURN_OFF_DELAY_SECONDS) * 1000;
+    turnOffDelayTicks = (tickIntervalMilliseconds > 0)
+        ? (turnOffDelayMilliseconds + tickIntervalMilliseconds - 1) / tickIntervalMilliseconds
+        : UINT64_MAX / 2;
+    
+    std::size_t shardCount = getShardCount();
+    for (std::size_t shardIndex = 0; shardIndex < shardCount; shardIndex++) {
+        std::size_t firstVehicleIndex = shardIndex * PARALLEL_SHARD_SIZE;
+        std::size_t endVehicleIndex = std::min(firstVehicleIndex + PARALLEL_SHARD_SIZE, vehicleCount);
+        shardTurnOffWheels.push_back(HierarchicalTimerWheel(static_cast<std::uint32_t>(endVehicleIndex - firstVehicleIndex)));
+    }
+    shardExpiredTimerIds.resize(shardCount);
+}
+
+void FleetSimulationEngine::setWorkerThreadCount(unsigned int threadCount) {
+    workerThreadPool.reset();
+    if (threadCount != 1) {
+        workerThreadPool.reset(new WorkStealingThreadPool(threadCount));
+    }
+}
+
+unsigned int FleetSimulationEngine::getWorkerThreadCount() const {
+    return workerThreadPool ? workerThreadPool->getThreadCount() : 1;
+}
+
+void FleetSimulationEngine::stepTick() {
+    // Shard boundaries depend only on the vehicle count, never on the thread count
+    std::size_t shardCount = getShardCount();
+    if (workerThreadPool) {
+        workerThreadPool->parallelFor(shardCount, [this](std::size_t shardIndex) {
+            stepShard(shardIndex);
+        });
+    } else {
+        for (std::size_t shardIndex = 0; shardIndex < shardCount; shardIndex++) {
+            stepShard(shardIndex);
+        }
+    }
+    currentTick++;
+}
+
+std::size_t FleetSimulationEngine::getShardCount() const {
+    return (getVehicleCount() + PARALLEL_SHARD_SIZE - 1) / PARALLEL_SHARD_SIZE;
+}
+
+void FleetSimulationEngine::stepShard(std::size_t shardIndex) {
+    std::size_t firstVehicleIndex = shardIndex * PARALLEL_SHARD_SIZE;
+    std::size_t endVehicleIndex = std::min(firstVehicleIndex + PARALLEL_SHARD_SIZE, getVehicleCount());
+    sampleSensors(firstVehicleIndex, endVehicleIndex);
+    applyAutomaticModeToVehicles(shardIndex, firstVehicleIndex, endVehicleIndex);
+}
+
+FleetSimulationEngine::FleetRunStatistics FleetSimulationEngine::runTicks(std::uint64_t tickCount) {
+    auto runStartTime = std::chrono::steady_clock::now();
+    for (std::uint64_t tickIndex = 0; tickIndex < tickCount; tickIndex++) {
+        stepTick();
+    }
+    auto runEndTime = std::chrono::steady_clock::now();
+
+    FleetRunStatistics runStatistics;
+    runStatistics.executedTicks = tickCount;
+    runStatistics.vehicleSteps = tickCount * static_cast<std::uint64_t>(getVehicleCount());
+    runStatistics.elapsedSeconds = std::chrono::duration<double>(runEndTime - runStartTime).count();
+    runStatistics.coresUsed = getWorkerThreadCount();
+
+    // Guard against runs too short for the clock to resolve
+    double measuredSeconds = (runStatistics.elapsedSeconds > 0.0) ? runStatistics.elapsedSeconds : 1e-9;
+    runStatistics.ticksPerSecond = static_cast<double>(runStatistics.executedTicks) / measuredSeconds;
+    runStatistics.vehicleStepsPerSecond = static_cast<double>(runStatistics.vehicleSteps) / measuredSeconds;
+    runStatistics.ticksPerSecondPerCore = runStatistics.ticksPerSecond / runStatistics.coresUsed;
+    return runStatistics;
+}
+
+std::size_t FleetSimulationEngine::getVehicleCount() const {
+    return vehicleSensors.size();
+}
+
+std::uint64_t FleetSimulationEngine::getCurrentTick() const {
+    return currentTick;
+}
+
+WindshieldWiperSpeed FleetSimulationEngine::getWiperSpeed(std::size_t vehicleIndex) const {
+    return wiperSpeeds[vehicleIndex];
+}
+
+bool FleetSimulationEngine::isWaitingToTurnOffWipers(std::size_t vehicleIndex) const {
+    return waitingToTurnOffFlags[vehicleIndex] != 0;
+}
+
+RainSensor::SensorReadingData FleetSimulationEngine::getLastSensorReading(std::size_t vehicleIndex) const {
+    RainSensor::SensorReadingData sensorData;
+    sensorData.lightPercentage = lightPercentages[vehicleIndex];
+    sensorData.isValidReading = validReadingFlags[vehicleIndex] != 0;
+    sensorData.isSuddenRainBurst = suddenRainBurstFlags[vehicleIndex] != 0;
+    sensorData.isDewPresent = false;
+    sensorData.dewLevel = 0.0;
+    return sensorData;
+}
+
+std::size_t FleetSimulationEngine::countVehiclesAtSpeed(WindshieldWiperSpeed wiperSpeed) const {
+    std::size_t vehicleCount = 0;
+    for (std::size_t vehicleIndex = 0; vehicleIndex < wiperSpeeds.size(); vehicleIndex++) {
+        if (wiperSpeeds[vehicleIndex] == wiperSpeed) {
+            vehicleCount++;
+        }
+    }
+    return vehicleCount;
+}
+
+std::uint64_t FleetSimulationEngine::computeStateChecksum() const {
+    const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    const std::uint64_t FNV_PRIME = 1099511628211ULL;
+    std::uint64_t stateChecksum = FNV_OFFSET_BASIS;
+    
+    auto hashBytes = [&stateChecksum, FNV_PRIME](const void* data, std::size_t byteCount) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t byteIndex = 0; byteIndex < byteCount; byteIndex++) {
+            stateChecksum = (stateChecksum ^ bytes[byteIndex]) * FNV_PRIME;
+        }
+    };
+    std::size_t vehicleCount = getVehicleCount();
+    hashBytes(lightPercentages.data(), vehicleCount * sizeof(double));
+    hashBytes(validReadingFlags.data(), vehicleCount);
+    hashBytes(suddenRainBurstFlags.data(), vehicleCount);
+    hashBytes(wiperSpeeds.data(), vehicleCount * sizeof(WindshieldWiperSpeed));
+    hashBytes(waitingToTurnOffFlags.data(), vehicleCount);
+    for (const HierarchicalTimerWheel& turnOffWheel : shardTurnOffWheels) {
+        std::uint64_t pendingCount = turnOffWheel.getScheduledCount();
+        hashBytes(&pendingCount, sizeof(pendingCount));
+    }
+    return stateChecksum;
+}
+
+std::size_t FleetSimulationEngine::getPendingTurnOffCount() const {
+    std::size_t pendingCount = 0;
+    for (const HierarchicalTimerWheel& turnOffWheel : shardTurnOffWheels) {
+        pendingCount += turnOffWheel.getScheduledCount();
+    }
+    return pendingCount;
+}
+
+void FleetSimulationEngine::sampleSensors(std::size_t firstVehicleIndex, std::size_t endVehicleIndex) {
+    for (std::size_t vehicleIndex = firstVehicleIndex; vehicleIndex < endVehicleIndex; vehicleIndex++) {
+        RainSensor::SensorReadingData sensorData = vehicleSensors[vehicleIndex].readSensorData();
+        lightPercentages[vehicleIndex] = sensorData.lightPercentage;
+        validReadingFlags[vehicleIndex] = sensorData.isValidReading ? 1 : 0;
+        suddenRainBurstFlags[vehicleIndex] = sensorData.isSuddenRainBurst ? 1 : 0;
+    }
+}
+
+void FleetSimulationEngine::applyAutomaticModeToVehicles(std::size_t shardIndex, std::size_t firstVehicleIndex, std::size_t endVehicleIndex) {
+    HierarchicalTimerWheel& turnOffWheel = shardTurnOffWheels[shardIndex];
+    std::vector<std::uint32_t>& expiredTimerIds = shardExpiredTimerIds[shardIndex];
+
+    // Only the countdowns due on this tick are visited
+    expiredTimerIds.clear();
+    turnOffWheel.advanceTo(currentTick, expiredTimerIds);
+    for (std::uint32_t timerId : expiredTimerIds) {
+        turnOffDelayElapsedFlags[firstVehicleIndex + timerId] = 1;
+    }
+
+    // Map every light reading in the range to its target speed in one SIMD pass
+    speedThresholdTable.mapLightPercentagesToWiperSpeeds(lightPercentages.data() + firstVehicleIndex,
+                                                         targetWiperSpeeds.data() + firstVehicleIndex,
+                                                         endVehicleIndex - firstVehicleIndex);
+
+    // Same decision rules as WindshieldWiperController::processAutomaticModeOperation, as one table lookup
+    // per vehicle (manual mode vehicles map to their unchanged state)
+    transitionTable.stepBatch(validReadingFlags.data() + firstVehicleIndex,
+                              suddenRainBurstFlags.data() + firstVehicleIndex,
+                              targetWiperSpeeds.data() + firstVehicleIndex,
+                              turnOffDelayElapsedFlags.data() + firstVehicleIndex,
+                              operatingModes.data() + firstVehicleIndex,
+                              wiperSpeeds.data() + firstVehicleIndex,
+                              waitingToTurnOffFlags.data() + firstVehicleIndex,
+                              countdownEvents.data() + firstVehicleIndex,
+                              endVehicleIndex - firstVehicleIndex);
+
+    for (std::size_t vehicleIndex = firstVehicleIndex; vehicleIndex < endVehicleIndex; vehicleIndex++) {
+        TurnOffCountdownEvent countdownEvent = countdownEvents[vehicleIndex];
+        if (countdownEvent == TurnOffCountdownEvent::NONE) {
+            continue;
+        }
+
+        std::uint32_t timerId = static_cast<std::uint32_t>(vehicleIndex - firstVehicleIndex);
+        if (countdownEvent == TurnOffCountdownEvent::STARTED) {
+            turnOffWheel.schedule(timerId, currentTick + turnOffDelayTicks);
+        } else if (countdownEvent == TurnOffCountdownEvent::CANCELLED) {
+            turnOffWheel.cancel(timerId);
+        }
+        // An elapsed countdown always ends (expired or cancelled) on the tick it is seen
+        turnOffDelayElapsedFlags[vehicleIndex] = 0;
+    }
+}
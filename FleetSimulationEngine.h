@@ -0,0 +1,196 @@
+#ifndef FLEET_SIMULATION_ENGINE_H
+#define FLEET_SIMULATION_ENGINE_H
+
+#include "RainSensor.h"
+#include "WindshieldWiperController.h"
+#include "WiperSpeedThresholdTable.h"
+#include "AutomaticModeTransitionTable.h"
+#include "WiperEnums.h"
+#include "WorkStealingThreadPool.h"
+#include "HierarchicalTimerWheel.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief FleetSimulationEngine class to step many sensor/controller pairs without a terminal
+ *
+ * Sensor readings and controller state are kept as structure-of-arrays so that each
+ * phase of a tick streams through one field at a time. Time is measured in ticks of a
+ * fixed simulated interval, so a run never waits on the wall clock.
+ *
+ * With more than one worker thread the vehicles are split into fixed shards that a
+ * work-stealing pool steps in parallel. Every vehicle only touches its own slots and
+ * its own sensor stream, so results are bit-identical for any thread count.
+ *
+ * Pending turn-off countdowns live in one hierarchical timer wheel per shard: a
+ * countdown is scheduled when it starts, cancelled when rain returns, and only the
+ * countdowns that expire on a tick are visited on that tick.
+ *
+ * The automatic mode rules are applied with AutomaticModeTransitionTable, a branch-free
+ * lookup per vehicle; only vehicles whose countdown changed are then visited to update
+ * the timer wheel.
+ */
+class FleetSimulationEngine {
+public:
+    /**
+     * @brief Structure to hold throughput figures for a batch of ticks
+     */
+    struct FleetRunStatistics {
+        std::uint64_t executedTicks;
+        std::uint64_t vehicleSteps;
+        double elapsedSeconds;
+        double ticksPerSecond;
+        double vehicleStepsPerSecond;
+        unsigned int coresUsed;
+        double ticksPerSecondPerCore;
+    };
+
+    /**
+     * @brief Constructor for FleetSimulationEngine
+     * @param vehicleCount Number of sensor/controller pairs to simulate
+     * @param tickIntervalMilliseconds Simulated time that passes on every tick
+     * @param randomSeed Seed for the counter-based sensors (vehicle index is the stream ID)
+     */
+    FleetSimulationEngine(std::size_t vehicleCount, unsigned int tickIntervalMilliseconds, std::uint64_t randomSeed = 1);
+
+    static const std::size_t PARALLEL_SHARD_SIZE = 4096; // Vehicles per parallel task
+
+    /**
+     * @brief Choose how many threads step the fleet
+     * @param threadCount Worker threads including the caller (1 = serial, 0 = one per hardware thread)
+     */
+    void setWorkerThreadCount(unsigned int threadCount);
+
+    /**
+     * @brief Get the number of threads stepping the fleet
+     * @return Worker thread count
+     */
+    unsigned int getWorkerThreadCount() const;
+
+    /**
+     * @brief Read every sensor and apply the automatic mode rules once
+     */
+    void stepTick();
+
+    /**
+     * @brief Run a number of ticks and measure throughput
+     * @param tickCount Number of ticks to execute
+     * @return Throughput figures for the run
+     */
+    FleetRunStatistics runTicks(std::uint64_t tickCount);
+
+    /**
+     * @brief Get the number of simulated vehicles
+     * @return Vehicle count
+     */
+    std::size_t getVehicleCount() const;
+
+    /**
+     * @brief Get the number of ticks executed so far
+     * @return Current tick index
+     */
+    std::uint64_t getCurrentTick() const;
+
+    /**
+     * @brief Get the wiper speed of one vehicle
+     * @param vehicleIndex Index of the vehicle
+     * @return Current wiper speed
+     */
+    WindshieldWiperSpeed getWiperSpeed(std::size_t vehicleIndex) const;
+
+    /**
+     * @brief Check if one vehicle is counting down to turn its wipers off
+     * @param vehicleIndex Index of the vehicle
+     * @return True if waiting to turn off, false otherwise
+     */
+    bool isWaitingToTurnOffWipers(std::size_t vehicleIndex) const;
+
+    /**
+     * @brief Get the most recent sensor reading of one vehicle
+     * @param vehicleIndex Index of the vehicle
+     * @return Last sensor reading (the fleet does not subscribe to dew, so dew fields are clear)
+     */
+    RainSensor::SensorReadingData getLastSensorReading(std::size_t vehicleIndex) const;
+
+    /**
+     * @brief Count how many vehicles currently run at a given speed
+     * @param wiperSpeed The wiper speed to count
+     * @return Number of vehicles at that speed
+     */
+    std::size_t countVehiclesAtSpeed(WindshieldWiperSpeed wiperSpeed) const;
+
+    /**
+     * @brief Hash the readings and controller state of every vehicle
+     * @return FNV-1a checksum, equal for runs that produced identical state
+     */
+    std::uint64_t computeStateChecksum() const;
+
+    /**
+     * @brief Count the turn-off countdowns currently pending in the timer wheels
+     * @return Pending countdown count
+     */
+    std::size_t getPendingTurnOffCount() const;
+
+private:
+    std::vector<RainSensor> vehicleSensors;
+
+    // Sensor readings, one array per subscribed SensorReadingData field (dew is not subscribed)
+    std::vector<double> lightPercentages;
+    std::vector<std::uint8_t> validReadingFlags;
+    std::vector<std::uint8_t> suddenRainBurstFlags;
+
+    // Target speeds mapped in batch from lightPercentages each tick
+    WiperSpeedThresholdTable speedThresholdTable;
+    std::vector<WindshieldWiperSpeed> targetWiperSpeeds;
+
+    // Controller state, one array per WindshieldWiperController field
+    std::vector<WindshieldWiperSpeed> wiperSpeeds;
+    std::vector<OperatingMode> operatingModes;
+    std::vector<WaterSprayMode> waterSprayModes;
+    std::vector<std::uint8_t> waitingToTurnOffFlags;
+
+    // Automatic mode rules as a lookup table, and the countdown change each vehicle made this tick
+    AutomaticModeTransitionTable transitionTable;
+    std::vector<TurnOffCountdownEvent> countdownEvents;
+
+    // Pending turn-off deadlines, one wheel per shard (timer ID = index within the shard)
+    std::vector<HierarchicalTimerWheel> shardTurnOffWheels;
+    std::vector<std::vector<std::uint32_t>> shardExpiredTimerIds; // Reused every tick
+    std::vector<std::uint8_t> turnOffDelayElapsedFlags;
+    std::uint64_t turnOffDelayTicks;
+
+    std::uint64_t currentTick;
+    unsigned int tickIntervalMilliseconds;
+    std::unique_ptr<WorkStealingThreadPool> workerThreadPool; // Null when stepping serially
+
+    /**
+     * @brief Get the number of parallel shards
+     * @return Shard count
+     */
+    std::size_t getShardCount() const;
+
+    /**
+     * @brief Read and process one shard of vehicles for the current tick
+     * @param shardIndex Shard to step
+     */
+    void stepShard(std::size_t shardIndex);
+
+    /**
+     * @brief Read a range of sensors into the reading arrays
+     * @param firstVehicleIndex First vehicle of the range
+     * @param endVehicleIndex One past the last vehicle of the range
+     */
+    void sampleSensors(std::size_t firstVehicleIndex, std::size_t endVehicleIndex);
+
+    /**
+     * @brief Fire due countdowns and apply the automatic mode rules to one shard
+     * @param shardIndex Shard to process
+     * @param firstVehicleIndex First vehicle of the shard
+     * @param endVehicleIndex One past the last vehicle of the shard
+     */
+    void applyAutomaticModeToVehicles(std::size_t shardIndex, std::size_t firstVehicleIndex, std::size_t endVehicleIndex);
+};
+
+#endif // FLEET_SIMULATION_ENGINE_H
@@ -0,0 +1,139 @@
+#include "HierarchicalTimerWheel.h"
+
+// Out-of-line definitions: the sentinels are bound to const references (e.g. by std::vector)
+const std::uint32_t HierarchicalTimerWheel::NO_TIMER;
+const std::uint16_t HierarchicalTimerWheel::NO_SLOT;
+
+HierarchicalTimerWheel::HierarchicalTimerWheel(std::uint32_t timerCapacity, std::uint64_t startTick)
+    : nextTimerIds(timerCapacity, NO_TIMER),
+      previousTimerIds(timerCapacity, NO_TIMER),
+      expiryTicks(timerCapacity, 0),
+      timerSlots(timerCapacity, NO_SLOT),
+      currentTick(startTick),
+      scheduledCount(0) {
+    for (std::uint32_t& slotHead : slotHeads) {
+        slotHead = NO_TIMER;
+    }
+}
+
+void HierarchicalTimerWheel::schedule(std::uint32_t timerId, std::uint64_t expiryTick) {
+    cancel(timerId);
+    expiryTicks[timerId] = (expiryTick > currentTick) ? expiryTick : currentTick + 1;
+    linkIntoSlot(timerId);
+    scheduledCount++;
+}
+
+void HierarchicalTimerWheel::cancel(std::uint32_t timerId) {
+    if (timerSlots[timerId] == NO_SLOT) {
+        return;
+    }
+    unlinkFromSlot(timerId);
+    scheduledCount--;
+}
+
+bool HierarchicalTimerWheel::isScheduled(std::uint32_t timerId) const {
+    return timerSlots[timerId] != NO_SLOT;
+}
+
+std::uint64_t HierarchicalTimerWheel::getExpiryTick(std::uint32_t timerId) const {
+    return expiryTicks[timerId];
+}
+
+std::uint64_t HierarchicalTimerWheel::getCurrentTick() const {
+    return currentTick;
+}
+
+std::size_t HierarchicalTimerWheel::getScheduledCount() const {
+    return scheduledCount;
+}
+
+void HierarchicalTimerWheel::advanceTo(std::uint64_t targetTick, std::vector<std::uint32_t>& expiredTimerIds) {
+    while (currentTick < targetTick) {
+        if (scheduledCount == 0) {
+            // Nothing can fire or cascade, so jump straight to the target
+            currentTick = targetTick;
+            return;
+        }
+        currentTick++;
+
+        // At each level-0 wrap, pull the now-due slot of the next level down (and so on upwards)
+        if ((currentTick & (SLOTS_PER_LEVEL - 1)) == 0) {
+            for (unsigned int levelIndex = 1; levelIndex < LEVEL_COUNT; levelIndex++) {
+                unsigned int levelSlot = static_cast<unsigned int>((currentTick >> (SLOT_BITS * levelIndex)) & (SLOTS_PER_LEVEL - 1));
+                std::uint32_t timerId = detachSlot(static_cast<std::uint16_t>(levelIndex * SLOTS_PER_LEVEL + levelSlot));
+                while (timerId != NO_TIMER) {
+                    std::uint32_t nextTimerId = nextTimerIds[timerId];
+                    linkIntoSlot(timerId);
+                    timerId = nextTimerId;
+                }
+                if (levelSlot != 0) {
+                    break;
+                }
+            }
+        }
+
+        std::uint32_t timerId = detachSlot(static_cast<std::uint16_t>(currentTick & (SLOTS_PER_LEVEL - 1)));
+        while (timerId != NO_TIMER) {
+            std::uint32_t nextTimerId = nextTimerIds[timerId];
+            if (expiryTicks[timerId] <= currentTick) {
+                scheduledCount--;
+                expiredTimerIds.push_back(timerId);
+            } else {
+                // Parked beyond the wheel's range - place it again from here
+                linkIntoSlot(timerId);
+            }
+            timerId = nextTimerId;
+        }
+    }
+}
+
+std::uint16_t HierarchicalTimerWheel::selectSlot(std::uint64_t expiryTick) const {
+    std::uint64_t ticksUntilExpiry = expiryTick - currentTick;
+    for (unsigned int levelIndex = 0; levelIndex < LEVEL_COUNT; levelIndex++) {
+        if (ticksUntilExpiry < (1ULL << (SLOT_BITS * (levelIndex + 1)))) {
+            unsigned int levelSlot = static_cast<unsigned int>((expiryTick >> (SLOT_BITS * levelIndex)) & (SLOTS_PER_LEVEL - 1));
+            return static_cast<std::uint16_t>(levelIndex * SLOTS_PER_LEVEL + levelSlot);
+        }
+    }
+
+    // Beyond the top level's span: park at its furthest slot and re-place when it cascades
+    std::uint64_t parkedTick = currentTick + (1ULL << (SLOT_BITS * LEVEL_COUNT)) - 1;
+    unsigned int levelSlot = static_cast<unsigned int>((parkedTick >> (SLOT_BITS * (LEVEL_COUNT - 1))) & (SLOTS_PER_LEVEL - 1));
+    return static_cast<std::uint16_t>((LEVEL_COUNT - 1) * SLOTS_PER_LEVEL + levelSlot);
+}
+
+void HierarchicalTimerWheel::linkIntoSlot(std::uint32_t timerId) {
+    std::uint16_t slotIndex = selectSlot(expiryTicks[timerId]);
+    std::uint32_t headTimerId = slotHeads[slotIndex];
+    nextTimerIds[timerId] = headTimerId;
+    previousTimerIds[timerId] = NO_TIMER;
+    if (headTimerId != NO_TIMER) {
+        previousTimerIds[headTimerId] = timerId;
+    }
+    slotHeads[slotIndex] = timerId;
+    timerSlots[timerId] = slotIndex;
+}
+
+void HierarchicalTimerWheel::unlinkFromSlot(std::uint32_t timerId) {
+    std::uint32_t nextTimerId = nextTimerIds[timerId];
+    std::uint32_t previousTimerId = previousTimerIds[timerId];
+    if (previousTimerId != NO_TIMER) {
+        nextTimerIds[previousTimerId] = nextTimerId;
+    } else {
+        slotHeads[timerSlots[timerId]] = nextTimerId;
+    }
+    if (nextTimerId != NO_TIMER) {
+        previousTimerIds[nextTimerId] = previousTimerId;
+    }
+    timerSlots[timerId] = NO_SLOT;
+}
+
+std::uint32_t HierarchicalTimerWheel::detachSlot(std::uint16_t slotIndex) {
+    std::uint32_t firstTimerId = slotHeads[slotIndex];
+    slotHeads[slotIndex] = NO_TIMER;
+    // Detached timers are owned by the caller until relinked or fired
+    for (std::uint32_t timerId = firstTimerId; timerId != NO_TIMER; timerId = nextTimerIds[timerId]) {
+        timerSlots[timerId] = NO_SLOT;
+    }
+    return firstTimerId;
+}
@@ -0,0 +1,117 @@
+#ifndef HIERARCHICAL_TIMER_WHEEL_H
+#define HIERARCHICAL_TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief HierarchicalTimerWheel class to track many tick deadlines with O(1) insert and cancel
+ *
+ * Timers are identified by a dense index (e.g. vehicle index) and linked into intrusive
+ * doubly-linked slot lists, so scheduling or cancelling never searches or allocates.
+ * Level 0 has one slot per tick for the next 64 ticks; each higher level covers 64
+ * times the span of the one below and is cascaded down when its slot comes due.
+ * Advancing one tick only touches the slots that are due, however many timers are pending.
+ */
+class HierarchicalTimerWheel {
+public:
+    static const unsigned int LEVEL_COUNT = 4;
+    static const unsigned int SLOT_BITS = 6;
+    static const unsigned int SLOTS_PER_LEVEL = 1u << SLOT_BITS;
+    static const std::uint32_t NO_TIMER = 0xFFFFFFFFu;
+
+    /**
+     * @brief Constructor for HierarchicalTimerWheel
+     * @param timerCapacity Number of timer IDs (0 .. timerCapacity-1)
+     * @param startTick Tick the wheel starts at
+     */
+    explicit HierarchicalTimerWheel(std::uint32_t timerCapacity = 0, std::uint64_t startTick = 0);
+
+    /**
+     * @brief Schedule (or reschedule) a timer
+     * @param timerId Timer to schedule
+     * @param expiryTick Tick at which the timer fires (past ticks fire on the next advance)
+     */
+    void schedule(std::uint32_t timerId, std::uint64_t expiryTick);
+
+    /**
+     * @brief Cancel a timer (no effect if it is not scheduled)
+     * @param timerId Timer to cancel
+     */
+    void cancel(std::uint32_t timerId);
+
+    /**
+     * @brief Check if a timer is pending
+     * @param timerId Timer to check
+     * @return True if scheduled and not yet fired
+     */
+    bool isScheduled(std::uint32_t timerId) const;
+
+    /**
+     * @brief Get the tick a pending timer fires at
+     * @param timerId Timer to check
+     * @return Expiry tick
+     */
+    std::uint64_t getExpiryTick(std::uint32_t timerId) const;
+
+    /**
+     * @brief Get the last tick the wheel advanced to
+     * @return Current tick
+     */
+    std::uint64_t getCurrentTick() const;
+
+    /**
+     * @brief Get the number of pending timers
+     * @return Scheduled timer count
+     */
+    std::size_t getScheduledCount() const;
+
+    /**
+     * @brief Advance the wheel and collect the timers that fire
+     * @param targetTick Tick to advance to
+     * @param expiredTimerIds Receives the IDs of fired timers (appended)
+     */
+    void advanceTo(std::uint64_t targetTick, std::vector<std::uint32_t>& expiredTimerIds);
+
+private:
+    static const std::uint16_t NO_SLOT = 0xFFFF;
+
+    // Per-timer state, one array per field
+    std::vector<std::uint32_t> nextTimerIds;
+    std::vector<std::uint32_t> previousTimerIds;
+    std::vector<std::uint64_t> expiryTicks;
+    std::vector<std::uint16_t> timerSlots;
+
+    std::uint32_t slotHeads[LEVEL_COUNT * SLOTS_PER_LEVEL];
+    std::uint64_t currentTick;
+    std::size_t scheduledCount;
+
+    /**
+     * @brief Choose the slot for a timer relative to the current tick
+     * @param expiryTick Expiry tick (not before the current tick)
+     * @return Slot index (level * SLOTS_PER_LEVEL + slot)
+     */
+    std::uint16_t selectSlot(std::uint64_t expiryTick) const;
+
+    /**
+     * @brief Link a timer at the head of its slot list
+     * @param timerId Timer to link
+     */
+    void linkIntoSlot(std::uint32_t timerId);
+
+    /**
+     * @brief Remove a timer from its slot list
+     * @param timerId Timer to unlink
+     */
+    void unlinkFromSlot(std::uint32_t timerId);
+
+    /**
+     * @brief Detach a slot list so it can be redistributed or fired
+     * @param slotIndex Slot to detach
+     * @return First timer of the detached list, or NO_TIMER
+     */
+    std::uint32_t detachSlot(std::uint16_t slotIndex);
+};
+
+#endif // HIERARCHICAL_TIMER_WHEEL_H
@@ -0,0 +1,140 @@
+#include "LatencyTracer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Structure for one thread's span ring (written only by its owner thread)
+ */
+struct TraceThreadBuffer {
+    std::vector<TraceSpanRecord> spanRing;
+    std::atomic<std::uint64_t> writtenSpanCount;
+    std::uint64_t clearedSpanCount;
+    unsigned int threadIndex;
+
+    explicit TraceThreadBuffer(unsigned int threadIndex)
+        : spanRing(LatencyTracer::SPANS_PER_THREAD), writtenSpanCount(0), clearedSpanCount(0), threadIndex(threadIndex) {}
+};
+
+/**
+ * @brief Structure for every thread buffer ever created (kept after threads exit)
+ */
+struct TraceBufferRegistry {
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<TraceThreadBuffer>> threadBuffers;
+};
+
+const std::size_t LatencyTracer::SPANS_PER_THREAD;
+
+/**
+ * @brief Get the process-wide buffer registry
+ * @return Registry constructed on first use
+ */
+static TraceBufferRegistry& getTraceBufferRegistry() {
+    static TraceBufferRegistry traceBufferRegistry;
+    return traceBufferRegistry;
+}
+
+static const std::chrono::steady_clock::time_point tracerEpoch = std::chrono::steady_clock::now();
+static thread_local TraceThreadBuffer* currentThreadBuffer = nullptr;
+
+/**
+ * @brief Get the calling thread's buffer, registering it on first use
+ * @return The thread's span ring
+ */
+static TraceThreadBuffer& getCurrentThreadBuffer() {
+    if (currentThreadBuffer == nullptr) {
+        TraceBufferRegistry& traceBufferRegistry = getTraceBufferRegistry();
+        std::lock_guard<std::mutex> registryLock(traceBufferRegistry.registryMutex);
+        unsigned int threadIndex = static_cast<unsigned int>(traceBufferRegistry.threadBuffers.size());
+        traceBufferRegistry.threadBuffers.push_back(std::unique_ptr<TraceThreadBuffer>(new TraceThreadBuffer(threadIndex)));
+        currentThreadBuffer = traceBufferRegistry.threadBuffers.back().get();
+    }
+    return *currentThreadBuffer;
+}
+
+/**
+ * @brief Get the range of spans a buffer still holds
+ * @param threadBuffer Buffer to inspect
+ * @param firstSpanCount Receives the sequence number of the oldest retained span
+ * @return Sequence number one past the newest span
+ */
+static std::uint64_t getRetainedSpanRange(const TraceThreadBuffer& threadBuffer, std::uint64_t& firstSpanCount) {
+    std::uint64_t writtenSpanCount = threadBuffer.writtenSpanCount.load(std::memory_order_acquire);
+    firstSpanCount = (writtenSpanCount > LatencyTracer::SPANS_PER_THREAD) ? writtenSpanCount - LatencyTracer::SPANS_PER_THREAD : 0;
+    if (firstSpanCount < threadBuffer.clearedSpanCount) {
+        firstSpanCount = threadBuffer.clearedSpanCount;
+    }
+    return writtenSpanCount;
+}
+
+bool LatencyTracer::isCompiledIn() {
+    #ifdef WIPER_ENABLE_TRACING
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+std::uint64_t LatencyTracer::getTimestampNanoseconds() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - tracerEpoch).count());
+}
+
+void LatencyTracer::recordSpan(const char* spanName, std::uint64_t startNanoseconds, std::uint64_t endNanoseconds) {
+    TraceThreadBuffer& threadBuffer = getCurrentThreadBuffer();
+    std::uint64_t writtenSpanCount = threadBuffer.writtenSpanCount.load(std::memory_order_relaxed);
+    TraceSpanRecord& spanRecord = threadBuffer.spanRing[writtenSpanCount & (SPANS_PER_THREAD - 1)];
+    spanRecord.spanName = spanName;
+    spanRecord.startNanoseconds = startNanoseconds;
+    spanRecord.durationNanoseconds = endNanoseconds - startNanoseconds;
+    threadBuffer.writtenSpanCount.store(writtenSpanCount + 1, std::memory_order_release);
+}
+
+std::size_t LatencyTracer::getRecordedSpanCount() {
+    TraceBufferRegistry& traceBufferRegistry = getTraceBufferRegistry();
+    std::lock_guard<std::mutex> registryLock(traceBufferRegistry.registryMutex);
+    std::size_t recordedSpanCount = 0;
+    for (const std::unique_ptr<TraceThreadBuffer>& threadBuffer : traceBufferRegistry.threadBuffers) {
+        std::uint64_t firstSpanCount = 0;
+        recordedSpanCount += static_cast<std::size_t>(getRetainedSpanRange(*threadBuffer, firstSpanCount) - firstSpanCount);
+    }
+    return recordedSpanCount;
+}
+
+bool LatencyTracer::writeChromeTrace(const std::string& traceFilePath) {
+    std::FILE* traceFile = std::fopen(traceFilePath.c_str(), "w");
+    if (traceFile == nullptr) {
+        return false;
+    }
+
+    // Complete ("X") events in microseconds; one tid per traced thread
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", traceFile);
+    bool isFirstEvent = true;
+    TraceBufferRegistry& traceBufferRegistry = getTraceBufferRegistry();
+    std::lock_guard<std::mutex> registryLock(traceBufferRegistry.registryMutex);
+    for (const std::unique_ptr<TraceThreadBuffer>& threadBuffer : traceBufferRegistry.threadBuffers) {
+        std::uint64_t firstSpanCount = 0;
+        std::uint64_t endSpanCount = getRetainedSpanRange(*threadBuffer, firstSpanCount);
+        for (std::uint64_t spanCount = firstSpanCount; spanCount < endSpanCount; spanCount++) {
+            const TraceSpanRecord& spanRecord = threadBuffer->spanRing[spanCount & (SPANS_PER_THREAD - 1)];
+            std::fprintf(traceFile, "%s\n{\"name\":\"%s\",\"cat\":\"wiper\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         isFirstEvent ? "" : ",", spanRecord.spanName, threadBuffer->threadIndex,
+                         spanRecord.startNanoseconds / 1000.0, spanRecord.durationNanoseconds / 1000.0);
+            isFirstEvent = false;
+        }
+    }
+    std::fputs("\n]}\n", traceFile);
+    return std::fclose(traceFile) == 0;
+}
+
+void LatencyTracer::clear() {
+    TraceBufferRegistry& traceBufferRegistry = getTraceBufferRegistry();
+    std::lock_guard<std::mutex> registryLock(traceBufferRegistry.registryMutex);
+    for (const std::unique_ptr<TraceThreadBuffer>& threadBuffer : traceBufferRegistry.threadBuffers) {
+        threadBuffer->clearedSpanCount = threadBuffer->writtenSpanCount.load(std::memory_order_acquire);
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef LATENCY_TRACER_H
+#define LATENCY_TRACER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Structure for one completed span (name must be a string literal)
+ */
+struct TraceSpanRecord {
+    const char* spanName;
+    std::uint64_t startNanoseconds;
+    std::uint64_t durationNanoseconds;
+};
+
+/**
+ * @brief LatencyTracer class to collect timed spans and export them as a Chrome trace
+ *
+ * Each thread appends spans to its own fixed ring buffer, allocated on its first span,
+ * so recording takes no lock and never allocates afterwards. When a ring is full the
+ * oldest spans are overwritten. Export while the traced threads are idle and load the
+ * file in chrome://tracing or Perfetto.
+ *
+ * Instrumentation uses WIPER_TRACE_SCOPE, which compiles to nothing unless the build
+ * defines WIPER_ENABLE_TRACING.
+ */
+class LatencyTracer {
+public:
+    static const std::size_t SPANS_PER_THREAD = 65536; // Must be a power of two
+
+    /**
+     * @brief Check if WIPER_TRACE_SCOPE instrumentation is compiled in
+     * @return True if built with WIPER_ENABLE_TRACING
+     */
+    static bool isCompiledIn();
+
+    /**
+     * @brief Get the tracer clock
+     * @return Nanoseconds on steady_clock since the tracer was loaded
+     */
+    static std::uint64_t getTimestampNanoseconds();
+
+    /**
+     * @brief Append a completed span to the calling thread's buffer
+     * @param spanName Static name of the span
+     * @param startNanoseconds Start time from getTimestampNanoseconds()
+     * @param endNanoseconds End time from getTimestampNanoseconds()
+     */
+    static void recordSpan(const char* spanName, std::uint64_t startNanoseconds, std::uint64_t endNanoseconds);
+
+    /**
+     * @brief Get the number of spans currently held across all threads
+     * @return Retained span count
+     */
+    static std::size_t getRecordedSpanCount();
+
+    /**
+     * @brief Write every retained span as Chrome trace-event JSON
+     * @param traceFilePath Path of the JSON file to create
+     * @return True if the file was written
+     */
+    static bool writeChromeTrace(const std::string& traceFilePath);
+
+    /**
+     * @brief Discard every retained span (thread buffers are kept)
+     */
+    static void clear();
+};
+
+/**
+ * @brief ScopedTraceSpan class to time the enclosing scope as one span
+ */
+class ScopedTraceSpan {
+public:
+    /**
+     * @brief Constructor that starts the span
+     * @param spanName Static name of the span
+     */
+    explicit ScopedTraceSpan(const char* spanName)
+        : spanName(spanName), startNanoseconds(LatencyTracer::getTimestampNanoseconds()) {
+    }
+
+    /**
+     * @brief Destructor that records the span
+     */
+    ~ScopedTraceSpan() {
+        LatencyTracer::recordSpan(spanName, startNanoseconds, LatencyTracer::getTimestampNanoseconds());
+    }
+
+private:
+    ScopedTraceSpan(const ScopedTraceSpan&);
+    ScopedTraceSpan& operator=(const ScopedTraceSpan&);
+
+    const char* spanName;
+    std::uint64_t startNanoseconds;
+};
+
+#define WIPER_TRACE_CONCATENATE_INNER(prefix, line) prefix##line
+#define WIPER_TRACE_CONCATENATE(prefix, line) WIPER_TRACE_CONCATENATE_INNER(prefix, line)
+
+#ifdef WIPER_ENABLE_TRACING
+#define WIPER_TRACE_SCOPE(spanName) ScopedTraceSpan WIPER_TRACE_CONCATENATE(scopedTraceSpan, __LINE__)(spanName)
+#else
+#define WIPER_TRACE_SCOPE(spanName) ((void)0)
+#endif
+
+#endif // LATENCY_TRACER_H
@@ -0,0 +1,265 @@
+#include "MetricsHttpEndpoint.h"
+#include <cstring>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const int ACCEPT_POLL_INTERVAL_MILLISECONDS = 100; // How quickly close() is noticed
+const int CLIENT_TIMEOUT_MILLISECONDS = 1000;
+const std::size_t MAX_REQUEST_BYTES = 4096;
+
+// Fixed histogram bucket bounds, so rates can be aggregated across scrapes
+const double LATENCY_BUCKET_BOUNDS_SECONDS[] = {
+    1e-6, 2.5e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+    1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 1e-1, 2.5e-1, 5e-1, 1.0
+};
+
+const char* const WIPER_SPEED_LABELS[MetricsSnapshot::WIPER_SPEED_COUNT] = {"off", "low", "medium", "high"};
+
+/**
+ * @brief Write the HELP and TYPE lines of a metric family
+ * @param outputStream Stream to write to
+ * @param metricName Metric family name
+ * @param metricType Prometheus type (counter, gauge, histogram)
+ * @param helpText One-line description
+ */
+void writeMetricHeader(std::ostream& outputStream, const char* metricName, const char* metricType, const char* helpText) {
+    outputStream << "# HELP " << metricName << " " << helpText << "\n";
+    outputStream << "# TYPE " << metricName << " " << metricType << "\n";
+}
+
+/**
+ * @brief Write a single-sample counter family
+ * @param outputStream Stream to write to
+ * @param metricName Metric family name
+ * @param helpText One-line description
+ * @param counterValue Current value
+ */
+void writeCounter(std::ostream& outputStream, const char* metricName, const char* helpText, std::uint64_t counterValue) {
+    writeMetricHeader(outputStream, metricName, "counter", helpText);
+    outputStream << metricName << " " << counterValue << "\n";
+}
+
+#if !defined(_WIN32)
+/**
+ * @brief Send a whole buffer, retrying short writes
+ * @param clientSocket Connected socket
+ * @param responseText Bytes to send
+ * @return True if everything was sent
+ */
+bool sendAll(int clientSocket, const std::string& responseText) {
+    int sendFlags = 0;
+#if defined(MSG_NOSIGNAL)
+    sendFlags = MSG_NOSIGNAL; // A scraper hanging up must not kill the process with SIGPIPE
+#endif
+    std::size_t sentBytes = 0;
+    while (sentBytes < responseText.size()) {
+        ssize_t chunkBytes = send(clientSocket, responseText.data() + sentBytes, responseText.size() - sentBytes, sendFlags);
+        if (chunkBytes <= 0) {
+            return false;
+        }
+        sentBytes += static_cast<std::size_t>(chunkBytes);
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+MetricsHttpEndpoint::MetricsHttpEndpoint()
+    : listeningSocket(-1),
+      boundPort(0),
+      isListenerRunning(false),
+      servedRequestCount(0) {
+}
+
+MetricsHttpEndpoint::~MetricsHttpEndpoint() {
+    close();
+}
+
+bool MetricsHttpEndpoint::open(unsigned short listenPort, const SnapshotProvider& snapshotProvider) {
+    close();
+#if !defined(_WIN32)
+    int newSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (newSocket < 0) {
+        return false;
+    }
+    int reuseAddress = 1;
+    setsockopt(newSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+
+    // Loopback only - the endpoint is for a local agent, not the network
+    struct sockaddr_in listenAddress;
+    std::memset(&listenAddress, 0, sizeof(listenAddress));
+    listenAddress.sin_family = AF_INET;
+    listenAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    listenAddress.sin_port = htons(listenPort);
+    socklen_t addressLength = sizeof(listenAddress);
+    if (bind(newSocket, reinterpret_cast<struct sockaddr*>(&listenAddress), sizeof(listenAddress)) != 0 ||
+        listen(newSocket, 8) != 0 ||
+        getsockname(newSocket, reinterpret_cast<struct sockaddr*>(&listenAddress), &addressLength) != 0) {
+        ::close(newSocket);
+        return false;
+    }
+
+    listeningSocket = newSocket;
+    boundPort = ntohs(listenAddress.sin_port);
+    provideSnapshot = snapshotProvider;
+    isListenerRunning.store(true);
+    listenerThread = std::thread(&MetricsHttpEndpoint::runListenerThread, this);
+    return true;
+#else
+    (void)listenPort;
+    (void)snapshotProvider;
+    return false;
+#endif
+}
+
+void MetricsHttpEndpoint::close() {
+    if (!isListenerRunning.exchange(false)) {
+        return;
+    }
+    listenerThread.join();
+#if !defined(_WIN32)
+    ::close(listeningSocket);
+#endif
+    listeningSocket = -1;
+    boundPort = 0;
+}
+
+bool MetricsHttpEndpoint::isOpen() const {
+    return isListenerRunning.load();
+}
+
+unsigned short MetricsHttpEndpoint::getListenPort() const {
+    return boundPort;
+}
+
+std::uint64_t MetricsHttpEndpoint::getServedRequestCount() const {
+    return servedRequestCount.load(std::memory_order_relaxed);
+}
+
+void MetricsHttpEndpoint::runListenerThread() {
+#if !defined(_WIN32)
+    while (isListenerRunning.load()) {
+        struct pollfd listenPoll;
+        listenPoll.fd = listeningSocket;
+        listenPoll.events = POLLIN;
+        listenPoll.revents = 0;
+        if (poll(&listenPoll, 1, ACCEPT_POLL_INTERVAL_MILLISECONDS) <= 0) {
+            continue;
+        }
+
+        int clientSocket = accept(listeningSocket, nullptr, nullptr);
+        if (clientSocket < 0) {
+            continue;
+        }
+        struct timeval clientTimeout;
+        clientTimeout.tv_sec = CLIENT_TIMEOUT_MILLISECONDS / 1000;
+        clientTimeout.tv_usec = (CLIENT_TIMEOUT_MILLISECONDS % 1000) * 1000;
+        setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &clientTimeout, sizeof(clientTimeout));
+        setsockopt(clientSocket, SOL_SOCKET, SO_SNDTIMEO, &clientTimeout, sizeof(clientTimeout));
+        serveConnection(clientSocket);
+        ::close(clientSocket);
+    }
+#endif
+}
+
+void MetricsHttpEndpoint::serveConnection(int clientSocket) {
+#if !defined(_WIN32)
+    // Only the request line matters, but read the headers so the client sees a clean close
+    std::string requestText;
+    char receiveBuffer[1024];
+    while (requestText.size() < MAX_REQUEST_BYTES && requestText.find("\r\n\r\n") == std::string::npos) {
+        ssize_t receivedBytes = recv(clientSocket, receiveBuffer, sizeof(receiveBuffer), 0);
+        if (receivedBytes <= 0) {
+            break;
+        }
+        requestText.append(receiveBuffer, static_cast<std::size_t>(receivedBytes));
+    }
+
+    std::string statusLine;
+    std::string responseBody;
+    std::string contentType = "text/plain; charset=utf-8";
+    if (requestText.compare(0, 13, "GET /metrics ") == 0 || requestText.compare(0, 13, "GET /metrics?") == 0) {
+        statusLine = "200 OK";
+        responseBody = formatPrometheusText(provideSnapshot());
+        contentType = "text/plain; version=0.0.4; charset=utf-8";
+    } else if (requestText.compare(0, 4, "GET ") == 0) {
+        statusLine = "404 Not Found";
+        responseBody = "Metrics are served at /metrics\n";
+    } else {
+        statusLine = "405 Method Not Allowed";
+        responseBody = "Only GET is supported\n";
+    }
+
+    std::ostringstream responseStream;
+    responseStream << "HTTP/1.1 " << statusLine << "\r\n"
+                   << "Content-Type: " << contentType << "\r\n"
+                   << "Content-Length: " << responseBody.size() << "\r\n"
+                   << "Connection: close\r\n\r\n"
+                   << responseBody;
+    if (sendAll(clientSocket, responseStream.str())) {
+        servedRequestCount.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    (void)clientSocket;
+#endif
+}
+
+std::string MetricsHttpEndpoint::formatPrometheusText(const MetricsSnapshot& metricsSnapshot) {
+    std::ostringstream metricsText;
+    metricsText.precision(9);
+
+    writeCounter(metricsText, "wiper_control_ticks_total", "Control ticks run.", metricsSnapshot.controlTickCount);
+    writeCounter(metricsText, "wiper_rain_bursts_total", "Sudden rain bursts reported by the sensor.", metricsSnapshot.rainBurstCount);
+    writeCounter(metricsText, "wiper_sensor_failures_total", "Invalid sensor readings.", metricsSnapshot.sensorFailureCount);
+    writeCounter(metricsText, "wiper_speed_transitions_total", "Wiper speed changes.", metricsSnapshot.wiperSpeedTransitionCount);
+
+    writeMetricHeader(metricsText, "wiper_turn_off_countdowns_total", "counter", "Turn-off countdown changes by event.");
+    metricsText << "wiper_turn_off_countdowns_total{event=\"started\"} " << metricsSnapshot.turnOffCountdownStartCount << "\n";
+    metricsText << "wiper_turn_off_countdowns_total{event=\"cancelled\"} " << metricsSnapshot.turnOffCountdownCancelCount << "\n";
+    metricsText << "wiper_turn_off_countdowns_total{event=\"expired\"} " << metricsSnapshot.turnOffCountdownExpiryCount << "\n";
+
+    writeMetricHeader(metricsText, "wiper_speed_dwell_seconds_total", "counter", "Time spent at each wiper speed.");
+    for (std::size_t speedIndex = 0; speedIndex < MetricsSnapshot::WIPER_SPEED_COUNT; speedIndex++) {
+        metricsText << "wiper_speed_dwell_seconds_total{speed=\"" << WIPER_SPEED_LABELS[speedIndex] << "\"} "
+                    << (static_cast<double>(metricsSnapshot.speedDwellNanoseconds[speedIndex]) / 1e9) << "\n";
+    }
+
+    // The HDR buckets are folded into the fixed bounds; each lands within its ~3% precision
+    const HistogramSnapshot& tickLatency = metricsSnapshot.controlTickLatency;
+    writeMetricHeader(metricsText, "wiper_control_tick_duration_seconds", "histogram", "Control tick latency.");
+    std::size_t hdrBucketIndex = 0;
+    std::uint64_t cumulativeCount = 0;
+    for (std::size_t boundIndex = 0; boundIndex < sizeof(LATENCY_BUCKET_BOUNDS_SECONDS) / sizeof(LATENCY_BUCKET_BOUNDS_SECONDS[0]); boundIndex++) {
+        double boundNanoseconds = LATENCY_BUCKET_BOUNDS_SECONDS[boundIndex] * 1e9;
+        while (hdrBucketIndex < tickLatency.bucketCounts.size() &&
+               static_cast<double>(LatencyHistogram::getBucketUpperBound(hdrBucketIndex)) <= boundNanoseconds) {
+            cumulativeCount += tickLatency.bucketCounts[hdrBucketIndex];
+            hdrBucketIndex++;
+        }
+        metricsText << "wiper_control_tick_duration_seconds_bucket{le=\"" << LATENCY_BUCKET_BOUNDS_SECONDS[boundIndex] << "\"} "
+                    << cumulativeCount << "\n";
+    }
+    metricsText << "wiper_control_tick_duration_seconds_bucket{le=\"+Inf\"} " << tickLatency.sampleCount << "\n";
+    metricsText << "wiper_control_tick_duration_seconds_sum " << (static_cast<double>(tickLatency.valueSum) / 1e9) << "\n";
+    metricsText << "wiper_control_tick_duration_seconds_count " << tickLatency.sampleCount << "\n";
+
+    writeMetricHeader(metricsText, "wiper_control_tick_duration_quantile_seconds", "gauge", "Control tick latency percentiles since start.");
+    const double reportedQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+    for (std::size_t quantileIndex = 0; quantileIndex < sizeof(reportedQuantiles) / sizeof(reportedQuantiles[0]); quantileIndex++) {
+        metricsText << "wiper_control_tick_duration_quantile_seconds{quantile=\"" << reportedQuantiles[quantileIndex] << "\"} "
+                    << (static_cast<double>(tickLatency.getValueAtPercentile(reportedQuantiles[quantileIndex] * 100.0)) / 1e9) << "\n";
+    }
+
+    return metricsText.str();
+}
@@ -0,0 +1,96 @@
+#ifndef METRICS_HTTP_ENDPOINT_H
+#define METRICS_HTTP_ENDPOINT_H
+
+#include "MetricsRegistry.h"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+/**
+ * @brief MetricsHttpEndpoint class to serve metrics to Prometheus scrapers on localhost
+ *
+ * A background thread accepts connections on 127.0.0.1 and answers GET /metrics with
+ * a fresh snapshot in the Prometheus text exposition format. The snapshot is taken on
+ * that thread from relaxed atomics, so a scrape never takes a lock the control loop
+ * holds or delays a control tick. Connections are served one at a time with short
+ * socket timeouts, so a stalled client can only hold up other scrapes.
+ *
+ * Needs POSIX sockets; open() returns false elsewhere.
+ */
+class MetricsHttpEndpoint {
+public:
+    typedef std::function<MetricsSnapshot()> SnapshotProvider;
+
+    /**
+     * @brief Constructor for MetricsHttpEndpoint (closed until open() is called)
+     */
+    MetricsHttpEndpoint();
+
+    /**
+     * @brief Destructor that stops the listener thread
+     */
+    ~MetricsHttpEndpoint();
+
+    /**
+     * @brief Listen on localhost and start serving scrapes
+     * @param listenPort TCP port on 127.0.0.1, or 0 for any free port
+     * @param snapshotProvider Called on the listener thread for every scrape
+     * @return True if the port could be bound
+     */
+    bool open(unsigned short listenPort, const SnapshotProvider& snapshotProvider);
+
+    /**
+     * @brief Stop the listener thread and close the socket
+     */
+    void close();
+
+    /**
+     * @brief Check if scrapes are being served
+     * @return True if open
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get the port actually bound (useful after open(0, ...))
+     * @return Listening port, or 0 if closed
+     */
+    unsigned short getListenPort() const;
+
+    /**
+     * @brief Get the number of scrapes answered so far
+     * @return Served request count
+     */
+    std::uint64_t getServedRequestCount() const;
+
+    /**
+     * @brief Format a snapshot in the Prometheus text exposition format (version 0.0.4)
+     * @param metricsSnapshot Snapshot to format
+     * @return Counters, per-speed dwell time and the tick latency histogram with quantiles
+     */
+    static std::string formatPrometheusText(const MetricsSnapshot& metricsSnapshot);
+
+private:
+    MetricsHttpEndpoint(const MetricsHttpEndpoint&);
+    MetricsHttpEndpoint& operator=(const MetricsHttpEndpoint&);
+
+    int listeningSocket;
+    unsigned short boundPort;
+    SnapshotProvider provideSnapshot;
+    std::atomic<bool> isListenerRunning;
+    std::atomic<std::uint64_t> servedRequestCount;
+    std::thread listenerThread;
+
+    /**
+     * @brief Background loop that accepts and answers connections until close()
+     */
+    void runListenerThread();
+
+    /**
+     * @brief Read one request from a connection and send the response
+     * @param clientSocket Connected socket (closed by the caller)
+     */
+    void serveConnection(int clientSocket);
+};
+
+#endif // METRICS_HTTP_ENDPOINT_H
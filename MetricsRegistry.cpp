@@ -0,0 +1,246 @@
+#include "MetricsRegistry.h"
+#include <cmath>
+
+const unsigned int LatencyHistogram::SUB_BUCKET_BITS;
+const std::size_t LatencyHistogram::SUB_BUCKET_COUNT;
+const std::size_t LatencyHistogram::BUCKET_COUNT;
+const std::size_t MetricsSnapshot::WIPER_SPEED_COUNT;
+
+namespace {
+
+/**
+ * @brief Get the index of the highest set bit
+ * @param value Non-zero value
+ * @return Bit index in [0, 63]
+ */
+unsigned int getHighestSetBit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned int>(__builtin_clzll(value));
+#else
+    unsigned int bitIndex = 0;
+    while (value >>= 1) {
+        bitIndex++;
+    }
+    return bitIndex;
+#endif
+}
+
+/**
+ * @brief Convert a time point to a count of nanoseconds since its clock's epoch
+ * @param timePoint Time point to convert
+ * @return Nanoseconds since the epoch
+ */
+std::int64_t toNanoseconds(MetricsRegistry::TimePoint timePoint) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+}
+
+} // namespace
+
+MetricCounter::MetricCounter() : counterValue(0) {
+}
+
+std::uint64_t MetricCounter::getValue() const {
+    return counterValue.load(std::memory_order_relaxed);
+}
+
+std::uint64_t HistogramSnapshot::getValueAtPercentile(double percentile) const {
+    if (sampleCount == 0) {
+        return 0;
+    }
+
+    // Nearest rank: the smallest bucket holding at least percentile% of the samples
+    double clampedPercentile = (percentile < 0.0) ? 0.0 : ((percentile > 100.0) ? 100.0 : percentile);
+    std::uint64_t targetRank = static_cast<std::uint64_t>(std::ceil(clampedPercentile / 100.0 * static_cast<double>(sampleCount)));
+    if (targetRank == 0) {
+        targetRank = 1;
+    }
+
+    std::uint64_t cumulativeCount = 0;
+    for (std::size_t bucketIndex = 0; bucketIndex < bucketCounts.size(); bucketIndex++) {
+        cumulativeCount += bucketCounts[bucketIndex];
+        if (cumulativeCount >= targetRank) {
+            std::uint64_t bucketUpperBound = LatencyHistogram::getBucketUpperBound(bucketIndex);
+            return (bucketUpperBound < maxValue) ? bucketUpperBound : maxValue;
+        }
+    }
+    return maxValue;
+}
+
+double HistogramSnapshot::getMeanValue() const {
+    return (sampleCount > 0) ? static_cast<double>(valueSum) / static_cast<double>(sampleCount) : 0.0;
+}
+
+LatencyHistogram::LatencyHistogram() : sampleCount(0), valueSum(0), maxValue(0) {
+    for (std::size_t bucketIndex = 0; bucketIndex < BUCKET_COUNT; bucketIndex++) {
+        bucketCounts[bucketIndex].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t LatencyHistogram::getBucketIndex(std::uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<std::size_t>(value);
+    }
+
+    // Bucket group per power of two, then the SUB_BUCKET_BITS bits below the leading one
+    unsigned int highestBit = getHighestSetBit(value);
+    unsigned int subBucketShift = highestBit - SUB_BUCKET_BITS;
+    std::size_t subBucketIndex = static_cast<std::size_t>(value >> subBucketShift) & (SUB_BUCKET_COUNT - 1);
+    return (subBucketShift + 1) * SUB_BUCKET_COUNT + subBucketIndex;
+}
+
+std::uint64_t LatencyHistogram::getBucketLowerBound(std::size_t bucketIndex) {
+    if (bucketIndex < SUB_BUCKET_COUNT) {
+        return static_cast<std::uint64_t>(bucketIndex);
+    }
+
+    unsigned int subBucketShift = static_cast<unsigned int>(bucketIndex / SUB_BUCKET_COUNT) - 1;
+    std::uint64_t subBucketIndex = bucketIndex % SUB_BUCKET_COUNT;
+    return (1ULL << (subBucketShift + SUB_BUCKET_BITS)) + (subBucketIndex << subBucketShift);
+}
+
+std::uint64_t LatencyHistogram::getBucketUpperBound(std::size_t bucketIndex) {
+    if (bucketIndex < SUB_BUCKET_COUNT) {
+        return static_cast<std::uint64_t>(bucketIndex);
+    }
+
+    unsigned int subBucketShift = static_cast<unsigned int>(bucketIndex / SUB_BUCKET_COUNT) - 1;
+    return getBucketLowerBound(bucketIndex) + ((1ULL << subBucketShift) - 1);
+}
+
+void LatencyHistogram::recordValue(std::uint64_t value) {
+    bucketCounts[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sampleCount.fetch_add(1, std::memory_order_relaxed);
+    valueSum.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t previousMax = maxValue.load(std::memory_order_relaxed);
+    while (value > previousMax &&
+           !maxValue.compare_exchange_weak(previousMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot LatencyHistogram::takeSnapshot() const {
+    HistogramSnapshot histogramSnapshot;
+    histogramSnapshot.bucketCounts.resize(BUCKET_COUNT);
+
+    // Bucket counts are summed rather than trusting sampleCount, so a snapshot taken
+    // while values are being recorded is still self-consistent
+    std::uint64_t bucketTotal = 0;
+    for (std::size_t bucketIndex = 0; bucketIndex < BUCKET_COUNT; bucketIndex++) {
+        histogramSnapshot.bucketCounts[bucketIndex] = bucketCounts[bucketIndex].load(std::memory_order_relaxed);
+        bucketTotal += histogramSnapshot.bucketCounts[bucketIndex];
+    }
+    histogramSnapshot.sampleCount = bucketTotal;
+    histogramSnapshot.valueSum = valueSum.load(std::memory_order_relaxed);
+    histogramSnapshot.maxValue = maxValue.load(std::memory_order_relaxed);
+    return histogramSnapshot;
+}
+
+MetricsRegistry::MetricsRegistry() : speedStateSequence(0), trackedWiperSpeed(-1), trackedSpeedSinceNanoseconds(0) {
+}
+
+void MetricsRegistry::recordTurnOffCountdownEvent(TurnOffCountdownEvent countdownEvent) {
+    switch (countdownEvent) {
+        case TurnOffCountdownEvent::STARTED:
+            turnOffCountdownStarts.increment();
+            break;
+        case TurnOffCountdownEvent::CANCELLED:
+            turnOffCountdownCancels.increment();
+            break;
+        case TurnOffCountdownEvent::EXPIRED:
+            turnOffCountdownExpiries.increment();
+            break;
+        default:
+            break;
+    }
+}
+
+void MetricsRegistry::recordWiperSpeed(WindshieldWiperSpeed wiperSpeed, TimePoint currentTime) {
+    int newSpeed = static_cast<int>(wiperSpeed);
+    int previousSpeed = trackedWiperSpeed.load(std::memory_order_relaxed);
+    if (newSpeed == previousSpeed) {
+        return;
+    }
+
+    std::int64_t currentNanoseconds = toNanoseconds(currentTime);
+
+    // Single writer, so the sequence only needs publishing, not a compare-and-swap
+    std::uint32_t sequenceNumber = speedStateSequence.load(std::memory_order_relaxed);
+    speedStateSequence.store(sequenceNumber + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (previousSpeed >= 0) {
+        // Close the dwell interval of the speed being left
+        std::int64_t dwellNanoseconds = currentNanoseconds - trackedSpeedSinceNanoseconds.load(std::memory_order_relaxed);
+        if (dwellNanoseconds > 0) {
+            speedDwellNanoseconds[previousSpeed].increment(static_cast<std::uint64_t>(dwellNanoseconds));
+        }
+        wiperSpeedTransitions.increment();
+    }
+    trackedSpeedSinceNanoseconds.store(currentNanoseconds, std::memory_order_relaxed);
+    trackedWiperSpeed.store(newSpeed, std::memory_order_relaxed);
+
+    speedStateSequence.store(sequenceNumber + 2, std::memory_order_release);
+}
+
+MetricsSnapshot MetricsRegistry::takeSnapshot(TimePoint currentTime) const {
+    MetricsSnapshot metricsSnapshot;
+    metricsSnapshot.controlTickCount = controlTicks.getValue();
+    metricsSnapshot.rainBurstCount = rainBursts.getValue();
+    metricsSnapshot.sensorFailureCount = sensorFailures.getValue();
+    metricsSnapshot.turnOffCountdownStartCount = turnOffCountdownStarts.getValue();
+    metricsSnapshot.turnOffCountdownCancelCount = turnOffCountdownCancels.getValue();
+    metricsSnapshot.turnOffCountdownExpiryCount = turnOffCountdownExpiries.getValue();
+
+    // Seqlock read: retry until no speed change overlapped the copy
+    int currentSpeed;
+    std::int64_t speedSinceNanoseconds;
+    std::uint32_t firstSequenceNumber;
+    do {
+        firstSequenceNumber = speedStateSequence.load(std::memory_order_acquire);
+        currentSpeed = trackedWiperSpeed.load(std::memory_order_relaxed);
+        speedSinceNanoseconds = trackedSpeedSinceNanoseconds.load(std::memory_order_relaxed);
+        metricsSnapshot.wiperSpeedTransitionCount = wiperSpeedTransitions.getValue();
+        for (std::size_t speedIndex = 0; speedIndex < MetricsSnapshot::WIPER_SPEED_COUNT; speedIndex++) {
+            metricsSnapshot.speedDwellNanoseconds[speedIndex] = speedDwellNanoseconds[speedIndex].getValue();
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((firstSequenceNumber & 1) != 0 || speedStateSequence.load(std::memory_order_relaxed) != firstSequenceNumber);
+
+    if (currentSpeed >= 0) {
+        // Count the interval still in progress up to the snapshot time
+        std::int64_t openDwellNanoseconds = toNanoseconds(currentTime) - speedSinceNanoseconds;
+        if (openDwellNanoseconds > 0) {
+            metricsSnapshot.speedDwellNanoseconds[currentSpeed] += static_cast<std::uint64_t>(openDwellNanoseconds);
+        }
+    }
+
+    metricsSnapshot.controlTickLatency = controlTickLatency.takeSnapshot();
+    return metricsSnapshot;
+}
+
+void MetricsRegistry::printMetricsReport(const MetricsSnapshot& metricsSnapshot, std::ostream& outputStream) {
+    outputStream << "Wiper metrics: " << metricsSnapshot.controlTickCount << " control ticks, "
+                 << metricsSnapshot.rainBurstCount << " rain bursts, "
+                 << metricsSnapshot.sensorFailureCount << " sensor failures, "
+                 << metricsSnapshot.wiperSpeedTransitionCount << " speed transitions" << std::endl;
+    outputStream << "  Turn-off countdowns: " << metricsSnapshot.turnOffCountdownStartCount << " started, "
+                 << metricsSnapshot.turnOffCountdownCancelCount << " cancelled, "
+                 << metricsSnapshot.turnOffCountdownExpiryCount << " expired" << std::endl;
+
+    outputStream << "  Dwell time:";
+    for (std::size_t speedIndex = 0; speedIndex < MetricsSnapshot::WIPER_SPEED_COUNT; speedIndex++) {
+        outputStream << " " << convertWiperSpeedToString(static_cast<WindshieldWiperSpeed>(speedIndex)) << " "
+                     << (static_cast<double>(metricsSnapshot.speedDwellNanoseconds[speedIndex]) / 1e9) << " s";
+        if (speedIndex + 1 < MetricsSnapshot::WIPER_SPEED_COUNT) {
+            outputStream << ",";
+        }
+    }
+    outputStream << std::endl;
+
+    const HistogramSnapshot& tickLatency = metricsSnapshot.controlTickLatency;
+    outputStream << "  Control tick latency: mean " << (tickLatency.getMeanValue() / 1000.0)
+                 << " us, p50 " << (tickLatency.getValueAtPercentile(50.0) / 1000.0)
+                 << " us, p99 " << (tickLatency.getValueAtPercentile(99.0) / 1000.0)
+                 << " us, p99.9 " << (tickLatency.getValueAtPercentile(99.9) / 1000.0)
+                 << " us, max " << (tickLatency.maxValue / 1000.0) << " us" << std::endl;
+}
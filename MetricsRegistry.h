@@ -0,0 +1,207 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include "WiperEnums.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief MetricCounter class for a monotonically increasing lock-free counter
+ */
+class MetricCounter {
+private:
+    std::atomic<std::uint64_t> counterValue;
+
+public:
+    /**
+     * @brief Constructor for MetricCounter
+     */
+    MetricCounter();
+
+    /**
+     * @brief Add to the counter (relaxed, safe from any thread)
+     * @param amount Amount to add
+     */
+    void increment(std::uint64_t amount = 1) {
+        counterValue.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the current counter value
+     * @return Counter value
+     */
+    std::uint64_t getValue() const;
+};
+
+/**
+ * @brief Structure for a point-in-time copy of a LatencyHistogram
+ */
+struct HistogramSnapshot {
+    std::vector<std::uint64_t> bucketCounts;
+    std::uint64_t sampleCount;
+    std::uint64_t valueSum;
+    std::uint64_t maxValue;
+
+    /**
+     * @brief Get the value below which a given fraction of samples fall
+     * @param percentile Percentile in [0, 100]
+     * @return Highest value equivalent to the percentile's bucket (capped at the maximum), or 0 if empty
+     */
+    std::uint64_t getValueAtPercentile(double percentile) const;
+
+    /**
+     * @brief Get the mean of all recorded values
+     * @return Mean value, or 0 if empty
+     */
+    double getMeanValue() const;
+};
+
+/**
+ * @brief LatencyHistogram class for HDR-style log-linear histograms of nanosecond values
+ *
+ * Each power of two is split into SUB_BUCKET_COUNT linear buckets, so every recorded
+ * value is kept to within 1/SUB_BUCKET_COUNT (about 3%) of its magnitude over the full
+ * 64-bit range. Recording is a few relaxed atomic adds and never allocates or locks;
+ * percentiles are computed only when a snapshot is taken.
+ */
+class LatencyHistogram {
+public:
+    static const unsigned int SUB_BUCKET_BITS = 5;
+    static const std::size_t SUB_BUCKET_COUNT = 32; // 1 << SUB_BUCKET_BITS
+    static const std::size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (64 - SUB_BUCKET_BITS + 1);
+
+private:
+    std::atomic<std::uint64_t> bucketCounts[BUCKET_COUNT];
+    std::atomic<std::uint64_t> sampleCount;
+    std::atomic<std::uint64_t> valueSum;
+    std::atomic<std::uint64_t> maxValue;
+
+public:
+    /**
+     * @brief Constructor for LatencyHistogram
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Get the bucket a value is counted in
+     * @param value Recorded value
+     * @return Bucket index in [0, BUCKET_COUNT)
+     */
+    static std::size_t getBucketIndex(std::uint64_t value);
+
+    /**
+     * @brief Get the smallest value counted in a bucket
+     * @param bucketIndex Bucket index in [0, BUCKET_COUNT)
+     * @return Lower bound of the bucket (inclusive)
+     */
+    static std::uint64_t getBucketLowerBound(std::size_t bucketIndex);
+
+    /**
+     * @brief Get the largest value counted in a bucket
+     * @param bucketIndex Bucket index in [0, BUCKET_COUNT)
+     * @return Upper bound of the bucket (inclusive)
+     */
+    static std::uint64_t getBucketUpperBound(std::size_t bucketIndex);
+
+    /**
+     * @brief Record one value (relaxed, safe from any thread)
+     * @param value Value to record, normally nanoseconds
+     */
+    void recordValue(std::uint64_t value);
+
+    /**
+     * @brief Copy the current bucket counts and totals
+     * @return Snapshot that can be queried without touching the live histogram
+     */
+    HistogramSnapshot takeSnapshot() const;
+};
+
+/**
+ * @brief Structure for a point-in-time copy of every wiper system metric
+ */
+struct MetricsSnapshot {
+    static const std::size_t WIPER_SPEED_COUNT = 4; // OFF, LOW, MEDIUM, HIGH
+
+    std::uint64_t controlTickCount;
+    std::uint64_t rainBurstCount;
+    std::uint64_t sensorFailureCount;
+    std::uint64_t wiperSpeedTransitionCount;
+    std::uint64_t turnOffCountdownStartCount;
+    std::uint64_t turnOffCountdownCancelCount;
+    std::uint64_t turnOffCountdownExpiryCount;
+    std::uint64_t speedDwellNanoseconds[WIPER_SPEED_COUNT];
+    HistogramSnapshot controlTickLatency;
+};
+
+/**
+ * @brief MetricsRegistry class holding the wiper system's counters and histograms
+ *
+ * The control thread records into relaxed atomics at a cost of a few nanoseconds per
+ * event; all aggregation happens in takeSnapshot(), which any thread may call at any
+ * time without blocking the recorder. Per-speed dwell time includes the interval the
+ * wipers are currently in, up to the snapshot time; a snapshot that overlaps a speed
+ * change retries instead of mixing the old and new speed state.
+ */
+class MetricsRegistry {
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    MetricCounter controlTicks;
+    MetricCounter rainBursts;
+    MetricCounter sensorFailures;
+    MetricCounter wiperSpeedTransitions;
+    MetricCounter turnOffCountdownStarts;
+    MetricCounter turnOffCountdownCancels;
+    MetricCounter turnOffCountdownExpiries;
+    LatencyHistogram controlTickLatency;
+
+private:
+    // Written only by recordWiperSpeed() inside a seqlock, so a snapshot reads the speed,
+    // its start time, the closed dwells and the transition count as one consistent set
+    std::atomic<std::uint32_t> speedStateSequence; // Odd while recordWiperSpeed() is mid-update
+    MetricCounter speedDwellNanoseconds[MetricsSnapshot::WIPER_SPEED_COUNT];
+    std::atomic<int> trackedWiperSpeed;             // -1 until the first recordWiperSpeed()
+    std::atomic<std::int64_t> trackedSpeedSinceNanoseconds;
+
+public:
+    /**
+     * @brief Constructor for MetricsRegistry
+     */
+    MetricsRegistry();
+
+    /**
+     * @brief Count a turn-off countdown change reported by the controller
+     * @param countdownEvent Countdown change from processAutomaticModeOperation()
+     */
+    void recordTurnOffCountdownEvent(TurnOffCountdownEvent countdownEvent);
+
+    /**
+     * @brief Note the wiper speed in force at a given time (call from one thread only)
+     * @param wiperSpeed Current wiper speed
+     * @param currentTime Time of the observation (real or virtual)
+     *
+     * A change from the previously noted speed counts as a transition and closes
+     * that speed's dwell interval.
+     */
+    void recordWiperSpeed(WindshieldWiperSpeed wiperSpeed, TimePoint currentTime);
+
+    /**
+     * @brief Copy every metric
+     * @param currentTime Time the open dwell interval is measured up to (same clock as recordWiperSpeed)
+     * @return Snapshot of all counters and histograms
+     */
+    MetricsSnapshot takeSnapshot(TimePoint currentTime) const;
+
+    /**
+     * @brief Print a snapshot in a readable form
+     * @param metricsSnapshot Snapshot to print
+     * @param outputStream Stream to print to
+     */
+    static void printMetricsReport(const MetricsSnapshot& metricsSnapshot, std::ostream& outputStream);
+};
+
+#endif // METRICS_REGISTRY_H
@@ -0,0 +1,94 @@
+#include "PackedControllerState.h"
+#include "WindshieldWiperController.h"
+
+const unsigned int PackedControllerState::WAITING_BIT;
+const unsigned int PackedControllerState::AUTOMATIC_MODE_BIT;
+const unsigned int PackedControllerState::SPRAY_MODE_SHIFT;
+const unsigned int PackedControllerState::COUNTDOWN_START_SHIFT;
+
+static_assert(sizeof(PackedControllerState) == 8, "PackedControllerState must stay one 64-bit word");
+
+PackedControllerState::PackedControllerState()
+    : packedWord(static_cast<std::uint64_t>(WindshieldWiperSpeed::OFF) |
+                 (1ULL << AUTOMATIC_MODE_BIT) |
+                 (static_cast<std::uint64_t>(WaterSprayMode::OFF) << SPRAY_MODE_SHIFT)) {
+}
+
+std::uint32_t PackedControllerState::computeTurnOffDelayTicks(unsigned int tickIntervalMilliseconds) {
+    // The countdown ends on the first tick at least TURN_OFF_DELAY_SECONDS after it started
+    if (tickIntervalMilliseconds == 0) {
+        return 0xFFFFFFFFu;
+    }
+    std::uint64_t turnOffDelayMilliseconds = static_cast<std::uint64_t>(WindshieldWiperController::TURN_OFF_DELAY_SECONDS) * 1000;
+    return static_cast<std::uint32_t>((turnOffDelayMilliseconds + tickIntervalMilliseconds - 1) / tickIntervalMilliseconds);
+}
+
+void PackedControllerState::setWiperSpeed(WindshieldWiperSpeed newWiperSpeed) {
+    packedWord = (packedWord & ~3ULL) | (static_cast<std::uint64_t>(newWiperSpeed) & 3);
+}
+
+WindshieldWiperSpeed PackedControllerState::getCurrentWiperSpeed() const {
+    return static_cast<WindshieldWiperSpeed>(packedWord & 3);
+}
+
+void PackedControllerState::setOperatingMode(OperatingMode newOperatingMode) {
+    packedWord = (packedWord & ~(1ULL << AUTOMATIC_MODE_BIT)) |
+                 (static_cast<std::uint64_t>(newOperatingMode == OperatingMode::AUTOMATIC) << AUTOMATIC_MODE_BIT);
+}
+
+OperatingMode PackedControllerState::getCurrentOperatingMode() const {
+    return ((packedWord >> AUTOMATIC_MODE_BIT) & 1) != 0 ? OperatingMode::AUTOMATIC : OperatingMode::MANUAL;
+}
+
+void PackedControllerState::setWaterSprayMode(WaterSprayMode newSprayMode) {
+    packedWord = (packedWord & ~(3ULL << SPRAY_MODE_SHIFT)) |
+                 ((static_cast<std::uint64_t>(newSprayMode) & 3) << SPRAY_MODE_SHIFT);
+}
+
+WaterSprayMode PackedControllerState::getCurrentWaterSprayMode() const {
+    return static_cast<WaterSprayMode>((packedWord >> SPRAY_MODE_SHIFT) & 3);
+}
+
+TurnOffCountdownEvent PackedControllerState::processAutomaticModeOperation(const RainSensor::SensorReadingData& sensorData,
+                                                                           std::uint64_t currentTick,
+                                                                           std::uint32_t turnOffDelayTicks) {
+    std::uint32_t countdownStartTick = static_cast<std::uint32_t>(packedWord >> COUNTDOWN_START_SHIFT);
+    bool isWaitingToTurnOff = isWaitingToTurnOffWipers();
+    bool hasTurnOffDelayElapsed = isWaitingToTurnOff &&
+        static_cast<std::uint32_t>(static_cast<std::uint32_t>(currentTick) - countdownStartTick) >= turnOffDelayTicks;
+
+    // Same rules as the full controller; spray mode and operating mode are not touched
+    WindshieldWiperSpeed wiperSpeed = getCurrentWiperSpeed();
+    TurnOffCountdownEvent countdownEvent = WindshieldWiperController::applyAutomaticModeRules(sensorData, wiperSpeed,
+                                                                                              isWaitingToTurnOff, hasTurnOffDelayElapsed);
+    if (countdownEvent == TurnOffCountdownEvent::STARTED) {
+        countdownStartTick = static_cast<std::uint32_t>(currentTick);
+    }
+    packedWord = (packedWord & ((1ULL << AUTOMATIC_MODE_BIT) | (3ULL << SPRAY_MODE_SHIFT))) |
+                 static_cast<std::uint64_t>(wiperSpeed) |
+                 (static_cast<std::uint64_t>(isWaitingToTurnOff) << WAITING_BIT) |
+                 (static_cast<std::uint64_t>(countdownStartTick) << COUNTDOWN_START_SHIFT);
+    return countdownEvent;
+}
+
+bool PackedControllerState::isWaitingToTurnOffWipers() const {
+    return ((packedWord >> WAITING_BIT) & 1) != 0;
+}
+
+int PackedControllerState::getRemainingTurnOffSeconds(std::uint64_t currentTick, unsigned int tickIntervalMilliseconds) const {
+    if (!isWaitingToTurnOffWipers()) {
+        return 0;
+    }
+
+    std::uint32_t countdownStartTick = static_cast<std::uint32_t>(packedWord >> COUNTDOWN_START_SHIFT);
+    std::uint64_t elapsedTicks = static_cast<std::uint32_t>(static_cast<std::uint32_t>(currentTick) - countdownStartTick);
+    std::uint64_t elapsedSeconds = elapsedTicks * tickIntervalMilliseconds / 1000;
+    if (elapsedSeconds >= static_cast<std::uint64_t>(WindshieldWiperController::TURN_OFF_DELAY_SECONDS)) {
+        return 0;
+    }
+    return WindshieldWiperController::TURN_OFF_DELAY_SECONDS - static_cast<int>(elapsedSeconds);
+}
+
+std::uint64_t PackedControllerState::getPackedWord() const {
+    return packedWord;
+}
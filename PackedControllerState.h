@@ -0,0 +1,111 @@
+#ifndef PACKED_CONTROLLER_STATE_H
+#define PACKED_CONTROLLER_STATE_H
+
+#include "WiperEnums.h"
+#include "RainSensor.h"
+#include <cstdint>
+
+/**
+ * @brief PackedControllerState class holding one controller's state in a single 64-bit word
+ *
+ * Layout (low bits first):
+ *
+ *   bits 0-1 wiper speed, bit 2 waiting to turn off, bit 3 automatic mode,
+ *   bits 4-5 water spray mode, bits 32-63 tick the turn-off countdown started on
+ *
+ * The low four bits use the same order as the AutomaticModeTransitionTable index.
+ * Time is counted in ticks of a fixed interval, so the countdown needs 32 bits instead
+ * of a time_point; tick differences are taken modulo 2^32, which is exact for any
+ * turn-off delay shorter than 2^32 ticks. A million vehicles fit in 8 MB.
+ */
+class PackedControllerState {
+private:
+    std::uint64_t packedWord;
+
+    static const unsigned int WAITING_BIT = 2;
+    static const unsigned int AUTOMATIC_MODE_BIT = 3;
+    static const unsigned int SPRAY_MODE_SHIFT = 4;
+    static const unsigned int COUNTDOWN_START_SHIFT = 32;
+
+public:
+    /**
+     * @brief Constructor for PackedControllerState (same initial state as WindshieldWiperController)
+     */
+    PackedControllerState();
+
+    /**
+     * @brief Convert the turn-off delay to whole ticks
+     * @param tickIntervalMilliseconds Simulated time per tick
+     * @return Ticks until a countdown ends (rounded up), or 2^32 - 1 if the interval is zero
+     */
+    static std::uint32_t computeTurnOffDelayTicks(unsigned int tickIntervalMilliseconds);
+
+    /**
+     * @brief Set the wiper speed
+     * @param newWiperSpeed The new wiper speed to set
+     */
+    void setWiperSpeed(WindshieldWiperSpeed newWiperSpeed);
+
+    /**
+     * @brief Get the current wiper speed
+     * @return Current wiper speed
+     */
+    WindshieldWiperSpeed getCurrentWiperSpeed() const;
+
+    /**
+     * @brief Set the operating mode
+     * @param newOperatingMode The new operating mode to set
+     */
+    void setOperatingMode(OperatingMode newOperatingMode);
+
+    /**
+     * @brief Get the current operating mode
+     * @return Current operating mode
+     */
+    OperatingMode getCurrentOperatingMode() const;
+
+    /**
+     * @brief Set the water spray mode
+     * @param newSprayMode The new water spray mode to set
+     */
+    void setWaterSprayMode(WaterSprayMode newSprayMode);
+
+    /**
+     * @brief Get the current water spray mode
+     * @return Current water spray mode
+     */
+    WaterSprayMode getCurrentWaterSprayMode() const;
+
+    /**
+     * @brief Process automatic mode operation at a tick
+     * @param sensorData The sensor data to process
+     * @param currentTick Tick of the sample
+     * @param turnOffDelayTicks Countdown length from computeTurnOffDelayTicks()
+     * @return The change this sample made to the turn-off countdown
+     */
+    TurnOffCountdownEvent processAutomaticModeOperation(const RainSensor::SensorReadingData& sensorData,
+                                                        std::uint64_t currentTick,
+                                                        std::uint32_t turnOffDelayTicks);
+
+    /**
+     * @brief Check if the system is waiting to turn off wipers
+     * @return True if waiting to turn off, false otherwise
+     */
+    bool isWaitingToTurnOffWipers() const;
+
+    /**
+     * @brief Get remaining seconds before turning off wipers at a tick
+     * @param currentTick Tick to measure the countdown against
+     * @param tickIntervalMilliseconds Simulated time per tick
+     * @return Remaining seconds, or 0 if not waiting
+     */
+    int getRemainingTurnOffSeconds(std::uint64_t currentTick, unsigned int tickIntervalMilliseconds) const;
+
+    /**
+     * @brief Get the raw 64-bit state word
+     * @return Packed state
+     */
+    std::uint64_t getPackedWord() const;
+};
+
+#endif // PACKED_CONTROLLER_STATE_H
@@ -0,0 +1,139 @@
+#include "PeriodicScheduler.h"
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+PeriodicScheduler::PeriodicScheduler(unsigned int tickRateHz)
+    : currentTickRateHz(1),
+      tickPeriod(std::chrono::seconds(1)),
+      nextDeadline() {
+    setTickRate(tickRateHz);
+    std::memset(&latenessHistogram, 0, sizeof(latenessHistogram));
+}
+
+void PeriodicScheduler::setTickRate(unsigned int tickRateHz) {
+    if (tickRateHz < 1) {
+        tickRateHz = 1;
+    } else if (tickRateHz > MAX_TICK_RATE_HZ) {
+        tickRateHz = MAX_TICK_RATE_HZ;
+    }
+    currentTickRateHz = tickRateHz;
+    tickPeriod = std::chrono::nanoseconds(1000000000LL / tickRateHz);
+}
+
+unsigned int PeriodicScheduler::getTickRate() const {
+    return currentTickRateHz;
+}
+
+std::chrono::nanoseconds PeriodicScheduler::getTickPeriod() const {
+    return tickPeriod;
+}
+
+bool PeriodicScheduler::enableRealtimeScheduling(int cpuIndex, int fifoPriority) {
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpuIndex, &cpuSet);
+    bool isPinned = (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0);
+
+    struct sched_param schedulingParameters;
+    std::memset(&schedulingParameters, 0, sizeof(schedulingParameters));
+    schedulingParameters.sched_priority = fifoPriority;
+    bool isFifo = (pthread_setschedparam(pthread_self(), SCHED_FIFO, &schedulingParameters) == 0);
+
+    return isPinned && isFifo;
+#else
+    (void)cpuIndex;
+    (void)fifoPriority;
+    return false;
+#endif
+}
+
+void PeriodicScheduler::start() {
+    std::memset(&latenessHistogram, 0, sizeof(latenessHistogram));
+    nextDeadline = std::chrono::steady_clock::now() + tickPeriod;
+}
+
+PeriodicScheduler::TimePoint PeriodicScheduler::getNextDeadline() const {
+    return nextDeadline;
+}
+
+void PeriodicScheduler::waitForNextTick() {
+#if !defined(_WIN32)
+    // steady_clock is CLOCK_MONOTONIC, so its epoch count converts directly to a timespec
+    std::chrono::nanoseconds deadlineSinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(nextDeadline.time_since_epoch());
+    struct timespec deadlineSpecification;
+    deadlineSpecification.tv_sec = static_cast<time_t>(deadlineSinceEpoch.count() / 1000000000);
+    deadlineSpecification.tv_nsec = static_cast<long>(deadlineSinceEpoch.count() % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadlineSpecification, nullptr) == EINTR) {
+        // Interrupted by a signal - the absolute deadline is still valid, so just retry
+    }
+#else
+    std::this_thread::sleep_until(nextDeadline);
+#endif
+    recordTickStart(std::chrono::steady_clock::now());
+}
+
+void PeriodicScheduler::recordTickStart(TimePoint wakeTime) {
+    std::int64_t latenessNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeTime - nextDeadline).count();
+    if (latenessNanoseconds < 0) {
+        latenessNanoseconds = 0;
+    }
+
+    // Bucket by the bit length of the lateness in whole microseconds
+    std::uint64_t latenessMicroseconds = static_cast<std::uint64_t>(latenessNanoseconds) / 1000;
+    std::size_t bucketIndex = 0;
+    while (latenessMicroseconds != 0 && bucketIndex < LATENESS_BUCKET_COUNT - 1) {
+        latenessMicroseconds >>= 1;
+        bucketIndex++;
+    }
+    latenessHistogram.bucketCounts[bucketIndex]++;
+    latenessHistogram.tickCount++;
+    latenessHistogram.totalLatenessNanoseconds += static_cast<double>(latenessNanoseconds);
+    if (latenessNanoseconds > latenessHistogram.maxLatenessNanoseconds) {
+        latenessHistogram.maxLatenessNanoseconds = latenessNanoseconds;
+    }
+
+    nextDeadline += tickPeriod;
+    if (wakeTime >= nextDeadline) {
+        std::int64_t skippedPeriods = (wakeTime - nextDeadline) / tickPeriod + 1;
+        nextDeadline += tickPeriod * skippedPeriods;
+        latenessHistogram.missedDeadlineCount += static_cast<std::uint64_t>(skippedPeriods);
+    }
+}
+
+const PeriodicScheduler::LatenessHistogram& PeriodicScheduler::getLatenessHistogram() const {
+    return latenessHistogram;
+}
+
+void PeriodicScheduler::printLatenessReport(std::ostream& outputStream) const {
+    double meanLatenessMicroseconds = (latenessHistogram.tickCount > 0) ?
+        latenessHistogram.totalLatenessNanoseconds / static_cast<double>(latenessHistogram.tickCount) / 1000.0 : 0.0;
+
+    outputStream << "Tick lateness at " << currentTickRateHz << " Hz: "
+                 << latenessHistogram.tickCount << " ticks, "
+                 << latenessHistogram.missedDeadlineCount << " missed deadlines, mean "
+                 << meanLatenessMicroseconds << " us, max "
+                 << (latenessHistogram.maxLatenessNanoseconds / 1000.0) << " us" << std::endl;
+
+    for (std::size_t bucketIndex = 0; bucketIndex < LATENESS_BUCKET_COUNT; bucketIndex++) {
+        if (latenessHistogram.bucketCounts[bucketIndex] == 0) {
+            continue;
+        }
+        if (bucketIndex == LATENESS_BUCKET_COUNT - 1) {
+            outputStream << "  >= " << (1ULL << (bucketIndex - 1)) << " us";
+        } else {
+            outputStream << "  < " << (1ULL << bucketIndex) << " us";
+        }
+        outputStream << ": " << latenessHistogram.bucketCounts[bucketIndex] << std::endl;
+    }
+}
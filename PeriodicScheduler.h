@@ -0,0 +1,114 @@
+#ifndef PERIODIC_SCHEDULER_H
+#define PERIODIC_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief PeriodicScheduler class to run a control loop on fixed absolute deadlines
+ *
+ * Deadlines are start + k * period, so time spent inside a tick never shifts later
+ * ticks. On POSIX the scheduler sleeps with clock_nanosleep(TIMER_ABSTIME) on
+ * CLOCK_MONOTONIC; reactors that wait on their own timer can report wakeups through
+ * recordTickStart() instead. Every tick's lateness lands in a log2 histogram.
+ */
+class PeriodicScheduler {
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    static const unsigned int MAX_TICK_RATE_HZ = 1000;
+    static const std::size_t LATENESS_BUCKET_COUNT = 24;
+
+    /**
+     * @brief Structure to hold per-tick lateness statistics
+     *
+     * Bucket 0 counts ticks less than 1 us late, bucket i counts [2^(i-1), 2^i) us,
+     * and the last bucket collects everything beyond.
+     */
+    struct LatenessHistogram {
+        std::uint64_t bucketCounts[LATENESS_BUCKET_COUNT];
+        std::uint64_t tickCount;
+        std::uint64_t missedDeadlineCount;
+        std::int64_t maxLatenessNanoseconds;
+        double totalLatenessNanoseconds;
+    };
+
+    /**
+     * @brief Constructor for PeriodicScheduler
+     * @param tickRateHz Ticks per second, clamped to [1, MAX_TICK_RATE_HZ]
+     */
+    explicit PeriodicScheduler(unsigned int tickRateHz = 1);
+
+    /**
+     * @brief Change the tick rate (takes effect from the next start())
+     * @param tickRateHz Ticks per second, clamped to [1, MAX_TICK_RATE_HZ]
+     */
+    void setTickRate(unsigned int tickRateHz);
+
+    /**
+     * @brief Get the configured tick rate
+     * @return Ticks per second
+     */
+    unsigned int getTickRate() const;
+
+    /**
+     * @brief Get the time between deadlines
+     * @return Tick period
+     */
+    std::chrono::nanoseconds getTickPeriod() const;
+
+    /**
+     * @brief Pin the calling thread to a CPU and switch it to SCHED_FIFO (Linux only)
+     * @param cpuIndex CPU to pin to
+     * @param fifoPriority SCHED_FIFO priority (1-99)
+     * @return True if both settings were applied, false if unsupported or not permitted
+     */
+    static bool enableRealtimeScheduling(int cpuIndex, int fifoPriority);
+
+    /**
+     * @brief Reset statistics and place the first deadline one period from now
+     */
+    void start();
+
+    /**
+     * @brief Get the next absolute deadline
+     * @return Deadline of the upcoming tick
+     */
+    TimePoint getNextDeadline() const;
+
+    /**
+     * @brief Sleep until the next deadline, then record the tick
+     */
+    void waitForNextTick();
+
+    /**
+     * @brief Record a tick whose wakeup came from an external timer
+     * @param wakeTime When the tick actually started
+     *
+     * Deadlines that already passed are skipped and counted as missed, so a stall
+     * never triggers a burst of catch-up ticks.
+     */
+    void recordTickStart(TimePoint wakeTime);
+
+    /**
+     * @brief Get the lateness statistics collected since start()
+     * @return Lateness histogram
+     */
+    const LatenessHistogram& getLatenessHistogram() const;
+
+    /**
+     * @brief Print the lateness statistics in a readable form
+     * @param outputStream Stream to print to
+     */
+    void printLatenessReport(std::ostream& outputStream) const;
+
+private:
+    unsigned int currentTickRateHz;
+    std::chrono::nanoseconds tickPeriod;
+    TimePoint nextDeadline;
+    LatenessHistogram latenessHistogram;
+};
+
+#endif // PERIODIC_SCHEDULER_H
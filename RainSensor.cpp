@@ -1,19 +1,81 @@
 #include "RainSensor.h"
+#include "CounterBasedRandom.h"
+#include "LatencyTracer.h"
+#include <algorithm>
 
 RainSensor::RainSensor() 
-    : randomNumberGenerator(static_cast<std::mt19937::result_type>(std::chrono::steady_clock::now().time_since_epoch().count())),
-      lightPercentageDistribution(0.0, 100.0),
-      sensorFailureDistribution(0.0, 1.0),
-      dewLevelDistribution(0.0, 100.0),
+    : randomNumberGenerator(new std::mt19937(static_cast<std::mt19937::result_type>(std::chrono::steady_clock::now().time_since_epoch().count()))),
+      randomSeed(0),
+      randomStreamId(0),
+      tickIndex(0),
       previousSensorReading(95.0),
-      isSensorInFailureState(false) {
+      suddenBurstDeltaPercentage(DefaultWiperCalibration::SUDDEN_BURST_DELTA_PERCENTAGE),
+      isSensorInFailureState(false),
+      subscribedChannels(CHANNEL_ALL) {
+}
+
+RainSensor::RainSensor(std::uint64_t seed, std::uint64_t streamId)
+    : randomNumberGenerator(),
+      randomSeed(seed),
+      randomStreamId(streamId),
+      tickIndex(0),
+      previousSensorReading(95.0),
+      suddenBurstDeltaPercentage(DefaultWiperCalibration::SUDDEN_BURST_DELTA_PERCENTAGE),
+      isSensorInFailureState(false),
+      subscribedChannels(CHANNEL_ALL) {
+}
+
+void RainSensor::drawRandomValues(double& failureDraw, double& lightPercentage, double& dewLevel) {
+    bool isFailureNeeded = (subscribedChannels & CHANNEL_FAILURE) != 0;
+    bool isLightNeeded = (subscribedChannels & (CHANNEL_LIGHT | CHANNEL_BURST)) != 0;
+    bool isDewNeeded = (subscribedChannels & CHANNEL_DEW) != 0;
+    failureDraw = 1.0;
+    lightPercentage = 0.0;
+    dewLevel = 0.0;
+    
+    if (randomNumberGenerator) {
+        std::uniform_real_distribution<double> unitDistribution(0.0, 1.0);
+        std::uniform_real_distribution<double> percentageDistribution(0.0, 100.0);
+        if (isFailureNeeded) {
+            failureDraw = unitDistribution(*randomNumberGenerator);
+        }
+        if (isLightNeeded) {
+            lightPercentage = percentageDistribution(*randomNumberGenerator);
+        }
+        if (isDewNeeded) {
+            dewLevel = percentageDistribution(*randomNumberGenerator);
+        }
+        return;
+    }
+    
+    // One Philox block per tick: the tick index is the counter, and each channel owns one word
+    if (!isFailureNeeded && !isLightNeeded && !isDewNeeded) {
+        return;
+    }
+    CounterBasedRandom::RandomBlock randomBlock = CounterBasedRandom::generateBlock(randomSeed, randomStreamId, tickIndex);
+    if (isFailureNeeded) {
+        failureDraw = CounterBasedRandom::convertToUnitInterval(randomBlock.words[0]);
+    }
+    if (isLightNeeded) {
+        lightPercentage = CounterBasedRandom::convertToUnitInterval(randomBlock.words[1]) * 100.0;
+    }
+    if (isDewNeeded) {
+        dewLevel = CounterBasedRandom::convertToUnitInterval(randomBlock.words[2]) * 100.0;
+    }
 }
 
 RainSensor::SensorReadingData RainSensor::readSensorData() {
+    WIPER_TRACE_SCOPE("RainSensor::readSensorData");
     SensorReadingData currentSensorData;
     
+    double failureDraw;
+    double currentSensorReading;
+    double currentDewLevel;
+    drawRandomValues(failureDraw, currentSensorReading, currentDewLevel);
+    tickIndex++;
+    
     // Simulate sensor failure (1% chance)
-    if (sensorFailureDistribution(randomNumberGenerator) < 0.01) {
+    if (failureDraw < 0.01) {
         isSensorInFailureState = true;
     }
 
@@ -25,27 +87,191 @@ RainSensor::SensorReadingData RainSensor::readSensorData() {
         currentSensorData.dewLevel = 0.0;
         return currentSensorData;
     }
-
-    // Generate new sensor reading
-    double currentSensorReading = lightPercentageDistribution(randomNumberGenerator);
     
-    // Generate dew level reading
-    double currentDewLevel = dewLevelDistribution(randomNumberGenerator);
-    
-    // Check for sudden rain burst (drop > 30%)
-    currentSensorData.isSuddenRainBurst = (previousSensorReading - currentSensorReading) > 30.0;
+    // Check for sudden rain burst (drop > 30% with the default calibration)
+    currentSensorData.isSuddenRainBurst = (subscribedChannels & CHANNEL_BURST) != 0 &&
+                                          (previousSensorReading - currentSensorReading) > suddenBurstDeltaPercentage;
     
     // Check for dew presence (dew level > 60% indicates dew formation)
     currentSensorData.isDewPresent = (currentDewLevel > 60.0);
     currentSensorData.dewLevel = currentDewLevel;
     
-    currentSensorData.lightPercentage = currentSensorReading;
+    currentSensorData.lightPercentage = ((subscribedChannels & CHANNEL_LIGHT) != 0) ? currentSensorReading : 0.0;
     currentSensorData.isValidReading = (currentSensorReading >= 0.0 && currentSensorReading <= 100.0);
     
-    previousSensorReading = currentSensorReading;
+    if ((subscribedChannels & (CHANNEL_LIGHT | CHANNEL_BURST)) != 0) {
+        previousSensorReading = currentSensorReading;
+    }
     return currentSensorData;
 }
 
+void RainSensor::readSensorBatch(SensorReadingData* sensorReadings, std::size_t readingCount) {
+    if (randomNumberGenerator) {
+        for (std::size_t readingIndex = 0; readingIndex < readingCount; readingIndex++) {
+            sensorReadings[readingIndex] = readSensorData();
+        }
+        return;
+    }
+    
+    const std::size_t BATCH_CHUNK_SIZE = 256;
+    std::uint32_t failureWords[BATCH_CHUNK_SIZE];
+    std::uint32_t lightWords[BATCH_CHUNK_SIZE];
+    std::uint32_t dewWords[BATCH_CHUNK_SIZE];
+    std::uint32_t unusedWords[BATCH_CHUNK_SIZE];
+    double lightPercentages[BATCH_CHUNK_SIZE + 1];
+    double dewLevels[BATCH_CHUNK_SIZE];
+    
+    bool isFailureNeeded = (subscribedChannels & CHANNEL_FAILURE) != 0;
+    bool isLightNeeded = (subscribedChannels & (CHANNEL_LIGHT | CHANNEL_BURST)) != 0;
+    bool isDewNeeded = (subscribedChannels & CHANNEL_DEW) != 0;
+    bool isBurstReported = (subscribedChannels & CHANNEL_BURST) != 0;
+    double lightReportScale = ((subscribedChannels & CHANNEL_LIGHT) != 0) ? 1.0 : 0.0;
+    
+    for (std::size_t chunkStart = 0; chunkStart < readingCount; chunkStart += BATCH_CHUNK_SIZE) {
+        std::size_t chunkSize = std::min(BATCH_CHUNK_SIZE, readingCount - chunkStart);
+        
+        // Failure latches, so only the readings before the first failure draw are valid
+        // (a failed sensor's draws are never used, so they are not generated either)
+        std::size_t validCount = 0;
+        if (!isSensorInFailureState && (isFailureNeeded || isLightNeeded || isDewNeeded)) {
+            CounterBasedRandom::generateBlocks(randomSeed, randomStreamId, tickIndex, chunkSize,
+                                               failureWords, lightWords, dewWords, unusedWords);
+        }
+        if (!isSensorInFailureState) {
+            validCount = chunkSize;
+            if (isFailureNeeded) {
+                validCount = 0;
+                while (validCount < chunkSize && CounterBasedRandom::convertToUnitInterval(failureWords[validCount]) >= 0.01) {
+                    validCount++;
+                }
+                isSensorInFailureState = (validCount < chunkSize);
+            }
+        }
+        tickIndex += chunkSize;
+        
+        // lightPercentages[i] is the reading before reading i, so burst checks need no carried state
+        // Unsubscribed channels are zero-filled rather than converted
+        lightPercentages[0] = previousSensorReading;
+        for (std::size_t readingIndex = 0; readingIndex < validCount; readingIndex++) {
+            lightPercentages[readingIndex + 1] = isLightNeeded ?
+                CounterBasedRandom::convertToUnitInterval(lightWords[readingIndex]) * 100.0 : 0.0;
+        }
+        for (std::size_t readingIndex = 0; readingIndex < validCount; readingIndex++) {
+            dewLevels[readingIndex] = isDewNeeded ?
+                CounterBasedRandom::convertToUnitInterval(dewWords[readingIndex]) * 100.0 : 0.0;
+        }
+        if (isLightNeeded) {
+            previousSensorReading = lightPercentages[validCount];
+        }
+        
+        SensorReadingData* chunkReadings = sensorReadings + chunkStart;
+        for (std::size_t readingIndex = 0; readingIndex < validCount; readingIndex++) {
+            chunkReadings[readingIndex].lightPercentage = lightPercentages[readingIndex + 1] * lightReportScale;
+            chunkReadings[readingIndex].isValidReading = true;
+            chunkReadings[readingIndex].isSuddenRainBurst = isBurstReported &
+                ((lightPercentages[readingIndex] - lightPercentages[readingIndex + 1]) > suddenBurstDeltaPercentage);
+            chunkReadings[readingIndex].isDewPresent = dewLevels[readingIndex] > 60.0;
+            chunkReadings[readingIndex].dewLevel = dewLevels[readingIndex];
+        }
+        for (std::size_t readingIndex = validCount; readingIndex < chunkSize; readingIndex++) {
+            chunkReadings[readingIndex].lightPercentage = -1.0;
+            chunkReadings[readingIndex].isValidReading = false;
+            chunkReadings[readingIndex].isSuddenRainBurst = false;
+            chunkReadings[readingIndex].isDewPresent = false;
+            chunkReadings[readingIndex].dewLevel = 0.0;
+        }
+    }
+}
+
+RainSensor::QuantizedReadingData RainSensor::readQuantizedSensorData() {
+    return quantizeReading(readSensorData());
+}
+
+void RainSensor::readQuantizedSensorBatch(QuantizedReadingData* sensorReadings, std::size_t readingCount) {
+    // Generated at full precision so the burst flags match readSensorBatch(), then narrowed
+    const std::size_t QUANTIZE_CHUNK_SIZE = 256;
+    SensorReadingData chunkReadings[QUANTIZE_CHUNK_SIZE];
+    for (std::size_t chunkStart = 0; chunkStart < readingCount; chunkStart += QUANTIZE_CHUNK_SIZE) {
+        std::size_t chunkSize = std::min(QUANTIZE_CHUNK_SIZE, readingCount - chunkStart);
+        readSensorBatch(chunkReadings, chunkSize);
+        for (std::size_t readingIndex = 0; readingIndex < chunkSize; readingIndex++) {
+            sensorReadings[chunkStart + readingIndex] = quantizeReading(chunkReadings[readingIndex]);
+        }
+    }
+}
+
+std::uint16_t RainSensor::quantizePercentage(double percentage) {
+    if (!(percentage >= 0.0)) {
+        return INVALID_QUANTIZED_PERCENTAGE;
+    }
+    if (percentage >= 100.0) {
+        return QUANTIZED_FULL_SCALE;
+    }
+    return static_cast<std::uint16_t>(percentage * QUANTIZED_UNITS_PER_PERCENT);
+}
+
+double RainSensor::dequantizePercentage(std::uint16_t centiPercent) {
+    if (centiPercent == INVALID_QUANTIZED_PERCENTAGE) {
+        return -1.0;
+    }
+    return static_cast<double>(centiPercent) / QUANTIZED_UNITS_PER_PERCENT;
+}
+
+RainSensor::QuantizedReadingData RainSensor::quantizeReading(const SensorReadingData& sensorData) {
+    QuantizedReadingData quantizedData;
+    quantizedData.lightCentiPercent = quantizePercentage(sensorData.lightPercentage);
+    quantizedData.dewLevelCentiPercent = quantizePercentage(sensorData.dewLevel);
+    quantizedData.isValidReading = sensorData.isValidReading;
+    quantizedData.isSuddenRainBurst = sensorData.isSuddenRainBurst;
+    quantizedData.isDewPresent = sensorData.isDewPresent;
+    return quantizedData;
+}
+
+RainSensor::SensorReadingData RainSensor::dequantizeReading(const QuantizedReadingData& sensorData) {
+    SensorReadingData expandedData;
+    expandedData.lightPercentage = dequantizePercentage(sensorData.lightCentiPercent);
+    expandedData.isValidReading = sensorData.isValidReading;
+    expandedData.isSuddenRainBurst = sensorData.isSuddenRainBurst;
+    expandedData.isDewPresent = sensorData.isDewPresent;
+    expandedData.dewLevel = dequantizePercentage(sensorData.dewLevelCentiPercent);
+    return expandedData;
+}
+
 void RainSensor::resetSensorFailureState() {
     isSensorInFailureState = false;
-}
\ No newline at end of file
+}
+
+void RainSensor::subscribeChannels(std::uint8_t channelMask) {
+    subscribedChannels = static_cast<std::uint8_t>(channelMask & CHANNEL_ALL);
+}
+
+std::uint8_t RainSensor::getSubscribedChannels() const {
+    return subscribedChannels;
+}
+
+double RainSensor::getSuddenBurstDeltaPercentage() const {
+    return suddenBurstDeltaPercentage;
+}
+
+bool RainSensor::isCounterBased() const {
+    return !randomNumberGenerator;
+}
+
+std::uint64_t RainSensor::getTickIndex() const {
+    return tickIndex;
+}
+
+void RainSensor::seekToTick(std::uint64_t newTickIndex) {
+    if (randomNumberGenerator) {
+        return;
+    }
+    
+    // Burst detection compares against the previous tick, which is one block away
+    previousSensorReading = 95.0;
+    if (newTickIndex > 0) {
+        CounterBasedRandom::RandomBlock previousBlock = CounterBasedRandom::generateBlock(randomSeed, randomStreamId, newTickIndex - 1);
+        previousSensorReading = CounterBasedRandom::convertToUnitInterval(previousBlock.words[1]) * 100.0;
+    }
+    tickIndex = newTickIndex;
+    isSensorInFailureState = false;
+}
@@ -3,25 +3,64 @@
 
 #include <random>
 #include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include "WiperCalibration.h"
 
 /**
  * @brief RainSensor class to simulate rain detection sensor
+ *
+ * The default constructor keeps the original behaviour: a Mersenne Twister seeded
+ * from the clock. The seeded constructor switches to a counter-based generator, so
+ * a sensor needs only a few bytes of state, every (seed, stream) pair is an
+ * independent reproducible sequence, and any tick can be reached with seekToTick().
  */
 class RainSensor {
+public:
+    // Channel bits for subscribeChannels()
+    static const std::uint8_t CHANNEL_LIGHT = 0x01;   // lightPercentage
+    static const std::uint8_t CHANNEL_BURST = 0x02;   // isSuddenRainBurst
+    static const std::uint8_t CHANNEL_DEW = 0x04;     // isDewPresent and dewLevel
+    static const std::uint8_t CHANNEL_FAILURE = 0x08; // Simulated sensor failures
+    static const std::uint8_t CHANNEL_ALL = 0x0F;
+
+    // Quantized readings carry percentages as 0.01 % units in a uint16_t
+    static const std::uint16_t QUANTIZED_UNITS_PER_PERCENT = 100;
+    static const std::uint16_t QUANTIZED_FULL_SCALE = 10000;           // 100 %
+    static const std::uint16_t INVALID_QUANTIZED_PERCENTAGE = 0xFFFF;  // Replaces the -1 of an invalid reading
+
 private:
-    std::mt19937 randomNumberGenerator;
-    std::uniform_real_distribution<double> lightPercentageDistribution;
-    std::uniform_real_distribution<double> sensorFailureDistribution;
-    std::uniform_real_distribution<double> dewLevelDistribution;
+    std::unique_ptr<std::mt19937> randomNumberGenerator; // Only allocated for the clock-seeded mode
+    std::uint64_t randomSeed;
+    std::uint64_t randomStreamId;
+    std::uint64_t tickIndex;
     double previousSensorReading;
+    double suddenBurstDeltaPercentage;
     bool isSensorInFailureState;
+    std::uint8_t subscribedChannels;
+
+    /**
+     * @brief Draw the raw values used for one reading (unsubscribed values are not drawn)
+     * @param failureDraw Receives the failure check value in [0, 1)
+     * @param lightPercentage Receives the light reading in [0, 100)
+     * @param dewLevel Receives the dew level in [0, 100)
+     */
+    void drawRandomValues(double& failureDraw, double& lightPercentage, double& dewLevel);
 
 public:
     /**
-     * @brief Constructor for RainSensor
+     * @brief Constructor for RainSensor (clock-seeded, not reproducible)
      */
     RainSensor();
 
+    /**
+     * @brief Constructor for a reproducible counter-based RainSensor
+     * @param seed Seed shared by a set of sensors
+     * @param streamId Independent stream for this sensor (e.g. vehicle index)
+     */
+    RainSensor(std::uint64_t seed, std::uint64_t streamId);
+
     /**
      * @brief Structure to hold sensor reading data
      */
@@ -33,16 +72,147 @@ public:
         double dewLevel;
     };
 
+    /**
+     * @brief Structure to hold a sensor reading in fixed point (8 bytes instead of 24)
+     *
+     * Percentages are truncated to 0.01 %, so comparing against a threshold on that
+     * grid (every shipped calibration uses whole percents) gives the same answer as
+     * the double reading. The flags are taken from the full-precision reading.
+     */
+    struct QuantizedReadingData {
+        std::uint16_t lightCentiPercent;    // INVALID_QUANTIZED_PERCENTAGE when the reading is invalid
+        std::uint16_t dewLevelCentiPercent;
+        bool isValidReading;
+        bool isSuddenRainBurst;
+        bool isDewPresent;
+    };
+
     /**
      * @brief Read current sensor data
      * @return SensorReadingData containing current sensor information
      */
     SensorReadingData readSensorData();
 
+    /**
+     * @brief Read current sensor data in fixed point
+     * @return The reading readSensorData() would return, quantized
+     */
+    QuantizedReadingData readQuantizedSensorData();
+
+    /**
+     * @brief Read many consecutive readings in one call
+     * @param sensorReadings Output array receiving one reading per tick
+     * @param readingCount Number of readings to produce
+     *
+     * In counter-based mode the random values are generated in blocks and the
+     * burst/dew/failure flags are computed without branches; the result is identical
+     * to calling readSensorData() readingCount times. The clock-seeded mode falls
+     * back to the scalar path.
+     */
+    void readSensorBatch(SensorReadingData* sensorReadings, std::size_t readingCount);
+
+    /**
+     * @brief Read many consecutive readings in fixed point
+     * @param sensorReadings Output array receiving one quantized reading per tick
+     * @param readingCount Number of readings to produce
+     */
+    void readQuantizedSensorBatch(QuantizedReadingData* sensorReadings, std::size_t readingCount);
+
+    /**
+     * @brief Convert a percentage to 0.01 % units
+     * @param percentage Percentage in [0, 100]; negative or NaN marks an invalid reading
+     * @return Truncated value clamped to QUANTIZED_FULL_SCALE, or INVALID_QUANTIZED_PERCENTAGE
+     */
+    static std::uint16_t quantizePercentage(double percentage);
+
+    /**
+     * @brief Convert 0.01 % units back to a percentage
+     * @param centiPercent Quantized value
+     * @return Percentage, or -1 for INVALID_QUANTIZED_PERCENTAGE
+     */
+    static double dequantizePercentage(std::uint16_t centiPercent);
+
+    /**
+     * @brief Convert a threshold to 0.01 % units, rounding up
+     * @param thresholdPercentage Threshold in [0, 100]; callers must range-check first, since
+     *        values outside it do not fit the 16-bit result
+     * @return Smallest quantized value that reaches the threshold
+     */
+    static constexpr std::uint16_t quantizeThreshold(double thresholdPercentage) {
+        return static_cast<std::uint16_t>(static_cast<std::uint16_t>(thresholdPercentage * QUANTIZED_UNITS_PER_PERCENT) +
+            ((static_cast<std::uint16_t>(thresholdPercentage * QUANTIZED_UNITS_PER_PERCENT) < thresholdPercentage * QUANTIZED_UNITS_PER_PERCENT) ? 1 : 0));
+    }
+
+    /**
+     * @brief Quantize a full-precision reading
+     * @param sensorData Reading to convert
+     * @return Fixed-point reading with the same flags
+     */
+    static QuantizedReadingData quantizeReading(const SensorReadingData& sensorData);
+
+    /**
+     * @brief Expand a fixed-point reading
+     * @param sensorData Quantized reading
+     * @return Reading with percentages on the 0.01 % grid
+     */
+    static SensorReadingData dequantizeReading(const QuantizedReadingData& sensorData);
+
     /**
      * @brief Reset sensor failure state
      */
     void resetSensorFailureState();
+
+    /**
+     * @brief Declare which channels the consumer needs (all by default)
+     * @param channelMask Combination of CHANNEL_* bits
+     *
+     * Unsubscribed channels are not generated: their fields read as 0 or false, and
+     * without CHANNEL_FAILURE the sensor never fails. In counter-based mode the
+     * subscribed channels keep exactly the values they would have with all channels.
+     */
+    void subscribeChannels(std::uint8_t channelMask);
+
+    /**
+     * @brief Get the channels currently generated
+     * @return Combination of CHANNEL_* bits
+     */
+    std::uint8_t getSubscribedChannels() const;
+
+    /**
+     * @brief Take the sudden rain burst threshold from a calibration policy
+     * @tparam CalibrationPolicy Policy with SUDDEN_BURST_DELTA_PERCENTAGE (see DefaultWiperCalibration)
+     */
+    template <typename CalibrationPolicy>
+    void applyCalibration() {
+        suddenBurstDeltaPercentage = CalibrationPolicy::SUDDEN_BURST_DELTA_PERCENTAGE;
+    }
+
+    /**
+     * @brief Get the drop in light percentage that is reported as a sudden rain burst
+     * @return Burst threshold in percentage points
+     */
+    double getSuddenBurstDeltaPercentage() const;
+
+    /**
+     * @brief Check if the sensor uses the reproducible counter-based generator
+     * @return True if constructed with a seed
+     */
+    bool isCounterBased() const;
+
+    /**
+     * @brief Get the index of the next reading
+     * @return Number of readings taken (or sought past)
+     */
+    std::uint64_t getTickIndex() const;
+
+    /**
+     * @brief Jump to a tick without generating the readings before it (counter-based mode only)
+     * @param newTickIndex Tick whose reading readSensorData() returns next
+     *
+     * Clears the failure state; the reading then matches a sequential run that had
+     * no sensor failure before that tick.
+     */
+    void seekToTick(std::uint64_t newTickIndex);
 };
 
-#endif // RAIN_SENSOR_H
\ No newline at end of file
+#endif // RAIN_SENSOR_H
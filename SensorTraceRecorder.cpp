@@ -0,0 +1,156 @@
+#include "SensorTraceRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char SENSOR_TRACE_MAGIC[8] = {'W', 'I', 'P', 'T', 'R', 'A', 'C', 'E'};
+
+} // namespace
+
+SensorTraceRecorder::SensorTraceRecorder()
+    : traceFile(nullptr),
+      recordBuffer(RECORD_BUFFER_CAPACITY),
+      bufferedRecordCount(0),
+      recordedCount(0),
+      recordingStartTime(),
+      hasWriteFailed(false) {
+}
+
+SensorTraceRecorder::~SensorTraceRecorder() {
+    close();
+}
+
+bool SensorTraceRecorder::open(const std::string& traceFilePath, TimePoint newRecordingStartTime) {
+    close();
+
+    traceFile = std::fopen(traceFilePath.c_str(), "wb");
+    if (traceFile == nullptr) {
+        return false;
+    }
+    // Records are already batched, so stdio buffering would only add a second copy
+    std::setvbuf(traceFile, nullptr, _IONBF, 0);
+
+    recordingStartTime = newRecordingStartTime;
+    bufferedRecordCount = 0;
+    recordedCount = 0;
+    hasWriteFailed = false;
+
+    SensorTraceFileHeader fileHeader;
+    std::memcpy(fileHeader.magic, SENSOR_TRACE_MAGIC, sizeof(fileHeader.magic));
+    fileHeader.formatVersion = FILE_FORMAT_VERSION;
+    fileHeader.recordSize = static_cast<std::uint32_t>(sizeof(SensorTraceRecord));
+    fileHeader.recordingStartNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        recordingStartTime.time_since_epoch()).count();
+    fileHeader.wallStartNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    if (std::fwrite(&fileHeader, sizeof(fileHeader), 1, traceFile) != 1) {
+        std::fclose(traceFile);
+        traceFile = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void SensorTraceRecorder::close() {
+    if (traceFile == nullptr) {
+        return;
+    }
+    flush();
+    std::fclose(traceFile);
+    traceFile = nullptr;
+}
+
+bool SensorTraceRecorder::isOpen() const {
+    return traceFile != nullptr && !hasWriteFailed;
+}
+
+void SensorTraceRecorder::recordReading(TimePoint currentTime, const RainSensor::SensorReadingData& sensorData,
+                                        const WindshieldWiperController& wiperController) {
+    recordReading(currentTime, RainSensor::quantizeReading(sensorData), wiperController);
+}
+
+void SensorTraceRecorder::recordReading(TimePoint currentTime, const RainSensor::QuantizedReadingData& sensorData,
+                                        const WindshieldWiperController& wiperController) {
+    if (!isOpen()) {
+        return;
+    }
+
+    SensorTraceRecord& traceRecord = beginRecord(currentTime, wiperController);
+    traceRecord.lightCentiPercent = sensorData.lightCentiPercent;
+    traceRecord.dewLevelCentiPercent = sensorData.dewLevelCentiPercent;
+    traceRecord.sensorFlags = static_cast<std::uint8_t>(
+        (sensorData.isValidReading ? SensorTraceRecord::FLAG_VALID_READING : 0) |
+        (sensorData.isSuddenRainBurst ? SensorTraceRecord::FLAG_SUDDEN_RAIN_BURST : 0) |
+        (sensorData.isDewPresent ? SensorTraceRecord::FLAG_DEW_PRESENT : 0));
+    commitRecord();
+}
+
+void SensorTraceRecorder::recordStateResync(TimePoint currentTime, const WindshieldWiperController& wiperController) {
+    if (!isOpen()) {
+        return;
+    }
+
+    SensorTraceRecord& traceRecord = beginRecord(currentTime, wiperController);
+    traceRecord.lightCentiPercent = RainSensor::INVALID_QUANTIZED_PERCENTAGE;
+    traceRecord.dewLevelCentiPercent = 0;
+    traceRecord.sensorFlags = SensorTraceRecord::FLAG_STATE_RESYNC;
+    commitRecord();
+}
+
+SensorTraceRecord& SensorTraceRecorder::beginRecord(TimePoint currentTime, const WindshieldWiperController& wiperController) {
+    std::int64_t elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        currentTime - recordingStartTime).count();
+
+    SensorTraceRecord& traceRecord = recordBuffer[bufferedRecordCount];
+    traceRecord.timestampNanoseconds = static_cast<std::uint64_t>(elapsedNanoseconds > 0 ? elapsedNanoseconds : 0);
+    traceRecord.wiperSpeed = static_cast<std::uint8_t>(wiperController.getCurrentWiperSpeed());
+    traceRecord.waterSprayMode = static_cast<std::uint8_t>(wiperController.getCurrentWaterSprayMode());
+    traceRecord.operatingMode = static_cast<std::uint8_t>(wiperController.getCurrentOperatingMode());
+    traceRecord.isWaitingToTurnOff = wiperController.isWaitingToTurnOffWipers() ? 1 : 0;
+    traceRecord.remainingTurnOffSeconds = static_cast<std::uint8_t>(wiperController.getRemainingTurnOffSeconds(currentTime));
+    std::memset(traceRecord.reserved, 0, sizeof(traceRecord.reserved));
+
+    // Saturating is exact for replay: any countdown older than the turn-off delay has already expired
+    traceRecord.turnOffElapsedMicroseconds = 0;
+    if (wiperController.isWaitingToTurnOffWipers()) {
+        std::int64_t countdownMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+            currentTime - wiperController.getTurnOffStartTime()).count();
+        const std::int64_t maximumMicroseconds = std::numeric_limits<std::uint32_t>::max();
+        traceRecord.turnOffElapsedMicroseconds = static_cast<std::uint32_t>(
+            countdownMicroseconds <= 0 ? 0 : std::min(countdownMicroseconds, maximumMicroseconds));
+    }
+    return traceRecord;
+}
+
+void SensorTraceRecorder::commitRecord() {
+    bufferedRecordCount++;
+    recordedCount++;
+    if (bufferedRecordCount == RECORD_BUFFER_CAPACITY) {
+        flush();
+    }
+}
+
+bool SensorTraceRecorder::flush() {
+    if (traceFile == nullptr || hasWriteFailed) {
+        return false;
+    }
+    if (bufferedRecordCount > 0 &&
+        std::fwrite(recordBuffer.data(), sizeof(SensorTraceRecord), bufferedRecordCount, traceFile) != bufferedRecordCount) {
+        // Disk full or similar - stop recording instead of retrying on every tick
+        hasWriteFailed = true;
+    }
+    bufferedRecordCount = 0;
+    return !hasWriteFailed;
+}
+
+std::uint64_t SensorTraceRecorder::getRecordedCount() const {
+    return recordedCount;
+}
+
+bool SensorTraceRecorder::isValidFileHeader(const SensorTraceFileHeader& fileHeader) {
+    return std::memcmp(fileHeader.magic, SENSOR_TRACE_MAGIC, sizeof(fileHeader.magic)) == 0 &&
+           fileHeader.formatVersion == FILE_FORMAT_VERSION &&
+           fileHeader.recordSize == sizeof(SensorTraceRecord);
+}
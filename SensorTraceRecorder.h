@@ -0,0 +1,163 @@
+#ifndef SENSOR_TRACE_RECORDER_H
+#define SENSOR_TRACE_RECORDER_H
+
+#include "RainSensor.h"
+#include "WindshieldWiperController.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Structure for the sensor trace file header (written once, never rewritten)
+ */
+struct SensorTraceFileHeader {
+    char magic[8];                         // "WIPTRACE"
+    std::uint32_t formatVersion;
+    std::uint32_t recordSize;
+    std::int64_t recordingStartNanoseconds; // steady_clock time that record timestamps are relative to
+    std::int64_t wallStartNanoseconds;      // system_clock time at the same instant
+};
+
+/**
+ * @brief Structure for one fixed-size sensor trace record (24 bytes)
+ *
+ * Percentages are stored in 0.01 % units (see RainSensor::QuantizedReadingData); the
+ * flags keep the full-precision burst decision, so replays reach the same speeds.
+ * A FLAG_STATE_RESYNC record carries no reading, only the controller state after a
+ * mode or setting change, so replays can follow manual intervals.
+ */
+struct SensorTraceRecord {
+    static const std::uint8_t FLAG_VALID_READING = 0x01;
+    static const std::uint8_t FLAG_SUDDEN_RAIN_BURST = 0x02;
+    static const std::uint8_t FLAG_DEW_PRESENT = 0x04;
+    static const std::uint8_t FLAG_STATE_RESYNC = 0x08;
+
+    std::uint64_t timestampNanoseconds; // Time since the recording started
+    std::uint16_t lightCentiPercent;    // RainSensor::INVALID_QUANTIZED_PERCENTAGE for invalid readings
+    std::uint16_t dewLevelCentiPercent;
+    std::uint8_t sensorFlags;           // FLAG_* bits of the reading
+    std::uint8_t wiperSpeed;            // Controller state after processing the reading
+    std::uint8_t waterSprayMode;
+    std::uint8_t operatingMode;
+    std::uint8_t isWaitingToTurnOff;
+    std::uint8_t remainingTurnOffSeconds;
+    std::uint8_t reserved[2];
+    std::uint32_t turnOffElapsedMicroseconds; // Time since the countdown started (saturating)
+};
+
+/**
+ * @brief SensorTraceRecorder class to persist every sensor reading for later replay
+ *
+ * Records are appended to a preallocated buffer and written with a single fwrite
+ * once the buffer fills, so the cost of one tick is bounded by one buffer write.
+ * The file is never seeked or rewritten, so recordings can grow past 4 GB.
+ */
+class SensorTraceRecorder {
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    static const std::uint32_t FILE_FORMAT_VERSION = 3;     // 2: fixed-point percentages, 3: state resync records
+    static const std::size_t RECORD_BUFFER_CAPACITY = 2048; // 48 KB per write
+
+    /**
+     * @brief Constructor for SensorTraceRecorder (closed until open() is called)
+     */
+    SensorTraceRecorder();
+
+    /**
+     * @brief Destructor that writes buffered records and closes the file
+     */
+    ~SensorTraceRecorder();
+
+    /**
+     * @brief Create the trace file and write its header
+     * @param traceFilePath Path of the trace to create
+     * @param recordingStartTime Time that record timestamps are measured from
+     * @return True if the file could be created
+     */
+    bool open(const std::string& traceFilePath, TimePoint recordingStartTime);
+
+    /**
+     * @brief Write buffered records and close the file
+     */
+    void close();
+
+    /**
+     * @brief Check if readings are being recorded
+     * @return True if open and no write has failed
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Append one reading and the controller state it produced
+     * @param currentTime When the reading was taken
+     * @param sensorData The sensor reading
+     * @param wiperController Controller after processing the reading
+     */
+    void recordReading(TimePoint currentTime, const RainSensor::SensorReadingData& sensorData,
+                       const WindshieldWiperController& wiperController);
+
+    /**
+     * @brief Append one fixed-point reading and the controller state it produced
+     * @param currentTime When the reading was taken
+     * @param sensorData The quantized sensor reading (stored as is)
+     * @param wiperController Controller after processing the reading
+     */
+    void recordReading(TimePoint currentTime, const RainSensor::QuantizedReadingData& sensorData,
+                       const WindshieldWiperController& wiperController);
+
+    /**
+     * @brief Append the controller state after a mode or setting change
+     * @param currentTime When the change was made
+     * @param wiperController Controller after the change
+     */
+    void recordStateResync(TimePoint currentTime, const WindshieldWiperController& wiperController);
+
+    /**
+     * @brief Write buffered records to the file now
+     * @return True if the write succeeded
+     */
+    bool flush();
+
+    /**
+     * @brief Get the number of records accepted since open()
+     * @return Record count
+     */
+    std::uint64_t getRecordedCount() const;
+
+    /**
+     * @brief Check that a header belongs to a trace this build can read
+     * @param fileHeader Header read from the start of a trace file
+     * @return True if magic, version and record size match
+     */
+    static bool isValidFileHeader(const SensorTraceFileHeader& fileHeader);
+
+private:
+    SensorTraceRecorder(const SensorTraceRecorder&);
+    SensorTraceRecorder& operator=(const SensorTraceRecorder&);
+
+    /**
+     * @brief Fill the next buffered record's timestamp and controller state
+     * @param currentTime Time of the record
+     * @param wiperController Controller whose state is stored
+     * @return The record, for the caller to add the reading and flags
+     */
+    SensorTraceRecord& beginRecord(TimePoint currentTime, const WindshieldWiperController& wiperController);
+
+    /**
+     * @brief Count the record begun by beginRecord() and write the buffer once it is full
+     */
+    void commitRecord();
+
+    std::FILE* traceFile;
+    std::vector<SensorTraceRecord> recordBuffer;
+    std::size_t bufferedRecordCount;
+    std::uint64_t recordedCount;
+    TimePoint recordingStartTime;
+    bool hasWriteFailed;
+};
+
+#endif // SENSOR_TRACE_RECORDER_H
@@ -0,0 +1,235 @@
+#include "SensorTraceReplayer.h"
+#include "WiperEnums.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SensorTraceReplayer::SensorTraceReplayer()
+    : mappedData(nullptr),
+      mappedSize(0),
+      traceRecords(nullptr),
+      recordCount(0),
+      nextRecordIndex(0) {
+}
+
+SensorTraceReplayer::~SensorTraceReplayer() {
+    close();
+}
+
+bool SensorTraceReplayer::open(const std::string& traceFilePath) {
+    close();
+
+    const unsigned char* fileData = nullptr;
+    std::size_t fileSize = 0;
+
+#if !defined(_WIN32)
+    int fileDescriptor = ::open(traceFilePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size < static_cast<off_t>(sizeof(SensorTraceFileHeader))) {
+        ::close(fileDescriptor);
+        return false;
+    }
+    fileSize = static_cast<std::size_t>(fileStatus.st_size);
+    void* mappingAddress = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    ::close(fileDescriptor); // The mapping keeps the file alive
+    if (mappingAddress == MAP_FAILED) {
+        return false;
+    }
+    madvise(mappingAddress, fileSize, MADV_SEQUENTIAL);
+    mappedData = mappingAddress;
+    mappedSize = fileSize;
+    fileData = static_cast<const unsigned char*>(mappingAddress);
+#else
+    std::FILE* traceFile = std::fopen(traceFilePath.c_str(), "rb");
+    if (traceFile == nullptr) {
+        return false;
+    }
+    unsigned char readChunk[65536];
+    std::size_t chunkSize;
+    while ((chunkSize = std::fread(readChunk, 1, sizeof(readChunk), traceFile)) > 0) {
+        loadedData.insert(loadedData.end(), readChunk, readChunk + chunkSize);
+    }
+    std::fclose(traceFile);
+    fileSize = loadedData.size();
+    fileData = loadedData.data();
+#endif
+
+    SensorTraceFileHeader fileHeader;
+    if (fileSize < sizeof(fileHeader)) {
+        close();
+        return false;
+    }
+    std::memcpy(&fileHeader, fileData, sizeof(fileHeader));
+    if (!SensorTraceRecorder::isValidFileHeader(fileHeader)) {
+        close();
+        return false;
+    }
+
+    // The header and records are both 8-byte multiples, so records stay aligned in place
+    traceRecords = reinterpret_cast<const SensorTraceRecord*>(fileData + sizeof(fileHeader));
+    recordCount = (fileSize - sizeof(fileHeader)) / sizeof(SensorTraceRecord);
+    nextRecordIndex = 0;
+    return true;
+}
+
+void SensorTraceReplayer::close() {
+#if !defined(_WIN32)
+    if (mappedData != nullptr) {
+        munmap(mappedData, mappedSize);
+    }
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+    std::vector<unsigned char>().swap(loadedData);
+    traceRecords = nullptr;
+    recordCount = 0;
+    nextRecordIndex = 0;
+}
+
+bool SensorTraceReplayer::isOpen() const {
+    return traceRecords != nullptr;
+}
+
+std::uint64_t SensorTraceReplayer::getRecordCount() const {
+    return recordCount;
+}
+
+const SensorTraceRecord& SensorTraceReplayer::getRecord(std::uint64_t recordIndex) const {
+    return traceRecords[recordIndex];
+}
+
+bool SensorTraceReplayer::readNextReading(RainSensor::SensorReadingData& sensorData) {
+    while (nextRecordIndex < recordCount &&
+           (traceRecords[nextRecordIndex].sensorFlags & SensorTraceRecord::FLAG_STATE_RESYNC) != 0) {
+        nextRecordIndex++;
+    }
+    if (nextRecordIndex >= recordCount) {
+        return false;
+    }
+    sensorData = convertToSensorReading(traceRecords[nextRecordIndex]);
+    nextRecordIndex++;
+    return true;
+}
+
+bool SensorTraceReplayer::readNextReading(RainSensor::SensorReadingData& sensorData, WindshieldWiperController& wiperController,
+                                          std::chrono::steady_clock::time_point currentTime) {
+    std::uint64_t readingIndex = nextRecordIndex;
+    while (readingIndex < recordCount &&
+           (traceRecords[readingIndex].sensorFlags & SensorTraceRecord::FLAG_STATE_RESYNC) != 0) {
+        readingIndex++;
+    }
+
+    // The trace clock is shifted so the next recorded reading lands on currentTime
+    std::int64_t readingNanoseconds = (readingIndex < recordCount) ?
+        static_cast<std::int64_t>(traceRecords[readingIndex].timestampNanoseconds) : 0;
+    for (; nextRecordIndex < readingIndex; nextRecordIndex++) {
+        const SensorTraceRecord& resyncRecord = traceRecords[nextRecordIndex];
+        std::int64_t leadNanoseconds = (readingIndex < recordCount) ?
+            readingNanoseconds - static_cast<std::int64_t>(resyncRecord.timestampNanoseconds) : 0;
+        applyStateResync(resyncRecord, wiperController, currentTime - std::chrono::nanoseconds(leadNanoseconds));
+    }
+    return readNextReading(sensorData);
+}
+
+void SensorTraceReplayer::rewind() {
+    nextRecordIndex = 0;
+}
+
+RainSensor::SensorReadingData SensorTraceReplayer::convertToSensorReading(const SensorTraceRecord& traceRecord) {
+    return RainSensor::dequantizeReading(convertToQuantizedReading(traceRecord));
+}
+
+RainSensor::QuantizedReadingData SensorTraceReplayer::convertToQuantizedReading(const SensorTraceRecord& traceRecord) {
+    RainSensor::QuantizedReadingData sensorData;
+    sensorData.lightCentiPercent = traceRecord.lightCentiPercent;
+    sensorData.dewLevelCentiPercent = traceRecord.dewLevelCentiPercent;
+    sensorData.isValidReading = (traceRecord.sensorFlags & SensorTraceRecord::FLAG_VALID_READING) != 0;
+    sensorData.isSuddenRainBurst = (traceRecord.sensorFlags & SensorTraceRecord::FLAG_SUDDEN_RAIN_BURST) != 0;
+    sensorData.isDewPresent = (traceRecord.sensorFlags & SensorTraceRecord::FLAG_DEW_PRESENT) != 0;
+    return sensorData;
+}
+
+void SensorTraceReplayer::applyStateResync(const SensorTraceRecord& traceRecord, WindshieldWiperController& wiperController,
+                                           std::chrono::steady_clock::time_point resyncTime) {
+    wiperController.restoreState(static_cast<WindshieldWiperSpeed>(traceRecord.wiperSpeed),
+                                 static_cast<WaterSprayMode>(traceRecord.waterSprayMode),
+                                 static_cast<OperatingMode>(traceRecord.operatingMode),
+                                 traceRecord.isWaitingToTurnOff != 0,
+                                 resyncTime - std::chrono::microseconds(traceRecord.turnOffElapsedMicroseconds));
+}
+
+SensorTraceReplayer::ReplayStatistics SensorTraceReplayer::replayThroughController(
+    WindshieldWiperController& wiperController, std::ostream* timelineStream) const {
+    ReplayStatistics replayStatistics;
+    std::memset(&replayStatistics, 0, sizeof(replayStatistics));
+
+    std::ios::fmtflags previousFlags;
+    std::streamsize previousPrecision = 0;
+    if (timelineStream != nullptr) {
+        previousFlags = timelineStream->flags();
+        previousPrecision = timelineStream->precision();
+        *timelineStream << std::fixed << std::setprecision(3);
+    }
+
+    wiperController.setOperatingMode(OperatingMode::AUTOMATIC);
+    bool hasPreviousState = false;
+    WindshieldWiperSpeed previousSpeed = WindshieldWiperSpeed::OFF;
+    WaterSprayMode previousSprayMode = WaterSprayMode::OFF;
+
+    std::chrono::steady_clock::time_point replayStartTime = std::chrono::steady_clock::now();
+    for (std::uint64_t recordIndex = 0; recordIndex < recordCount; recordIndex++) {
+        const SensorTraceRecord& traceRecord = traceRecords[recordIndex];
+        std::chrono::steady_clock::time_point recordedTime =
+            std::chrono::steady_clock::time_point(std::chrono::nanoseconds(traceRecord.timestampNanoseconds));
+
+        bool isStateResync = (traceRecord.sensorFlags & SensorTraceRecord::FLAG_STATE_RESYNC) != 0;
+        if (isStateResync) {
+            // A mode or setting change made outside the auto rules (e.g. a manual interval)
+            applyStateResync(traceRecord, wiperController, recordedTime);
+            replayStatistics.resyncCount++;
+        } else {
+            wiperController.processAutomaticModeOperation(convertToQuantizedReading(traceRecord), recordedTime);
+        }
+
+        WindshieldWiperSpeed currentSpeed = wiperController.getCurrentWiperSpeed();
+        WaterSprayMode currentSprayMode = wiperController.getCurrentWaterSprayMode();
+        if (!isStateResync && static_cast<std::uint8_t>(currentSpeed) != traceRecord.wiperSpeed) {
+            replayStatistics.mismatchCount++;
+        }
+
+        if (!hasPreviousState || currentSpeed != previousSpeed || currentSprayMode != previousSprayMode) {
+            if (timelineStream != nullptr) {
+                *timelineStream << "[" << std::setw(10) << (traceRecord.timestampNanoseconds / 1e9) << " s] Wiper: "
+                                << convertWiperSpeedToString(currentSpeed) << " | Spray: "
+                                << convertSprayModeToString(currentSprayMode) << "\n";
+            }
+            replayStatistics.timelineEntryCount++;
+            previousSpeed = currentSpeed;
+            previousSprayMode = currentSprayMode;
+            hasPreviousState = true;
+        }
+    }
+    std::chrono::duration<double> replayDuration = std::chrono::steady_clock::now() - replayStartTime;
+
+    if (timelineStream != nullptr) {
+        timelineStream->flags(previousFlags);
+        timelineStream->precision(previousPrecision);
+    }
+
+    replayStatistics.replayedCount = recordCount - replayStatistics.resyncCount;
+    replayStatistics.elapsedSeconds = replayDuration.count();
+    replayStatistics.recordsPerSecond = (replayStatistics.elapsedSeconds > 0.0) ?
+        static_cast<double>(recordCount) / replayStatistics.elapsedSeconds : 0.0;
+    return replayStatistics;
+}
@@ -0,0 +1,152 @@
+#ifndef SENSOR_TRACE_REPLAYER_H
+#define SENSOR_TRACE_REPLAYER_H
+
+#include "SensorTraceRecorder.h"
+#include "RainSensor.h"
+#include "WindshieldWiperController.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief SensorTraceReplayer class to feed a recorded sensor trace back through the controller
+ *
+ * On POSIX the trace is memory-mapped and records are read in place, so replay does
+ * no per-record allocation or parsing. Other platforms load the file into one buffer.
+ * A trailing partial record (e.g. from a recording cut short) is ignored.
+ */
+class SensorTraceReplayer {
+public:
+    /**
+     * @brief Structure to hold the results of a full replay
+     */
+    struct ReplayStatistics {
+        std::uint64_t replayedCount;       // Readings fed through the controller
+        std::uint64_t resyncCount;         // State resync records applied (mode and setting changes)
+        std::uint64_t timelineEntryCount;  // Speed/spray changes written to the timeline
+        std::uint64_t mismatchCount;       // Ticks where the replayed speed differs from the recorded one
+        double elapsedSeconds;
+        double recordsPerSecond;
+    };
+
+    /**
+     * @brief Constructor for SensorTraceReplayer (empty until open() is called)
+     */
+    SensorTraceReplayer();
+
+    /**
+     * @brief Destructor that unmaps the trace
+     */
+    ~SensorTraceReplayer();
+
+    /**
+     * @brief Map a trace file and validate its header
+     * @param traceFilePath Path of a trace written by SensorTraceRecorder
+     * @return True if the file is a readable trace
+     */
+    bool open(const std::string& traceFilePath);
+
+    /**
+     * @brief Unmap the trace
+     */
+    void close();
+
+    /**
+     * @brief Check if a trace is loaded
+     * @return True if open
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get the number of complete records in the trace
+     * @return Record count
+     */
+    std::uint64_t getRecordCount() const;
+
+    /**
+     * @brief Get one record in place
+     * @param recordIndex Index below getRecordCount()
+     * @return Reference into the mapped trace
+     */
+    const SensorTraceRecord& getRecord(std::uint64_t recordIndex) const;
+
+    /**
+     * @brief Read the next reading in place of a live sensor, skipping state resync records
+     * @param sensorData Receives the recorded reading
+     * @return False once the trace is exhausted
+     */
+    bool readNextReading(RainSensor::SensorReadingData& sensorData);
+
+    /**
+     * @brief Read the next reading, applying the state resync records before it to a controller
+     * @param sensorData Receives the recorded reading
+     * @param wiperController Controller that follows the recorded mode and setting changes
+     * @param currentTime Live time the returned reading will be processed at
+     * @return False once the trace is exhausted
+     *
+     * Resyncs are mapped onto the live clock relative to the reading that follows them,
+     * so a countdown pending at a resync runs out on the same reading as it did when recorded.
+     */
+    bool readNextReading(RainSensor::SensorReadingData& sensorData, WindshieldWiperController& wiperController,
+                         std::chrono::steady_clock::time_point currentTime);
+
+    /**
+     * @brief Restart readNextReading() from the first record
+     */
+    void rewind();
+
+    /**
+     * @brief Convert a record back into the reading the sensor produced
+     * @param traceRecord Recorded record
+     * @return Sensor reading data
+     */
+    static RainSensor::SensorReadingData convertToSensorReading(const SensorTraceRecord& traceRecord);
+
+    /**
+     * @brief Convert a record into a fixed-point reading without widening it
+     * @param traceRecord Recorded record
+     * @return Quantized sensor reading data
+     */
+    static RainSensor::QuantizedReadingData convertToQuantizedReading(const SensorTraceRecord& traceRecord);
+
+    /**
+     * @brief Restore the controller state a resync record carries
+     * @param traceRecord Record with FLAG_STATE_RESYNC set
+     * @param wiperController Controller to overwrite
+     * @param resyncTime The record's instant on the clock the controller runs on
+     *
+     * The turn-off countdown is restarted at the same age it had when recorded.
+     */
+    static void applyStateResync(const SensorTraceRecord& traceRecord, WindshieldWiperController& wiperController,
+                                 std::chrono::steady_clock::time_point resyncTime);
+
+    /**
+     * @brief Replay the whole trace through a controller as fast as possible
+     * @param wiperController Controller to drive (switched to automatic mode)
+     * @param timelineStream Stream for the speed/spray timeline, or nullptr for none
+     * @return Replay statistics
+     *
+     * Recorded timestamps drive the controller, so the turn-off delay behaves exactly
+     * as it did on the road no matter how fast the replay runs. Readings stay in fixed
+     * point from the mapped file to the controller's threshold compares. Resync records
+     * reset the controller, so manual intervals in the recording do not cause mismatches.
+     */
+    ReplayStatistics replayThroughController(WindshieldWiperController& wiperController,
+                                             std::ostream* timelineStream) const;
+
+private:
+    SensorTraceReplayer(const SensorTraceReplayer&);
+    SensorTraceReplayer& operator=(const SensorTraceReplayer&);
+
+    void* mappedData;
+    std::size_t mappedSize;
+    std::vector<unsigned char> loadedData; // Used where memory mapping is unavailable
+    const SensorTraceRecord* traceRecords;
+    std::uint64_t recordCount;
+    std::uint64_t nextRecordIndex;
+};
+
+#endif // SENSOR_TRACE_REPLAYER_H
@@ -0,0 +1,29 @@
+#include "SimulationClock.h"
+
+SimulationClock::SimulationClock(ClockMode clockMode)
+    : currentClockMode(clockMode),
+      virtualTime() {
+}
+
+SimulationClock::TimePoint SimulationClock::now() const {
+    if (currentClockMode == ClockMode::VIRTUAL_TIME) {
+        return virtualTime;
+    }
+    return std::chrono::steady_clock::now();
+}
+
+void SimulationClock::advance(Duration timeStep) {
+    if (currentClockMode == ClockMode::VIRTUAL_TIME) {
+        virtualTime += timeStep;
+    }
+}
+
+void SimulationClock::setVirtualTime(TimePoint newTime) {
+    if (currentClockMode == ClockMode::VIRTUAL_TIME) {
+        virtualTime = newTime;
+    }
+}
+
+SimulationClock::ClockMode SimulationClock::getClockMode() const {
+    return currentClockMode;
+}
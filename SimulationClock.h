@@ -0,0 +1,60 @@
+#ifndef SIMULATION_CLOCK_H
+#define SIMULATION_CLOCK_H
+
+#include <chrono>
+
+/**
+ * @brief SimulationClock class to supply timestamps in real or virtual time
+ *
+ * In virtual time the clock only moves when advanced explicitly, so hours of
+ * driving can be replayed without waiting on the wall clock.
+ */
+class SimulationClock {
+public:
+    /**
+     * @brief Enum for clock time sources
+     */
+    enum class ClockMode {
+        REAL_TIME,
+        VIRTUAL_TIME
+    };
+
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    typedef std::chrono::steady_clock::duration Duration;
+
+    /**
+     * @brief Constructor for SimulationClock
+     * @param clockMode Whether to follow steady_clock or virtual time
+     */
+    explicit SimulationClock(ClockMode clockMode = ClockMode::REAL_TIME);
+
+    /**
+     * @brief Get the current time
+     * @return steady_clock::now() in real time, the virtual time otherwise
+     */
+    TimePoint now() const;
+
+    /**
+     * @brief Move virtual time forward (ignored in real time)
+     * @param timeStep How far to advance the clock
+     */
+    void advance(Duration timeStep);
+
+    /**
+     * @brief Set the virtual time (ignored in real time)
+     * @param newTime The new virtual time
+     */
+    void setVirtualTime(TimePoint newTime);
+
+    /**
+     * @brief Get the clock mode
+     * @return Current clock mode
+     */
+    ClockMode getClockMode() const;
+
+private:
+    ClockMode currentClockMode;
+    TimePoint virtualTime;
+};
+
+#endif // SIMULATION_CLOCK_H
@@ -0,0 +1,77 @@
+#include "StatusDisplay.h"
+#include "StatusLineRenderer.h"
+#include <ctime>
+#include <iostream>
+
+namespace {
+
+/**
+ * @brief Get this thread's renderer for the stream-style printers
+ * @return Renderer whose cached time prefix is shared by every line the thread prints
+ */
+StatusLineRenderer& getThreadStatusLineRenderer() {
+    static thread_local StatusLineRenderer statusLineRenderer;
+    return statusLineRenderer;
+}
+
+} // namespace
+
+std::string getCurrentTimeString() {
+    char timeBuffer[TIME_STRING_BUFFER_SIZE];
+    formatCurrentTimeString(timeBuffer, sizeof(timeBuffer));
+    return timeBuffer;
+}
+
+std::size_t formatCurrentTimeString(char* timeBuffer, std::size_t bufferSize) {
+    return formatTimeString(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()), timeBuffer, bufferSize);
+}
+
+std::size_t formatTimeString(std::time_t timeValue, char* timeBuffer, std::size_t bufferSize) {
+    // Reentrant conversion, so status lines can be formatted on several threads
+    std::tm timeStructure;
+    #ifdef _WIN32
+    localtime_s(&timeStructure, &timeValue);
+    #else
+    localtime_r(&timeValue, &timeStructure);
+    #endif
+    
+    // strftime writes straight into the caller's buffer, unlike a stringstream
+    std::size_t writtenLength = std::strftime(timeBuffer, bufferSize, "%H:%M:%S", &timeStructure);
+    if (writtenLength == 0 && bufferSize > 0) {
+        timeBuffer[0] = '\0';
+    }
+    return writtenLength;
+}
+
+void printAutomaticModeStatusLine(const RainSensor::SensorReadingData& sensorData,
+                                  bool hasBurstInStatusWindow,
+                                  const WindshieldWiperController& wiperController,
+                                  std::chrono::steady_clock::time_point currentTime) {
+    StatusLineRenderer& statusLineRenderer = getThreadStatusLineRenderer();
+    statusLineRenderer.renderAutomaticModeStatusLine(sensorData, hasBurstInStatusWindow, wiperController, currentTime);
+    statusLineRenderer.writeToConsole();
+}
+
+void printAutomaticModeStatusLine(std::ostream& outputStream,
+                                  const RainSensor::SensorReadingData& sensorData,
+                                  bool hasBurstInStatusWindow,
+                                  const WindshieldWiperController& wiperController,
+                                  std::chrono::steady_clock::time_point currentTime) {
+    StatusLineRenderer& statusLineRenderer = getThreadStatusLineRenderer();
+    statusLineRenderer.renderAutomaticModeStatusLine(sensorData, hasBurstInStatusWindow, wiperController, currentTime);
+    statusLineRenderer.writeToStream(outputStream);
+    outputStream.flush();
+}
+
+void printManualModeStatusLine(const WindshieldWiperController& wiperController) {
+    StatusLineRenderer& statusLineRenderer = getThreadStatusLineRenderer();
+    statusLineRenderer.renderManualModeStatusLine(wiperController);
+    statusLineRenderer.writeToConsole();
+}
+
+void printManualModeStatusLine(std::ostream& outputStream, const WindshieldWiperController& wiperController) {
+    StatusLineRenderer& statusLineRenderer = getThreadStatusLineRenderer();
+    statusLineRenderer.renderManualModeStatusLine(wiperController);
+    statusLineRenderer.writeToStream(outputStream);
+    outputStream.flush();
+}
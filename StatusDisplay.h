@@ -0,0 +1,102 @@
+#ifndef STATUS_DISPLAY_H
+#define STATUS_DISPLAY_H
+
+#include "RainSensor.h"
+#include "WindshieldWiperController.h"
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+/**
+ * @brief DiscardingStreamBuffer class to drop status output in headless runs
+ *
+ * A stream over this buffer still pays for formatting, so benchmarks measure the
+ * status path without a terminal.
+ */
+class DiscardingStreamBuffer : public std::streambuf {
+protected:
+    int overflow(int character) override {
+        return character;
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize characterCount) override {
+        return characterCount;
+    }
+};
+
+/**
+ * @brief Get current wall-clock time as formatted string
+ * @return Current time in HH:MM:SS format
+ */
+std::string getCurrentTimeString();
+
+/**
+ * @brief Size of a buffer that holds an HH:MM:SS time and its terminator
+ */
+const std::size_t TIME_STRING_BUFFER_SIZE = 9;
+
+/**
+ * @brief Format current wall-clock time into a caller-provided buffer without allocating
+ * @param timeBuffer Receives the null-terminated HH:MM:SS time
+ * @param bufferSize Size of timeBuffer (at least TIME_STRING_BUFFER_SIZE)
+ * @return Number of characters written, or 0 if the buffer is too small
+ */
+std::size_t formatCurrentTimeString(char* timeBuffer, std::size_t bufferSize);
+
+/**
+ * @brief Format a given wall-clock time into a caller-provided buffer without allocating
+ * @param timeValue Seconds since the epoch, shown in local time
+ * @param timeBuffer Receives the null-terminated HH:MM:SS time
+ * @param bufferSize Size of timeBuffer (at least TIME_STRING_BUFFER_SIZE)
+ * @return Number of characters written, or 0 if the buffer is too small
+ */
+std::size_t formatTimeString(std::time_t timeValue, char* timeBuffer, std::size_t bufferSize);
+
+/*
+ * The printers below are thin wrappers over a per-thread StatusLineRenderer, so the
+ * status line text is formatted in exactly one place.
+ */
+
+/**
+ * @brief Print one auto mode status line to the console
+ * @param sensorData Latest sensor reading
+ * @param hasBurstInStatusWindow Whether a burst was seen since the previous status line
+ * @param wiperController Controller whose speed and countdown are shown
+ * @param currentTime Time of this status update (for the countdown)
+ */
+void printAutomaticModeStatusLine(const RainSensor::SensorReadingData& sensorData,
+                                  bool hasBurstInStatusWindow,
+                                  const WindshieldWiperController& wiperController,
+                                  std::chrono::steady_clock::time_point currentTime);
+
+/**
+ * @brief Print one auto mode status line to any output stream
+ * @param outputStream The stream to print to
+ * @param sensorData Latest sensor reading
+ * @param hasBurstInStatusWindow Whether a burst was seen since the previous status line
+ * @param wiperController Controller whose speed and countdown are shown
+ * @param currentTime Time of this status update (for the countdown)
+ */
+void printAutomaticModeStatusLine(std::ostream& outputStream,
+                                  const RainSensor::SensorReadingData& sensorData,
+                                  bool hasBurstInStatusWindow,
+                                  const WindshieldWiperController& wiperController,
+                                  std::chrono::steady_clock::time_point currentTime);
+
+/**
+ * @brief Print one manual mode status line to the console
+ * @param wiperController Controller whose speed and spray mode are shown
+ */
+void printManualModeStatusLine(const WindshieldWiperController& wiperController);
+
+/**
+ * @brief Print one manual mode status line to any output stream
+ * @param outputStream The stream to print to
+ * @param wiperController Controller whose speed and spray mode are shown
+ */
+void printManualModeStatusLine(std::ostream& outputStream, const WindshieldWiperController& wiperController);
+
+#endif // STATUS_DISPLAY_H
@@ -0,0 +1,270 @@
+#include "StatusLineRenderer.h"
+#include "ColorUtilities.h"
+#include "LatencyTracer.h"
+#include "StatusDisplay.h"
+#include "WiperEnums.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Structure for one preformatted line segment with its length known up front
+ */
+struct StatusSegment {
+    const char* text;
+    std::size_t length;
+};
+
+#define STATUS_SEGMENT(literal) { literal, sizeof(literal) - 1 }
+
+const StatusSegment AUTO_MODE_SEGMENT = STATUS_SEGMENT(COLOR_GREEN "Mode: AUTO" COLOR_RESET);
+const StatusSegment MANUAL_MODE_SEGMENT = STATUS_SEGMENT("Mode: MANUAL | Wiper: ");
+const StatusSegment MODE_LABEL_SEGMENT = STATUS_SEGMENT("Mode: ");
+const StatusSegment COLORED_AUTO_SEGMENT = STATUS_SEGMENT(COLOR_GREEN "AUTO" COLOR_RESET);
+const StatusSegment COLORED_MANUAL_SEGMENT = STATUS_SEGMENT(COLOR_BLUE "MANUAL" COLOR_RESET);
+const StatusSegment SENSOR_LABEL_SEGMENT = STATUS_SEGMENT(" | Sensor: ");
+const StatusSegment SENSOR_ERROR_SEGMENT = STATUS_SEGMENT(COLOR_RED "ERROR" COLOR_RESET);
+const StatusSegment SENSOR_VALUE_START_SEGMENT = STATUS_SEGMENT(COLOR_WHITE);
+const StatusSegment PERCENT_END_SEGMENT = STATUS_SEGMENT("%" COLOR_RESET);
+const StatusSegment WIPER_LABEL_SEGMENT = STATUS_SEGMENT(" | Wiper: ");
+const StatusSegment SPRAY_LABEL_SEGMENT = STATUS_SEGMENT(" | Spray: ");
+const StatusSegment SENSOR_FAILURE_SEGMENT = STATUS_SEGMENT(COLOR_RED " (Sensor Failure - Switch to Manual)" COLOR_RESET);
+const StatusSegment RAIN_BURST_SEGMENT = STATUS_SEGMENT(COLOR_RED " (Sudden Rain Burst)" COLOR_RESET);
+const StatusSegment COUNTDOWN_START_SEGMENT = STATUS_SEGMENT(COLOR_YELLOW " (Turning OFF in ");
+const StatusSegment COUNTDOWN_END_SEGMENT = STATUS_SEGMENT("s)" COLOR_RESET);
+const StatusSegment DEW_START_SEGMENT = STATUS_SEGMENT(COLOR_MAGENTA " (Dew Detected: ");
+const StatusSegment DEW_END_SEGMENT = STATUS_SEGMENT("%)" COLOR_RESET);
+const StatusSegment ALERT_START_SEGMENT = STATUS_SEGMENT(COLOR_RED " (");
+const StatusSegment ALERT_END_SEGMENT = STATUS_SEGMENT(")" COLOR_RESET);
+
+// Indexed by WindshieldWiperSpeed, with the speed's color spliced in
+const StatusSegment COLORED_WIPER_SPEED_SEGMENTS[] = {
+    STATUS_SEGMENT(COLOR_GRAY "OFF" COLOR_RESET),
+    STATUS_SEGMENT(COLOR_GREEN "LOW" COLOR_RESET),
+    STATUS_SEGMENT(COLOR_YELLOW "MEDIUM" COLOR_RESET),
+    STATUS_SEGMENT(COLOR_RED "HIGH" COLOR_RESET)
+};
+
+// Indexed by WaterSprayMode (OFF is never shown)
+const StatusSegment COLORED_SPRAY_MODE_SEGMENTS[] = {
+    STATUS_SEGMENT(COLOR_CYAN "OFF" COLOR_RESET),
+    STATUS_SEGMENT(COLOR_CYAN "LIGHT SPRAY" COLOR_RESET),
+    STATUS_SEGMENT(COLOR_BLUE "HEAVY SPRAY" COLOR_RESET)
+};
+
+#undef STATUS_SEGMENT
+
+} // namespace
+
+StatusLineRenderer::StatusLineRenderer()
+    : lineLength(0),
+      cachedPrefixSeconds(static_cast<std::time_t>(-1)),
+      cachedTimePrefixLength(0),
+      timePrefixRebuildCount(0) {
+    lineBuffer[0] = '\0';
+    cachedTimePrefix[0] = '\0';
+}
+
+void StatusLineRenderer::renderAutomaticModeStatusLine(const RainSensor::SensorReadingData& sensorData,
+                                                       bool hasBurstInStatusWindow,
+                                                       const WindshieldWiperController& wiperController,
+                                                       std::chrono::steady_clock::time_point currentTime) {
+    WIPER_TRACE_SCOPE("StatusLineRenderer::renderAutomaticModeStatusLine");
+
+    beginLine();
+    appendText(AUTO_MODE_SEGMENT.text, AUTO_MODE_SEGMENT.length);
+    appendText(SENSOR_LABEL_SEGMENT.text, SENSOR_LABEL_SEGMENT.length);
+    if (!sensorData.isValidReading) {
+        appendText(SENSOR_ERROR_SEGMENT.text, SENSOR_ERROR_SEGMENT.length);
+    } else {
+        appendText(SENSOR_VALUE_START_SEGMENT.text, SENSOR_VALUE_START_SEGMENT.length);
+        appendInteger(static_cast<int>(sensorData.lightPercentage));
+        appendText(PERCENT_END_SEGMENT.text, PERCENT_END_SEGMENT.length);
+    }
+    appendText(WIPER_LABEL_SEGMENT.text, WIPER_LABEL_SEGMENT.length);
+    const StatusSegment& speedSegment = COLORED_WIPER_SPEED_SEGMENTS[static_cast<int>(wiperController.getCurrentWiperSpeed())];
+    appendText(speedSegment.text, speedSegment.length);
+
+    if (!sensorData.isValidReading) {
+        appendText(SENSOR_FAILURE_SEGMENT.text, SENSOR_FAILURE_SEGMENT.length);
+    } else {
+        if (hasBurstInStatusWindow) {
+            appendText(RAIN_BURST_SEGMENT.text, RAIN_BURST_SEGMENT.length);
+        }
+        if (wiperController.isWaitingToTurnOffWipers()) {
+            appendText(COUNTDOWN_START_SEGMENT.text, COUNTDOWN_START_SEGMENT.length);
+            appendInteger(wiperController.getRemainingTurnOffSeconds(currentTime));
+            appendText(COUNTDOWN_END_SEGMENT.text, COUNTDOWN_END_SEGMENT.length);
+        }
+    }
+    endLine();
+}
+
+void StatusLineRenderer::renderManualModeStatusLine(const WindshieldWiperController& wiperController) {
+    WIPER_TRACE_SCOPE("StatusLineRenderer::renderManualModeStatusLine");
+
+    beginLine();
+    appendText(MANUAL_MODE_SEGMENT.text, MANUAL_MODE_SEGMENT.length);
+    appendText(getWiperSpeedName(wiperController.getCurrentWiperSpeed()));
+    if (wiperController.getCurrentWaterSprayMode() != WaterSprayMode::OFF) {
+        appendText(SPRAY_LABEL_SEGMENT.text, SPRAY_LABEL_SEGMENT.length);
+        appendText(getSprayModeName(wiperController.getCurrentWaterSprayMode()));
+    }
+    endLine();
+}
+
+void StatusLineRenderer::renderSystemStatusLine(const RainSensor::SensorReadingData& sensorData,
+                                                const WindshieldWiperController& wiperController,
+                                                const std::string& alertMessage) {
+    bool isManualMode = wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL;
+
+    beginLine();
+    appendText(MODE_LABEL_SEGMENT.text, MODE_LABEL_SEGMENT.length);
+    const StatusSegment& modeSegment = isManualMode ? COLORED_MANUAL_SEGMENT : COLORED_AUTO_SEGMENT;
+    appendText(modeSegment.text, modeSegment.length);
+
+    appendText(SENSOR_LABEL_SEGMENT.text, SENSOR_LABEL_SEGMENT.length);
+    if (!sensorData.isValidReading) {
+        appendText(SENSOR_ERROR_SEGMENT.text, SENSOR_ERROR_SEGMENT.length);
+    } else {
+        appendText(SENSOR_VALUE_START_SEGMENT.text, SENSOR_VALUE_START_SEGMENT.length);
+        appendInteger(static_cast<int>(sensorData.lightPercentage));
+        appendText(PERCENT_END_SEGMENT.text, PERCENT_END_SEGMENT.length);
+    }
+
+    appendText(WIPER_LABEL_SEGMENT.text, WIPER_LABEL_SEGMENT.length);
+    const StatusSegment& speedSegment = COLORED_WIPER_SPEED_SEGMENTS[static_cast<int>(wiperController.getCurrentWiperSpeed())];
+    appendText(speedSegment.text, speedSegment.length);
+
+    // Spray and dew are only shown in manual mode
+    if (isManualMode && wiperController.getCurrentWaterSprayMode() != WaterSprayMode::OFF) {
+        const StatusSegment& spraySegment = COLORED_SPRAY_MODE_SEGMENTS[static_cast<int>(wiperController.getCurrentWaterSprayMode())];
+        appendText(SPRAY_LABEL_SEGMENT.text, SPRAY_LABEL_SEGMENT.length);
+        appendText(spraySegment.text, spraySegment.length);
+    }
+    if (sensorData.isSuddenRainBurst) {
+        appendText(RAIN_BURST_SEGMENT.text, RAIN_BURST_SEGMENT.length);
+    }
+    if (isManualMode && sensorData.isDewPresent) {
+        appendText(DEW_START_SEGMENT.text, DEW_START_SEGMENT.length);
+        appendInteger(static_cast<int>(sensorData.dewLevel));
+        appendText(DEW_END_SEGMENT.text, DEW_END_SEGMENT.length);
+    }
+    if (!alertMessage.empty()) {
+        appendText(ALERT_START_SEGMENT.text, ALERT_START_SEGMENT.length);
+        appendText(alertMessage.data(), alertMessage.size());
+        appendText(ALERT_END_SEGMENT.text, ALERT_END_SEGMENT.length);
+    }
+    endLine();
+}
+
+void StatusLineRenderer::renderEventLine(const std::string& eventMessage) {
+    beginLine();
+    appendText(eventMessage.data(), eventMessage.size());
+    endLine();
+}
+
+const char* StatusLineRenderer::getLineData() const {
+    return lineBuffer;
+}
+
+std::size_t StatusLineRenderer::getLineLength() const {
+    return lineLength;
+}
+
+bool StatusLineRenderer::writeToConsole() const {
+    // std::cout is synchronized with stdio, so this also pushes out any partial prompt
+    std::cout.flush();
+#if !defined(_WIN32)
+    return writeToFileDescriptor(STDOUT_FILENO);
+#else
+    bool isWritten = std::fwrite(lineBuffer, 1, lineLength, stdout) == lineLength;
+    std::fflush(stdout);
+    return isWritten;
+#endif
+}
+
+bool StatusLineRenderer::writeToFileDescriptor(int fileDescriptor) const {
+#if !defined(_WIN32)
+    // One write(2) per frame; the loop only runs again after a signal or a short write to a pipe
+    std::size_t writtenLength = 0;
+    while (writtenLength < lineLength) {
+        ssize_t writeResult = ::write(fileDescriptor, lineBuffer + writtenLength, lineLength - writtenLength);
+        if (writeResult < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        writtenLength += static_cast<std::size_t>(writeResult);
+    }
+    return true;
+#else
+    return _write(fileDescriptor, lineBuffer, static_cast<unsigned int>(lineLength)) == static_cast<int>(lineLength);
+#endif
+}
+
+void StatusLineRenderer::writeToStream(std::ostream& outputStream) const {
+    outputStream.write(lineBuffer, static_cast<std::streamsize>(lineLength));
+}
+
+std::uint64_t StatusLineRenderer::getTimePrefixRebuildCount() const {
+    return timePrefixRebuildCount;
+}
+
+void StatusLineRenderer::beginLine() {
+    std::time_t currentSeconds = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (currentSeconds != cachedPrefixSeconds) {
+        // Only the first line of each second pays for the local time conversion
+        char timeBuffer[TIME_STRING_BUFFER_SIZE];
+        formatTimeString(currentSeconds, timeBuffer, sizeof(timeBuffer));
+        int prefixLength = std::snprintf(cachedTimePrefix, sizeof(cachedTimePrefix),
+                                         COLOR_CYAN "[%s] " COLOR_RESET, timeBuffer);
+        cachedTimePrefixLength = (prefixLength > 0) ? static_cast<std::size_t>(prefixLength) : 0;
+        cachedPrefixSeconds = currentSeconds;
+        timePrefixRebuildCount++;
+    }
+    lineLength = 0;
+    appendText(cachedTimePrefix, cachedTimePrefixLength);
+}
+
+void StatusLineRenderer::appendText(const char* text, std::size_t textLength) {
+    // One byte stays free for the newline
+    std::size_t availableLength = LINE_BUFFER_CAPACITY - 1 - lineLength;
+    if (textLength > availableLength) {
+        textLength = availableLength;
+    }
+    std::memcpy(lineBuffer + lineLength, text, textLength);
+    lineLength += textLength;
+}
+
+void StatusLineRenderer::appendText(const char* text) {
+    appendText(text, std::strlen(text));
+}
+
+void StatusLineRenderer::appendInteger(int integerValue) {
+    char digitBuffer[12];
+    std::size_t digitPosition = sizeof(digitBuffer);
+    unsigned int magnitude = (integerValue < 0) ? 0u - static_cast<unsigned int>(integerValue) : static_cast<unsigned int>(integerValue);
+    do {
+        digitBuffer[--digitPosition] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (integerValue < 0) {
+        digitBuffer[--digitPosition] = '-';
+    }
+    appendText(digitBuffer + digitPosition, sizeof(digitBuffer) - digitPosition);
+}
+
+void StatusLineRenderer::endLine() {
+    lineBuffer[lineLength++] = '\n';
+}
@@ -0,0 +1,142 @@
+#ifndef STATUS_LINE_RENDERER_H
+#define STATUS_LINE_RENDERER_H
+
+#include "RainSensor.h"
+#include "WindshieldWiperController.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief StatusLineRenderer class to format a whole colored status line and emit it in one write
+ *
+ * Lines are built in a preallocated buffer from segment templates whose color codes are
+ * already spliced in, so a frame costs one copy per segment and a single write(2) instead
+ * of a dozen locked iostream insertions. The "[HH:MM:SS] " prefix is cached and rebuilt
+ * only when the wall-clock second changes. The StatusDisplay printers wrap a renderer, so
+ * this is the only status line formatter. Not thread-safe; use one renderer per output thread.
+ */
+class StatusLineRenderer {
+public:
+    static const std::size_t LINE_BUFFER_CAPACITY = 512; // Longer lines are truncated (alerts only)
+
+    /**
+     * @brief Constructor for StatusLineRenderer (the time prefix is built on first use)
+     */
+    StatusLineRenderer();
+
+    /**
+     * @brief Format one auto mode status line
+     * @param sensorData Latest sensor reading
+     * @param hasBurstInStatusWindow Whether a burst was seen since the previous status line
+     * @param wiperController Controller whose speed and countdown are shown
+     * @param currentTime Time of this status update (for the countdown)
+     */
+    void renderAutomaticModeStatusLine(const RainSensor::SensorReadingData& sensorData,
+                                       bool hasBurstInStatusWindow,
+                                       const WindshieldWiperController& wiperController,
+                                       std::chrono::steady_clock::time_point currentTime);
+
+    /**
+     * @brief Format one manual mode status line
+     * @param wiperController Controller whose speed and spray mode are shown
+     */
+    void renderManualModeStatusLine(const WindshieldWiperController& wiperController);
+
+    /**
+     * @brief Format the full status line (mode, sensor, wiper, spray, dew, alert)
+     * @param sensorData Sensor reading to show
+     * @param wiperController Controller whose mode, speed and spray are shown
+     * @param alertMessage Alert appended in red, or empty for none
+     */
+    void renderSystemStatusLine(const RainSensor::SensorReadingData& sensorData,
+                                const WindshieldWiperController& wiperController,
+                                const std::string& alertMessage);
+
+    /**
+     * @brief Format a timestamped event message line
+     * @param eventMessage Message shown after the timestamp
+     */
+    void renderEventLine(const std::string& eventMessage);
+
+    /**
+     * @brief Get the line formatted by the last render call
+     * @return Pointer to the line (not null-terminated, valid until the next render)
+     */
+    const char* getLineData() const;
+
+    /**
+     * @brief Get the length of the formatted line, including its newline
+     * @return Line length in bytes
+     */
+    std::size_t getLineLength() const;
+
+    /**
+     * @brief Emit the formatted line on standard output with a single write
+     * @return True if the whole line was written
+     *
+     * Pending std::cout output is flushed first so prompts and help text stay in order.
+     */
+    bool writeToConsole() const;
+
+    /**
+     * @brief Emit the formatted line on a file descriptor with a single write(2)
+     * @param fileDescriptor Descriptor to write to (_write on Windows)
+     * @return True if the whole line was written
+     */
+    bool writeToFileDescriptor(int fileDescriptor) const;
+
+    /**
+     * @brief Emit the formatted line on any output stream with one stream write
+     * @param outputStream The stream to write to
+     */
+    void writeToStream(std::ostream& outputStream) const;
+
+    /**
+     * @brief Get how often the cached time prefix has been rebuilt
+     * @return Rebuild count since construction
+     */
+    std::uint64_t getTimePrefixRebuildCount() const;
+
+private:
+    /**
+     * @brief Start a new line with the cached time prefix, rebuilding it if the second changed
+     */
+    void beginLine();
+
+    /**
+     * @brief Append raw bytes, truncating at the buffer capacity
+     * @param text Bytes to append
+     * @param textLength Number of bytes
+     */
+    void appendText(const char* text, std::size_t textLength);
+
+    /**
+     * @brief Append a null-terminated string
+     * @param text String to append
+     */
+    void appendText(const char* text);
+
+    /**
+     * @brief Append a decimal integer without going through a stream
+     * @param integerValue Value to append
+     */
+    void appendInteger(int integerValue);
+
+    /**
+     * @brief End the line with a newline (always kept, even when truncated)
+     */
+    void endLine();
+
+    char lineBuffer[LINE_BUFFER_CAPACITY];
+    std::size_t lineLength;
+    std::time_t cachedPrefixSeconds;
+    char cachedTimePrefix[32];
+    std::size_t cachedTimePrefixLength;
+    std::uint64_t timePrefixRebuildCount;
+};
+
+#endif // STATUS_LINE_RENDERER_H
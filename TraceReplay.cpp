@@ -0,0 +1,47 @@
+#include "SensorTraceReplayer.h"
+#include "WindshieldWiperController.h"
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Headless entry point that replays a recorded sensor trace through the controller
+ *
+ * Usage: WiperTraceReplay TRACE [--quiet]
+ * Prints the speed/spray timeline (unless --quiet) followed by replay statistics.
+ * @return 0 if the replayed speeds match the recording, 2 if they diverge, 1 on error
+ */
+int main(int argc, char* argv[]) {
+    const char* traceFilePath = nullptr;
+    bool isTimelinePrinted = true;
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        if (std::strcmp(argv[argumentIndex], "--quiet") == 0) {
+            isTimelinePrinted = false;
+        } else {
+            traceFilePath = argv[argumentIndex];
+        }
+    }
+
+    if (traceFilePath == nullptr) {
+        std::cerr << "Usage: " << argv[0] << " TRACE [--quiet]" << std::endl;
+        return 1;
+    }
+
+    SensorTraceReplayer traceReplayer;
+    if (!traceReplayer.open(traceFilePath)) {
+        std::cerr << "Not a valid sensor trace: " << traceFilePath << std::endl;
+        return 1;
+    }
+
+    WindshieldWiperController wiperController;
+    SensorTraceReplayer::ReplayStatistics replayStatistics =
+        traceReplayer.replayThroughController(wiperController, isTimelinePrinted ? &std::cout : nullptr);
+
+    std::cout << "Replayed " << replayStatistics.replayedCount << " readings and "
+              << replayStatistics.resyncCount << " state resyncs in "
+              << replayStatistics.elapsedSeconds << " s ("
+              << replayStatistics.recordsPerSecond << " records/s)" << std::endl;
+    std::cout << "Timeline changes: " << replayStatistics.timelineEntryCount
+              << ", speed mismatches against recording: " << replayStatistics.mismatchCount << std::endl;
+
+    return (replayStatistics.mismatchCount == 0) ? 0 : 2;
+}
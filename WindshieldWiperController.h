@@ -2,13 +2,20 @@
 #define WINDSHIELD_WIPER_CONTROLLER_H
 
 #include "WiperEnums.h"
+#include "WiperCalibration.h"
 #include "RainSensor.h"
+#include "LatencyTracer.h"
 #include <chrono>
 
 /**
- * @brief WindshieldWiperController class to handle wiper logic and control
+ * @brief BasicWindshieldWiperController class template to handle wiper logic and control
+ * @tparam CalibrationPolicy Compile-time thresholds and delays (see DefaultWiperCalibration)
+ *
+ * Each calibration is its own specialization with the policy constants folded into the
+ * decision rules. WindshieldWiperController is the default calibration.
  */
-class WindshieldWiperController {
+template <typename CalibrationPolicy>
+class BasicWindshieldWiperController {
 private:
     WindshieldWiperSpeed currentWiperSpeed;
     OperatingMode currentOperatingMode;
@@ -17,20 +24,41 @@ private:
     // Delay mechanism for turning off wipers
     bool isWaitingToTurnOff;
     std::chrono::steady_clock::time_point turnOffStartTime;
-    static const int TURN_OFF_DELAY_SECONDS = 10;
+
+    /**
+     * @brief Run the automatic mode rules for a sample whose target speed is already mapped
+     * @param sensorData Sample flags (only validity and burst are read)
+     * @param targetSpeed Speed mapped from the sample's light level
+     * @param currentTime Time of the sample
+     * @return The change this sample made to the turn-off countdown
+     */
+    TurnOffCountdownEvent applyAutomaticModeSample(const RainSensor::SensorReadingData& sensorData,
+                                                   WindshieldWiperSpeed targetSpeed,
+                                                   std::chrono::steady_clock::time_point currentTime);
 
 public:
+    typedef CalibrationPolicy Calibration;
+
+    static const int TURN_OFF_DELAY_SECONDS = CalibrationPolicy::TURN_OFF_DELAY_SECONDS;
+
     /**
      * @brief Constructor for WindshieldWiperController
      */
-    WindshieldWiperController();
+    BasicWindshieldWiperController();
 
     /**
      * @brief Map light percentage to appropriate wiper speed
      * @param lightPercentage The light percentage from sensor
      * @return Appropriate wiper speed for the given light percentage
      */
-    WindshieldWiperSpeed mapLightPercentageToWiperSpeed(double lightPercentage);
+    static WindshieldWiperSpeed mapLightPercentageToWiperSpeed(double lightPercentage);
+
+    /**
+     * @brief Map a fixed-point light level to appropriate wiper speed
+     * @param lightCentiPercent Light level in 0.01 % units (see RainSensor::QuantizedReadingData)
+     * @return Same speed as mapLightPercentageToWiperSpeed() for the dequantized level
+     */
+    static WindshieldWiperSpeed mapQuantizedLightToWiperSpeed(std::uint16_t lightCentiPercent);
 
     /**
      * @brief Set the wiper speed
@@ -77,8 +105,55 @@ public:
     /**
      * @brief Process automatic mode operation based on sensor data
      * @param sensorData The sensor data to process
+     * @return The change this sample made to the turn-off countdown
+     */
+    TurnOffCountdownEvent processAutomaticModeOperation(const RainSensor::SensorReadingData& sensorData);
+
+    /**
+     * @brief Process automatic mode operation at an explicit timestamp
+     * @param sensorData The sensor data to process
+     * @param currentTime Time of the sample (real or virtual)
+     * @return The change this sample made to the turn-off countdown
      */
-    void processAutomaticModeOperation(const RainSensor::SensorReadingData& sensorData);
+    TurnOffCountdownEvent processAutomaticModeOperation(const RainSensor::SensorReadingData& sensorData,
+                                       std::chrono::steady_clock::time_point currentTime);
+
+    /**
+     * @brief Process a fixed-point sample at an explicit timestamp (integer threshold compares)
+     * @param sensorData The quantized sensor data to process
+     * @param currentTime Time of the sample (real or virtual)
+     * @return The change this sample made to the turn-off countdown
+     */
+    TurnOffCountdownEvent processAutomaticModeOperation(const RainSensor::QuantizedReadingData& sensorData,
+                                                        std::chrono::steady_clock::time_point currentTime);
+
+    /**
+     * @brief Apply the automatic mode decision rules to a wiper state
+     * @param sensorData The sensor data to process
+     * @param wiperSpeed Wiper speed, updated in place
+     * @param isWaitingToTurnOff Turn-off countdown flag, updated in place
+     * @param hasTurnOffDelayElapsed Whether a pending countdown has run for the full delay
+     * @return The change this sample made to the turn-off countdown
+     */
+    static TurnOffCountdownEvent applyAutomaticModeRules(const RainSensor::SensorReadingData& sensorData,
+                                                         WindshieldWiperSpeed& wiperSpeed,
+                                                         bool& isWaitingToTurnOff,
+                                                         bool hasTurnOffDelayElapsed);
+
+    /**
+     * @brief Apply the automatic mode decision rules with a precomputed target speed
+     * @param sensorData The sensor data to process
+     * @param targetSpeed Speed mapped from the sample's light percentage (e.g. by a batch kernel)
+     * @param wiperSpeed Wiper speed, updated in place
+     * @param isWaitingToTurnOff Turn-off countdown flag, updated in place
+     * @param hasTurnOffDelayElapsed Whether a pending countdown has run for the full delay
+     * @return The change this sample made to the turn-off countdown
+     */
+    static TurnOffCountdownEvent applyAutomaticModeRules(const RainSensor::SensorReadingData& sensorData,
+                                                         WindshieldWiperSpeed targetSpeed,
+                                                         WindshieldWiperSpeed& wiperSpeed,
+                                                         bool& isWaitingToTurnOff,
+                                                         bool hasTurnOffDelayElapsed);
 
     /**
      * @brief Check if the system is waiting to turn off wipers
@@ -91,6 +166,270 @@ public:
      * @return Remaining seconds, or 0 if not waiting
      */
     int getRemainingTurnOffSeconds() const;
+
+    /**
+     * @brief Get remaining seconds before turning off wipers at an explicit timestamp
+     * @param currentTime Time to measure the countdown against (real or virtual)
+     * @return Remaining seconds, or 0 if not waiting
+     */
+    int getRemainingTurnOffSeconds(std::chrono::steady_clock::time_point currentTime) const;
+
+    /**
+     * @brief Get when the pending turn-off countdown started
+     * @return Countdown start time (meaningless unless isWaitingToTurnOffWipers())
+     */
+    std::chrono::steady_clock::time_point getTurnOffStartTime() const;
+
+    /**
+     * @brief Overwrite the whole controller state (e.g. from a recorded trace)
+     * @param newWiperSpeed Wiper speed to restore
+     * @param newSprayMode Water spray mode to restore
+     * @param newOperatingMode Operating mode to restore
+     * @param newIsWaitingToTurnOff Whether a turn-off countdown is pending
+     * @param newTurnOffStartTime When the pending countdown started
+     */
+    void restoreState(WindshieldWiperSpeed newWiperSpeed, WaterSprayMode newSprayMode, OperatingMode newOperatingMode,
+                      bool newIsWaitingToTurnOff, std::chrono::steady_clock::time_point newTurnOffStartTime);
 };
 
+/**
+ * @brief Controller with the default calibration (80/50/20 thresholds, 10 second turn-off delay)
+ */
+typedef BasicWindshieldWiperController<DefaultWiperCalibration> WindshieldWiperController;
+
+// Member definitions follow; the default calibration is instantiated once in WindshieldWiperController.cpp
+
+template <typename CalibrationPolicy>
+const int BasicWindshieldWiperController<CalibrationPolicy>::TURN_OFF_DELAY_SECONDS;
+
+template <typename CalibrationPolicy>
+BasicWindshieldWiperController<CalibrationPolicy>::BasicWindshieldWiperController()
+    : currentWiperSpeed(WindshieldWiperSpeed::OFF),
+      currentOperatingMode(OperatingMode::AUTOMATIC),
+      currentWaterSprayMode(WaterSprayMode::OFF),
+      isWaitingToTurnOff(false) {
+}
+
+template <typename CalibrationPolicy>
+WindshieldWiperSpeed BasicWindshieldWiperController<CalibrationPolicy>::mapLightPercentageToWiperSpeed(double lightPercentage) {
+    if (lightPercentage >= CalibrationPolicy::OFF_MIN_LIGHT_PERCENTAGE) {
+        return WindshieldWiperSpeed::OFF;
+    } else if (lightPercentage >= CalibrationPolicy::LOW_MIN_LIGHT_PERCENTAGE) {
+        return WindshieldWiperSpeed::LOW;
+    } else if (lightPercentage >= CalibrationPolicy::MEDIUM_MIN_LIGHT_PERCENTAGE) {
+        return WindshieldWiperSpeed::MEDIUM;
+    } else {
+        return WindshieldWiperSpeed::HIGH;
+    }
+}
+
+template <typename CalibrationPolicy>
+WindshieldWiperSpeed BasicWindshieldWiperController<CalibrationPolicy>::mapQuantizedLightToWiperSpeed(std::uint16_t lightCentiPercent) {
+    // The invalid marker stands for the -1 of an invalid reading, which is below every threshold
+    if (lightCentiPercent == RainSensor::INVALID_QUANTIZED_PERCENTAGE) {
+        return WindshieldWiperSpeed::HIGH;
+    }
+    if (lightCentiPercent >= RainSensor::quantizeThreshold(CalibrationPolicy::OFF_MIN_LIGHT_PERCENTAGE)) {
+        return WindshieldWiperSpeed::OFF;
+    } else if (lightCentiPercent >= RainSensor::quantizeThreshold(CalibrationPolicy::LOW_MIN_LIGHT_PERCENTAGE)) {
+        return WindshieldWiperSpeed::LOW;
+    } else if (lightCentiPercent >= RainSensor::quantizeThreshold(CalibrationPolicy::MEDIUM_MIN_LIGHT_PERCENTAGE)) {
+        return WindshieldWiperSpeed::MEDIUM;
+    } else {
+        return WindshieldWiperSpeed::HIGH;
+    }
+}
+
+template <typename CalibrationPolicy>
+void BasicWindshieldWiperController<CalibrationPolicy>::setWiperSpeed(WindshieldWiperSpeed newWiperSpeed) {
+    currentWiperSpeed = newWiperSpeed;
+}
+
+template <typename CalibrationPolicy>
+WindshieldWiperSpeed BasicWindshieldWiperController<CalibrationPolicy>::getCurrentWiperSpeed() const {
+    return currentWiperSpeed;
+}
+
+template <typename CalibrationPolicy>
+void BasicWindshieldWiperController<CalibrationPolicy>::setOperatingMode(OperatingMode newOperatingMode) {
+    currentOperatingMode = newOperatingMode;
+}
+
+template <typename CalibrationPolicy>
+OperatingMode BasicWindshieldWiperController<CalibrationPolicy>::getCurrentOperatingMode() const {
+    return currentOperatingMode;
+}
+
+template <typename CalibrationPolicy>
+void BasicWindshieldWiperController<CalibrationPolicy>::setWaterSprayMode(WaterSprayMode newSprayMode) {
+    currentWaterSprayMode = newSprayMode;
+}
+
+template <typename CalibrationPolicy>
+WaterSprayMode BasicWindshieldWiperController<CalibrationPolicy>::getCurrentWaterSprayMode() const {
+    return currentWaterSprayMode;
+}
+
+template <typename CalibrationPolicy>
+void BasicWindshieldWiperController<CalibrationPolicy>::activateWaterSprayWithWiper(WaterSprayMode sprayMode) {
+    // Set spray mode and activate wipers for dew removal
+    currentWaterSprayMode = sprayMode;
+    
+    // For dew removal, use appropriate wiper speed based on spray intensity
+    if (sprayMode == WaterSprayMode::LIGHT_SPRAY) {
+        currentWiperSpeed = WindshieldWiperSpeed::LOW;
+    } else if (sprayMode == WaterSprayMode::HEAVY_SPRAY) {
+        currentWiperSpeed = WindshieldWiperSpeed::MEDIUM;
+    }
+}
+
+template <typename CalibrationPolicy>
+TurnOffCountdownEvent BasicWindshieldWiperController<CalibrationPolicy>::processAutomaticModeOperation(const RainSensor::SensorReadingData& sensorData) {
+    return processAutomaticModeOperation(sensorData, std::chrono::steady_clock::now());
+}
+
+template <typename CalibrationPolicy>
+TurnOffCountdownEvent BasicWindshieldWiperController<CalibrationPolicy>::processAutomaticModeOperation(const RainSensor::SensorReadingData& sensorData,
+                                                                                                       std::chrono::steady_clock::time_point currentTime) {
+    WIPER_TRACE_SCOPE("WindshieldWiperController::processAutomaticModeOperation");
+    return applyAutomaticModeSample(sensorData, mapLightPercentageToWiperSpeed(sensorData.lightPercentage), currentTime);
+}
+
+template <typename CalibrationPolicy>
+TurnOffCountdownEvent BasicWindshieldWiperController<CalibrationPolicy>::processAutomaticModeOperation(const RainSensor::QuantizedReadingData& sensorData,
+                                                                                                       std::chrono::steady_clock::time_point currentTime) {
+    WIPER_TRACE_SCOPE("WindshieldWiperController::processAutomaticModeOperation");
+    
+    // The rules only read the flags; the light level is compared in fixed point
+    RainSensor::SensorReadingData ruleInputs = RainSensor::SensorReadingData();
+    ruleInputs.isValidReading = sensorData.isValidReading;
+    ruleInputs.isSuddenRainBurst = sensorData.isSuddenRainBurst;
+    return applyAutomaticModeSample(ruleInputs, mapQuantizedLightToWiperSpeed(sensorData.lightCentiPercent), currentTime);
+}
+
+template <typename CalibrationPolicy>
+TurnOffCountdownEvent BasicWindshieldWiperController<CalibrationPolicy>::applyAutomaticModeSample(const RainSensor::SensorReadingData& sensorData,
+                                                                                                  WindshieldWiperSpeed targetSpeed,
+                                                                                                  std::chrono::steady_clock::time_point currentTime) {
+    // Check if the turn-off delay has passed since the countdown started
+    bool hasTurnOffDelayElapsed = false;
+    if (isWaitingToTurnOff) {
+        auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - turnOffStartTime);
+        hasTurnOffDelayElapsed = (elapsedTime.count() >= TURN_OFF_DELAY_SECONDS);
+    }
+    
+    // Spray mode is never touched by the rules, so the user's manual spray setting is preserved
+    TurnOffCountdownEvent countdownEvent = applyAutomaticModeRules(sensorData, targetSpeed, currentWiperSpeed,
+                                                                   isWaitingToTurnOff, hasTurnOffDelayElapsed);
+    if (countdownEvent == TurnOffCountdownEvent::STARTED) {
+        turnOffStartTime = currentTime;
+    }
+    return countdownEvent;
+}
+
+template <typename CalibrationPolicy>
+TurnOffCountdownEvent BasicWindshieldWiperController<CalibrationPolicy>::applyAutomaticModeRules(const RainSensor::SensorReadingData& sensorData,
+                                                                                                 WindshieldWiperSpeed& wiperSpeed,
+                                                                                                 bool& isWaitingToTurnOff,
+                                                                                                 bool hasTurnOffDelayElapsed) {
+    // Map light percentage to appropriate wiper speed
+    WindshieldWiperSpeed targetSpeed = mapLightPercentageToWiperSpeed(sensorData.lightPercentage);
+    return applyAutomaticModeRules(sensorData, targetSpeed, wiperSpeed, isWaitingToTurnOff, hasTurnOffDelayElapsed);
+}
+
+template <typename CalibrationPolicy>
+TurnOffCountdownEvent BasicWindshieldWiperController<CalibrationPolicy>::applyAutomaticModeRules(const RainSensor::SensorReadingData& sensorData,
+                                                                                                 WindshieldWiperSpeed targetSpeed,
+                                                                                                 WindshieldWiperSpeed& wiperSpeed,
+                                                                                                 bool& isWaitingToTurnOff,
+                                                                                                 bool hasTurnOffDelayElapsed) {
+    // Any rule that clears a pending countdown reports it as cancelled
+    TurnOffCountdownEvent cancelledEvent = isWaitingToTurnOff ? TurnOffCountdownEvent::CANCELLED : TurnOffCountdownEvent::NONE;
+    
+    if (!sensorData.isValidReading) {
+        // Sensor failure - set to LOW speed as safety measure
+        wiperSpeed = WindshieldWiperSpeed::LOW;
+        isWaitingToTurnOff = false; // Cancel any pending turn-off
+        return cancelledEvent;
+    }
+
+    if (sensorData.isSuddenRainBurst) {
+        // Sudden rain burst detected - immediately set to HIGH speed
+        wiperSpeed = WindshieldWiperSpeed::HIGH;
+        isWaitingToTurnOff = false; // Cancel any pending turn-off
+        return cancelledEvent;
+    }
+    
+    // Normal operation - check if we should turn off wipers (target speed is OFF and wipers are currently on)
+    if (targetSpeed == WindshieldWiperSpeed::OFF && wiperSpeed != WindshieldWiperSpeed::OFF) {
+        if (!isWaitingToTurnOff) {
+            // Start the turn-off countdown
+            isWaitingToTurnOff = true;
+            return TurnOffCountdownEvent::STARTED;
+        }
+        
+        if (hasTurnOffDelayElapsed) {
+            // The delay has passed, turn off wipers
+            wiperSpeed = WindshieldWiperSpeed::OFF;
+            isWaitingToTurnOff = false;
+            return TurnOffCountdownEvent::EXPIRED;
+        }
+        
+        // If the delay hasn't passed, keep current wiper speed
+        return TurnOffCountdownEvent::NONE;
+    }
+    
+    // Either rain detected again (cancel turn-off and set new speed immediately)
+    // or target speed is OFF and wipers are already OFF
+    wiperSpeed = targetSpeed;
+    isWaitingToTurnOff = false;
+    return cancelledEvent;
+}
+
+template <typename CalibrationPolicy>
+bool BasicWindshieldWiperController<CalibrationPolicy>::isWaitingToTurnOffWipers() const {
+    return isWaitingToTurnOff;
+}
+
+template <typename CalibrationPolicy>
+int BasicWindshieldWiperController<CalibrationPolicy>::getRemainingTurnOffSeconds() const {
+    if (!isWaitingToTurnOff) {
+        return 0;
+    }
+    
+    return getRemainingTurnOffSeconds(std::chrono::steady_clock::now());
+}
+
+template <typename CalibrationPolicy>
+int BasicWindshieldWiperController<CalibrationPolicy>::getRemainingTurnOffSeconds(std::chrono::steady_clock::time_point currentTime) const {
+    if (!isWaitingToTurnOff) {
+        return 0;
+    }
+    
+    auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - turnOffStartTime);
+    int remainingSeconds = TURN_OFF_DELAY_SECONDS - static_cast<int>(elapsedTime.count());
+    
+    return (remainingSeconds > 0) ? remainingSeconds : 0;
+}
+
+template <typename CalibrationPolicy>
+std::chrono::steady_clock::time_point BasicWindshieldWiperController<CalibrationPolicy>::getTurnOffStartTime() const {
+    return turnOffStartTime;
+}
+
+template <typename CalibrationPolicy>
+void BasicWindshieldWiperController<CalibrationPolicy>::restoreState(WindshieldWiperSpeed newWiperSpeed,
+                                                                     WaterSprayMode newSprayMode,
+                                                                     OperatingMode newOperatingMode,
+                                                                     bool newIsWaitingToTurnOff,
+                                                                     std::chrono::steady_clock::time_point newTurnOffStartTime) {
+    currentWiperSpeed = newWiperSpeed;
+    currentWaterSprayMode = newSprayMode;
+    currentOperatingMode = newOperatingMode;
+    isWaitingToTurnOff = newIsWaitingToTurnOff;
+    turnOffStartTime = newTurnOffStartTime;
+}
+
+extern template class BasicWindshieldWiperController<DefaultWiperCalibration>;
+
 #endif // WINDSHIELD_WIPER_CONTROLLER_H
\ No newline at end of file
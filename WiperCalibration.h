@@ -0,0 +1,26 @@
+#ifndef WIPER_CALIBRATION_H
+#define WIPER_CALIBRATION_H
+
+/**
+ * @brief Default calibration policy for the rain-sensing wiper system
+ *
+ * A calibration is any type with these constexpr members. Controllers take it as a
+ * template argument (BasicWindshieldWiperController<Calibration>), so every threshold
+ * is a compile-time constant folded into the decision rules. To calibrate a vehicle,
+ * declare a struct with the same members and instantiate the controller with it.
+ * Members are only read by value, so no out-of-line definitions are needed.
+ */
+struct DefaultWiperCalibration {
+    // Light percentage at or above which each speed applies (below all three: HIGH)
+    static constexpr double OFF_MIN_LIGHT_PERCENTAGE = 80.0;
+    static constexpr double LOW_MIN_LIGHT_PERCENTAGE = 50.0;
+    static constexpr double MEDIUM_MIN_LIGHT_PERCENTAGE = 20.0;
+
+    // Drop in light percentage between two readings that counts as a sudden rain burst
+    static constexpr double SUDDEN_BURST_DELTA_PERCENTAGE = 30.0;
+
+    // Dry time before the wipers turn off
+    static constexpr int TURN_OFF_DELAY_SECONDS = 10;
+};
+
+#endif // WIPER_CALIBRATION_H
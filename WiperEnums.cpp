@@ -1,6 +1,14 @@
 #include "WiperEnums.h"
 
 std::string convertWiperSpeedToString(WindshieldWiperSpeed wiperSpeed) {
+    return getWiperSpeedName(wiperSpeed);
+}
+
+std::string convertSprayModeToString(WaterSprayMode sprayMode) {
+    return getSprayModeName(sprayMode);
+}
+
+const char* getWiperSpeedName(WindshieldWiperSpeed wiperSpeed) {
     switch (wiperSpeed) {
         case WindshieldWiperSpeed::OFF: return "OFF";
         case WindshieldWiperSpeed::LOW: return "LOW";
@@ -10,7 +18,7 @@ std::string convertWiperSpeedToString(WindshieldWiperSpeed wiperSpeed) {
     }
 }
 
-std::string convertSprayModeToString(WaterSprayMode sprayMode) {
+const char* getSprayModeName(WaterSprayMode sprayMode) {
     switch (sprayMode) {
         case WaterSprayMode::OFF: return "OFF";
         case WaterSprayMode::LIGHT_SPRAY: return "LIGHT SPRAY";
@@ -30,6 +30,16 @@ enum class WaterSprayMode {
     HEAVY_SPRAY
 };
 
+/**
+ * @brief Enum for turn-off countdown changes produced by automatic mode rules
+ */
+enum class TurnOffCountdownEvent {
+    NONE,
+    STARTED,
+    CANCELLED,
+    EXPIRED
+};
+
 /**
  * @brief Convert WindshieldWiperSpeed to string representation
  * @param wiperSpeed The wiper speed to convert
@@ -44,4 +54,18 @@ std::string convertWiperSpeedToString(WindshieldWiperSpeed wiperSpeed);
  */
 std::string convertSprayModeToString(WaterSprayMode sprayMode);
 
+/**
+ * @brief Get the static name of a wiper speed without allocating
+ * @param wiperSpeed The wiper speed to name
+ * @return Null-terminated name with static storage duration
+ */
+const char* getWiperSpeedName(WindshieldWiperSpeed wiperSpeed);
+
+/**
+ * @brief Get the static name of a spray mode without allocating
+ * @param sprayMode The spray mode to name
+ * @return Null-terminated name with static storage duration
+ */
+const char* getSprayModeName(WaterSprayMode sprayMode);
+
 #endif // WIPER_ENUMS_H
\ No newline at end of file
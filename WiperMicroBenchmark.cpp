@@ -0,0 +1,380 @@
+#include "AllocationCounter.h"
+#include "AutomaticModeTransitionTable.h"
+#include "PackedControllerState.h"
+#include "RainSensor.h"
+#include "StatusDisplay.h"
+#include "StatusLineRenderer.h"
+#include "WindshieldWiperController.h"
+#include "WiperSpeedThresholdTable.h"
+#include "WiperEnums.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Structure to hold the result of one microbenchmark
+ */
+struct BenchmarkResult {
+    std::string benchmarkName;
+    std::uint64_t iterationCount;
+    double nanosecondsPerOperation;
+    double allocationsPerOperation;
+    double allocatedBytesPerOperation;
+};
+
+// Results are folded into this so the compiler cannot drop the measured work
+static volatile std::uint64_t benchmarkSink = 0;
+
+const int REPETITION_COUNT = 5;
+
+/**
+ * @brief Time an operation and count its heap allocations
+ * @param benchmarkName Name reported for the benchmark
+ * @param operation Callable taking the iteration index and returning a value to keep alive
+ * @param minimumRepetitionSeconds Minimum duration of each timed repetition
+ * @return Median ns/op over the repetitions, and allocations per operation
+ */
+template <typename Operation>
+static BenchmarkResult runBenchmark(const std::string& benchmarkName, Operation operation, double minimumRepetitionSeconds) {
+    // Calibrate: double the batch until one batch runs for the repetition time
+    std::uint64_t iterationCount = 1;
+    std::uint64_t iterationIndex = 0;
+    while (true) {
+        auto batchStartTime = std::chrono::steady_clock::now();
+        std::uint64_t batchResult = 0;
+        for (std::uint64_t batchIndex = 0; batchIndex < iterationCount; batchIndex++) {
+            batchResult += operation(iterationIndex++);
+        }
+        double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStartTime).count();
+        benchmarkSink = benchmarkSink + batchResult;
+        if (batchSeconds >= minimumRepetitionSeconds || iterationCount >= (1ULL << 40)) {
+            break;
+        }
+        iterationCount *= 2;
+    }
+
+    // Reserved up front so the harness itself allocates nothing while counting
+    std::vector<double> repetitionNanoseconds;
+    repetitionNanoseconds.reserve(REPETITION_COUNT);
+    std::uint64_t firstAllocationCount = AllocationCounter::getAllocationCount();
+    std::uint64_t firstAllocatedBytes = AllocationCounter::getAllocatedBytes();
+    for (int repetitionIndex = 0; repetitionIndex < REPETITION_COUNT; repetitionIndex++) {
+        auto repetitionStartTime = std::chrono::steady_clock::now();
+        std::uint64_t repetitionResult = 0;
+        for (std::uint64_t batchIndex = 0; batchIndex < iterationCount; batchIndex++) {
+            repetitionResult += operation(iterationIndex++);
+        }
+        auto repetitionEndTime = std::chrono::steady_clock::now();
+        benchmarkSink = benchmarkSink + repetitionResult;
+        repetitionNanoseconds.push_back(std::chrono::duration<double, std::nano>(repetitionEndTime - repetitionStartTime).count() / iterationCount);
+    }
+    std::uint64_t measuredAllocationCount = AllocationCounter::getAllocationCount() - firstAllocationCount;
+    std::uint64_t measuredAllocatedBytes = AllocationCounter::getAllocatedBytes() - firstAllocatedBytes;
+
+    std::sort(repetitionNanoseconds.begin(), repetitionNanoseconds.end());
+    double measuredOperationCount = static_cast<double>(iterationCount) * REPETITION_COUNT;
+
+    BenchmarkResult benchmarkResult;
+    benchmarkResult.benchmarkName = benchmarkName;
+    benchmarkResult.iterationCount = iterationCount;
+    benchmarkResult.nanosecondsPerOperation = repetitionNanoseconds[REPETITION_COUNT / 2];
+    benchmarkResult.allocationsPerOperation = measuredAllocationCount / measuredOperationCount;
+    benchmarkResult.allocatedBytesPerOperation = measuredAllocatedBytes / measuredOperationCount;
+    return benchmarkResult;
+}
+
+/**
+ * @brief Write results as JSON for regression tracking
+ * @param outputStream Stream to write to
+ * @param benchmarkResults Results to write
+ */
+static void writeJsonResults(std::ostream& outputStream, const std::vector<BenchmarkResult>& benchmarkResults) {
+    outputStream << "{\n  \"context\": {\"hardware_threads\": " << std::thread::hardware_concurrency()
+                 << ", \"repetitions\": " << REPETITION_COUNT << "},\n  \"benchmarks\": [\n";
+    for (std::size_t resultIndex = 0; resultIndex < benchmarkResults.size(); resultIndex++) {
+        const BenchmarkResult& benchmarkResult = benchmarkResults[resultIndex];
+        outputStream << "    {\"name\": \"" << benchmarkResult.benchmarkName << "\""
+                     << ", \"iterations\": " << benchmarkResult.iterationCount
+                     << std::fixed << std::setprecision(3)
+                     << ", \"ns_per_op\": " << benchmarkResult.nanosecondsPerOperation
+                     << ", \"allocs_per_op\": " << benchmarkResult.allocationsPerOperation
+                     << ", \"bytes_per_op\": " << benchmarkResult.allocatedBytesPerOperation << "}"
+                     << (resultIndex + 1 < benchmarkResults.size() ? ",\n" : "\n");
+    }
+    outputStream << "  ]\n}\n";
+}
+
+/**
+ * @brief Microbenchmarks for the per-tick sense, decide and report functions
+ *
+ * Usage: WiperMicroBenchmark [--filter=TEXT] [--min-time-ms=N] [--json=PATH]
+ * Prints ns/op and heap allocations per op for each benchmark whose name contains TEXT;
+ * --json writes the same results as JSON to PATH ("-" for standard output).
+ * @return Exit status code
+ */
+int main(int argc, char* argv[]) {
+    const char* benchmarkFilter = "";
+    double minimumRepetitionSeconds = 0.1;
+    const char* jsonOutputPath = nullptr;
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        const char* argument = argv[argumentIndex];
+        if (std::strncmp(argument, "--filter=", 9) == 0) {
+            benchmarkFilter = argument + 9;
+        } else if (std::strncmp(argument, "--min-time-ms=", 14) == 0) {
+            minimumRepetitionSeconds = std::strtoul(argument + 14, nullptr, 10) / 1000.0;
+        } else if (std::strncmp(argument, "--json=", 7) == 0) {
+            jsonOutputPath = argument + 7;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--filter=TEXT] [--min-time-ms=N] [--json=PATH]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Fixed, reproducible inputs shared by the controller and display benchmarks
+    const std::size_t INPUT_COUNT = 1024;
+    RainSensor inputSensor(1, 0);
+    inputSensor.subscribeChannels(RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_FAILURE);
+    std::vector<RainSensor::SensorReadingData> sensorReadings(INPUT_COUNT);
+    std::vector<double> lightPercentages(INPUT_COUNT);
+    for (std::size_t inputIndex = 0; inputIndex < INPUT_COUNT; inputIndex++) {
+        sensorReadings[inputIndex] = inputSensor.readSensorData();
+        lightPercentages[inputIndex] = sensorReadings[inputIndex].lightPercentage;
+    }
+
+    std::vector<BenchmarkResult> benchmarkResults;
+    auto isSelected = [benchmarkFilter](const char* benchmarkName) {
+        return std::strstr(benchmarkName, benchmarkFilter) != nullptr;
+    };
+
+    if (isSelected("RainSensor::readSensorData/counter-based")) {
+        RainSensor counterBasedSensor(1, 0);
+        counterBasedSensor.subscribeChannels(RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_FAILURE);
+        benchmarkResults.push_back(runBenchmark("RainSensor::readSensorData/counter-based", [&counterBasedSensor](std::uint64_t) {
+            RainSensor::SensorReadingData sensorData = counterBasedSensor.readSensorData();
+            return static_cast<std::uint64_t>(sensorData.lightPercentage) + (sensorData.isSuddenRainBurst ? 1 : 0);
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("RainSensor::readSensorData/mt19937")) {
+        RainSensor clockSeededSensor;
+        benchmarkResults.push_back(runBenchmark("RainSensor::readSensorData/mt19937", [&clockSeededSensor](std::uint64_t) {
+            RainSensor::SensorReadingData sensorData = clockSeededSensor.readSensorData();
+            return static_cast<std::uint64_t>(sensorData.lightPercentage) + (sensorData.isSuddenRainBurst ? 1 : 0);
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("WindshieldWiperController::mapLightPercentageToWiperSpeed")) {
+        benchmarkResults.push_back(runBenchmark("WindshieldWiperController::mapLightPercentageToWiperSpeed", [&lightPercentages, INPUT_COUNT](std::uint64_t iterationIndex) {
+            return static_cast<std::uint64_t>(WindshieldWiperController::mapLightPercentageToWiperSpeed(lightPercentages[iterationIndex % INPUT_COUNT]));
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("WindshieldWiperController::processAutomaticModeOperation")) {
+        // Virtual time advancing 100 ms per sample, so turn-off countdowns start, expire and cancel
+        WindshieldWiperController wiperController;
+        std::chrono::steady_clock::time_point startTime;
+        benchmarkResults.push_back(runBenchmark("WindshieldWiperController::processAutomaticModeOperation", [&wiperController, &sensorReadings, startTime, INPUT_COUNT](std::uint64_t iterationIndex) {
+            wiperController.processAutomaticModeOperation(sensorReadings[iterationIndex % INPUT_COUNT],
+                                                          startTime + std::chrono::milliseconds(iterationIndex * 100));
+            return static_cast<std::uint64_t>(wiperController.getCurrentWiperSpeed());
+        }, minimumRepetitionSeconds));
+    }
+
+    // Batch light-to-level mapping over the same readings, full precision vs 0.01 % fixed point
+    WiperSpeedThresholdTable thresholdTable = WiperSpeedThresholdTable::createDefaultTable();
+    std::vector<std::uint16_t> lightCentiPercents(INPUT_COUNT);
+    std::vector<std::uint8_t> speedLevels(INPUT_COUNT);
+    for (std::size_t inputIndex = 0; inputIndex < INPUT_COUNT; inputIndex++) {
+        lightCentiPercents[inputIndex] = RainSensor::quantizePercentage(lightPercentages[inputIndex]);
+    }
+
+    if (isSelected("WiperSpeedThresholdTable::mapLightPercentagesToLevels/batch-1024")) {
+        benchmarkResults.push_back(runBenchmark("WiperSpeedThresholdTable::mapLightPercentagesToLevels/batch-1024", [&](std::uint64_t iterationIndex) {
+            thresholdTable.mapLightPercentagesToLevels(lightPercentages.data(), speedLevels.data(), INPUT_COUNT);
+            return static_cast<std::uint64_t>(speedLevels[iterationIndex % INPUT_COUNT]);
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("WiperSpeedThresholdTable::mapQuantizedLightToLevels/batch-1024")) {
+        benchmarkResults.push_back(runBenchmark("WiperSpeedThresholdTable::mapQuantizedLightToLevels/batch-1024", [&](std::uint64_t iterationIndex) {
+            thresholdTable.mapQuantizedLightToLevels(lightCentiPercents.data(), speedLevels.data(), INPUT_COUNT);
+            return static_cast<std::uint64_t>(speedLevels[iterationIndex % INPUT_COUNT]);
+        }, minimumRepetitionSeconds));
+    }
+
+    // Batch stepping of INPUT_COUNT controllers stored as parallel arrays, as the fleet engine does;
+    // inputs are doubled so each batch can start at a different offset without copying
+    std::vector<std::uint8_t> batchValidFlags(2 * INPUT_COUNT);
+    std::vector<std::uint8_t> batchBurstFlags(2 * INPUT_COUNT);
+    std::vector<WindshieldWiperSpeed> batchTargetSpeeds(2 * INPUT_COUNT);
+    std::vector<std::uint8_t> batchElapsedFlags(2 * INPUT_COUNT);
+    for (std::size_t inputIndex = 0; inputIndex < 2 * INPUT_COUNT; inputIndex++) {
+        const RainSensor::SensorReadingData& sensorData = sensorReadings[inputIndex % INPUT_COUNT];
+        batchValidFlags[inputIndex] = sensorData.isValidReading ? 1 : 0;
+        batchBurstFlags[inputIndex] = sensorData.isSuddenRainBurst ? 1 : 0;
+        batchTargetSpeeds[inputIndex] = WindshieldWiperController::mapLightPercentageToWiperSpeed(sensorData.lightPercentage);
+        batchElapsedFlags[inputIndex] = (inputIndex % 7 == 0) ? 1 : 0;
+    }
+    std::vector<OperatingMode> batchOperatingModes(INPUT_COUNT, OperatingMode::AUTOMATIC);
+    std::vector<WindshieldWiperSpeed> batchWiperSpeeds(INPUT_COUNT, WindshieldWiperSpeed::OFF);
+    std::vector<std::uint8_t> batchWaitingFlags(INPUT_COUNT, 0);
+    std::vector<TurnOffCountdownEvent> batchCountdownEvents(INPUT_COUNT, TurnOffCountdownEvent::NONE);
+
+    if (isSelected("applyAutomaticModeRules/batch-1024")) {
+        benchmarkResults.push_back(runBenchmark("applyAutomaticModeRules/batch-1024", [&](std::uint64_t iterationIndex) {
+            std::size_t inputOffset = static_cast<std::size_t>(iterationIndex % INPUT_COUNT);
+            std::uint64_t startedCount = 0;
+            for (std::size_t controllerIndex = 0; controllerIndex < INPUT_COUNT; controllerIndex++) {
+                if (batchOperatingModes[controllerIndex] != OperatingMode::AUTOMATIC) {
+                    continue;
+                }
+                std::size_t inputIndex = inputOffset + controllerIndex;
+                RainSensor::SensorReadingData sensorData = RainSensor::SensorReadingData();
+                sensorData.isValidReading = batchValidFlags[inputIndex] != 0;
+                sensorData.isSuddenRainBurst = batchBurstFlags[inputIndex] != 0;
+                bool isWaitingToTurnOff = batchWaitingFlags[controllerIndex] != 0;
+                TurnOffCountdownEvent countdownEvent = WindshieldWiperController::applyAutomaticModeRules(
+                    sensorData, batchTargetSpeeds[inputIndex], batchWiperSpeeds[controllerIndex],
+                    isWaitingToTurnOff, batchElapsedFlags[inputIndex] != 0);
+                batchWaitingFlags[controllerIndex] = isWaitingToTurnOff ? 1 : 0;
+                startedCount += (countdownEvent == TurnOffCountdownEvent::STARTED) ? 1 : 0;
+            }
+            return startedCount;
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("AutomaticModeTransitionTable::stepBatch/batch-1024")) {
+        AutomaticModeTransitionTable transitionTable;
+        std::fill(batchWiperSpeeds.begin(), batchWiperSpeeds.end(), WindshieldWiperSpeed::OFF);
+        std::fill(batchWaitingFlags.begin(), batchWaitingFlags.end(), 0);
+        benchmarkResults.push_back(runBenchmark("AutomaticModeTransitionTable::stepBatch/batch-1024", [&](std::uint64_t iterationIndex) {
+            std::size_t inputOffset = static_cast<std::size_t>(iterationIndex % INPUT_COUNT);
+            transitionTable.stepBatch(batchValidFlags.data() + inputOffset, batchBurstFlags.data() + inputOffset,
+                                      batchTargetSpeeds.data() + inputOffset, batchElapsedFlags.data() + inputOffset,
+                                      batchOperatingModes.data(), batchWiperSpeeds.data(), batchWaitingFlags.data(),
+                                      batchCountdownEvents.data(), INPUT_COUNT);
+            return static_cast<std::uint64_t>(batchCountdownEvents[inputOffset]);
+        }, minimumRepetitionSeconds));
+    }
+
+    // Streaming a million-vehicle fleet in 4096-vehicle chunks (one chunk per op), so the
+    // state comes from memory rather than L1: full controllers vs packed 8-byte states
+    const std::size_t FLEET_VEHICLE_COUNT = 1000000;
+    const std::size_t FLEET_CHUNK_SIZE = 4096;
+    const std::size_t FLEET_CHUNK_COUNT = (FLEET_VEHICLE_COUNT + FLEET_CHUNK_SIZE - 1) / FLEET_CHUNK_SIZE;
+
+    if (isSelected("WindshieldWiperController::processAutomaticModeOperation/fleet-1M")) {
+        std::vector<WindshieldWiperController> fleetControllers(FLEET_VEHICLE_COUNT);
+        std::chrono::steady_clock::time_point startTime;
+        benchmarkResults.push_back(runBenchmark("WindshieldWiperController::processAutomaticModeOperation/fleet-1M", [&](std::uint64_t iterationIndex) {
+            std::size_t chunkBegin = static_cast<std::size_t>(iterationIndex % FLEET_CHUNK_COUNT) * FLEET_CHUNK_SIZE;
+            std::size_t chunkEnd = std::min(chunkBegin + FLEET_CHUNK_SIZE, FLEET_VEHICLE_COUNT);
+            std::chrono::steady_clock::time_point currentTime = startTime + std::chrono::milliseconds((iterationIndex / FLEET_CHUNK_COUNT) * 100);
+            std::uint64_t startedCount = 0;
+            for (std::size_t vehicleIndex = chunkBegin; vehicleIndex < chunkEnd; vehicleIndex++) {
+                TurnOffCountdownEvent countdownEvent = fleetControllers[vehicleIndex].processAutomaticModeOperation(
+                    sensorReadings[(vehicleIndex + iterationIndex) % INPUT_COUNT], currentTime);
+                startedCount += (countdownEvent == TurnOffCountdownEvent::STARTED) ? 1 : 0;
+            }
+            return startedCount;
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("PackedControllerState::processAutomaticModeOperation/fleet-1M")) {
+        std::vector<PackedControllerState> fleetStates(FLEET_VEHICLE_COUNT);
+        std::uint32_t turnOffDelayTicks = PackedControllerState::computeTurnOffDelayTicks(100);
+        benchmarkResults.push_back(runBenchmark("PackedControllerState::processAutomaticModeOperation/fleet-1M", [&](std::uint64_t iterationIndex) {
+            std::size_t chunkBegin = static_cast<std::size_t>(iterationIndex % FLEET_CHUNK_COUNT) * FLEET_CHUNK_SIZE;
+            std::size_t chunkEnd = std::min(chunkBegin + FLEET_CHUNK_SIZE, FLEET_VEHICLE_COUNT);
+            std::uint64_t currentTick = iterationIndex / FLEET_CHUNK_COUNT;
+            std::uint64_t startedCount = 0;
+            for (std::size_t vehicleIndex = chunkBegin; vehicleIndex < chunkEnd; vehicleIndex++) {
+                TurnOffCountdownEvent countdownEvent = fleetStates[vehicleIndex].processAutomaticModeOperation(
+                    sensorReadings[(vehicleIndex + iterationIndex) % INPUT_COUNT], currentTick, turnOffDelayTicks);
+                startedCount += (countdownEvent == TurnOffCountdownEvent::STARTED) ? 1 : 0;
+            }
+            return startedCount;
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("convertWiperSpeedToString")) {
+        benchmarkResults.push_back(runBenchmark("convertWiperSpeedToString", [](std::uint64_t iterationIndex) {
+            return static_cast<std::uint64_t>(convertWiperSpeedToString(static_cast<WindshieldWiperSpeed>(iterationIndex & 3)).size());
+        }, minimumRepetitionSeconds));
+    }
+
+    if (isSelected("StatusLineRenderer::renderAutomaticModeStatusLine")) {
+        // Same status line runSystem prints in auto mode, handed to a discarding stream in one write
+        WindshieldWiperController wiperController;
+        std::chrono::steady_clock::time_point startTime;
+        StatusLineRenderer statusLineRenderer;
+        DiscardingStreamBuffer discardingBuffer;
+        std::ostream discardingStream(&discardingBuffer);
+        benchmarkResults.push_back(runBenchmark("StatusLineRenderer::renderAutomaticModeStatusLine", [&wiperController, &sensorReadings, &statusLineRenderer, &discardingStream, startTime, INPUT_COUNT](std::uint64_t iterationIndex) {
+            const RainSensor::SensorReadingData& sensorData = sensorReadings[iterationIndex % INPUT_COUNT];
+            std::chrono::steady_clock::time_point currentTime = startTime + std::chrono::milliseconds(iterationIndex * 100);
+            wiperController.processAutomaticModeOperation(sensorData, currentTime);
+            statusLineRenderer.renderAutomaticModeStatusLine(sensorData, sensorData.isSuddenRainBurst, wiperController, currentTime);
+            statusLineRenderer.writeToStream(discardingStream);
+            return static_cast<std::uint64_t>(statusLineRenderer.getLineLength());
+        }, minimumRepetitionSeconds));
+    }
+
+#if !defined(_WIN32)
+    if (isSelected("StatusLineRenderer::writeToFileDescriptor")) {
+        // Render plus the one write(2) per frame, to /dev/null so only the syscall is paid
+        WindshieldWiperController wiperController;
+        std::chrono::steady_clock::time_point startTime;
+        StatusLineRenderer statusLineRenderer;
+        int nullFileDescriptor = ::open("/dev/null", O_WRONLY);
+        benchmarkResults.push_back(runBenchmark("StatusLineRenderer::writeToFileDescriptor", [&wiperController, &sensorReadings, &statusLineRenderer, nullFileDescriptor, startTime, INPUT_COUNT](std::uint64_t iterationIndex) {
+            const RainSensor::SensorReadingData& sensorData = sensorReadings[iterationIndex % INPUT_COUNT];
+            std::chrono::steady_clock::time_point currentTime = startTime + std::chrono::milliseconds(iterationIndex * 100);
+            wiperController.processAutomaticModeOperation(sensorData, currentTime);
+            statusLineRenderer.renderAutomaticModeStatusLine(sensorData, sensorData.isSuddenRainBurst, wiperController, currentTime);
+            return static_cast<std::uint64_t>(statusLineRenderer.writeToFileDescriptor(nullFileDescriptor) ? 1 : 0);
+        }, minimumRepetitionSeconds));
+        ::close(nullFileDescriptor);
+    }
+#endif
+
+    // JSON on standard output replaces the table so it can be piped straight into a tracker
+    bool isJsonOnStandardOutput = (jsonOutputPath != nullptr && std::strcmp(jsonOutputPath, "-") == 0);
+    if (isJsonOnStandardOutput) {
+        writeJsonResults(std::cout, benchmarkResults);
+        return 0;
+    }
+
+    std::cout << std::left << std::setw(60) << "Benchmark" << std::right << std::setw(14) << "ns/op"
+              << std::setw(14) << "allocs/op" << std::setw(14) << "bytes/op" << std::endl;
+    for (const BenchmarkResult& benchmarkResult : benchmarkResults) {
+        std::cout << std::left << std::setw(60) << benchmarkResult.benchmarkName << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(14) << benchmarkResult.nanosecondsPerOperation
+                  << std::setw(14) << benchmarkResult.allocationsPerOperation
+                  << std::setw(14) << benchmarkResult.allocatedBytesPerOperation << std::endl;
+    }
+
+    if (jsonOutputPath != nullptr) {
+        std::ofstream jsonFile(jsonOutputPath);
+        if (!jsonFile) {
+            std::cerr << "Could not create " << jsonOutputPath << std::endl;
+            return 1;
+        }
+        writeJsonResults(jsonFile, benchmarkResults);
+    }
+
+    return 0;
+}
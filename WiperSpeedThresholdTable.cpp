@@ -0,0 +1,186 @@
+#include "WiperSpeedThresholdTable.h"
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+WiperSpeedThresholdTable::WiperSpeedThresholdTable(const std::vector<double>& descendingThresholds)
+    : thresholds(descendingThresholds) {
+    if (thresholds.empty() || thresholds.size() > MAX_THRESHOLD_COUNT) {
+        throw std::invalid_argument("Threshold table needs between 1 and 16 thresholds");
+    }
+    for (std::size_t thresholdIndex = 1; thresholdIndex < thresholds.size(); thresholdIndex++) {
+        if (!(thresholds[thresholdIndex] < thresholds[thresholdIndex - 1])) {
+            throw std::invalid_argument("Threshold table must be strictly descending");
+        }
+    }
+    for (std::size_t thresholdIndex = 0; thresholdIndex < thresholds.size(); thresholdIndex++) {
+        // The fixed-point path only represents [0, 100] %, so reject anything it would wrap
+        if (!(thresholds[thresholdIndex] >= 0.0 && thresholds[thresholdIndex] <= 100.0)) {
+            throw std::invalid_argument("Threshold table thresholds must be within 0-100%");
+        }
+        quantizedThresholds.push_back(static_cast<std::int16_t>(RainSensor::quantizeThreshold(thresholds[thresholdIndex])));
+    }
+}
+
+WiperSpeedThresholdTable WiperSpeedThresholdTable::createDefaultTable() {
+    return createCalibratedTable<DefaultWiperCalibration>();
+}
+
+std::size_t WiperSpeedThresholdTable::getLevelCount() const {
+    return thresholds.size() + 1;
+}
+
+std::uint8_t WiperSpeedThresholdTable::mapLightPercentageToLevel(double lightPercentage) const {
+    // "Not >=" rather than "<" so that NaN lands in the last level, like the scalar else-branch
+    std::uint8_t level = 0;
+    for (std::size_t thresholdIndex = 0; thresholdIndex < thresholds.size(); thresholdIndex++) {
+        level += !(lightPercentage >= thresholds[thresholdIndex]) ? 1 : 0;
+    }
+    return level;
+}
+
+void WiperSpeedThresholdTable::mapLightPercentagesToLevels(const double* lightPercentages, std::uint8_t* levels, std::size_t sampleCount) const {
+    const std::size_t thresholdCount = thresholds.size();
+    std::size_t sampleIndex = 0;
+
+#if defined(__AVX2__)
+    __m256d broadcastThresholds[MAX_THRESHOLD_COUNT];
+    for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+        broadcastThresholds[thresholdIndex] = _mm256_set1_pd(thresholds[thresholdIndex]);
+    }
+    const __m256i lowDwordSelector = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+    // Eight samples per pass: two vectors of four doubles, packed to eight level bytes
+    for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+        __m256d lowSamples = _mm256_loadu_pd(lightPercentages + sampleIndex);
+        __m256d highSamples = _mm256_loadu_pd(lightPercentages + sampleIndex + 4);
+        __m256i lowCounts = _mm256_setzero_si256();
+        __m256i highCounts = _mm256_setzero_si256();
+        for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+            // Each all-ones mask lane is -1, so subtracting it counts one threshold not reached
+            lowCounts = _mm256_sub_epi64(lowCounts, _mm256_castpd_si256(
+                _mm256_cmp_pd(lowSamples, broadcastThresholds[thresholdIndex], _CMP_NGE_UQ)));
+            highCounts = _mm256_sub_epi64(highCounts, _mm256_castpd_si256(
+                _mm256_cmp_pd(highSamples, broadcastThresholds[thresholdIndex], _CMP_NGE_UQ)));
+        }
+        __m128i lowDwords = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(lowCounts, lowDwordSelector));
+        __m128i highDwords = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(highCounts, lowDwordSelector));
+        __m128i packedWords = _mm_packs_epi32(lowDwords, highDwords);
+        __m128i packedBytes = _mm_packus_epi16(packedWords, packedWords);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(levels + sampleIndex), packedBytes);
+    }
+#elif defined(__SSE2__)
+    __m128d broadcastThresholds[MAX_THRESHOLD_COUNT];
+    for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+        broadcastThresholds[thresholdIndex] = _mm_set1_pd(thresholds[thresholdIndex]);
+    }
+
+    // Four samples per pass: two vectors of two doubles, packed to four level bytes
+    for (; sampleIndex + 4 <= sampleCount; sampleIndex += 4) {
+        __m128d lowSamples = _mm_loadu_pd(lightPercentages + sampleIndex);
+        __m128d highSamples = _mm_loadu_pd(lightPercentages + sampleIndex + 2);
+        __m128i lowCounts = _mm_setzero_si128();
+        __m128i highCounts = _mm_setzero_si128();
+        for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+            // Each all-ones mask lane is -1, so subtracting it counts one threshold not reached
+            lowCounts = _mm_sub_epi64(lowCounts, _mm_castpd_si128(_mm_cmpnge_pd(lowSamples, broadcastThresholds[thresholdIndex])));
+            highCounts = _mm_sub_epi64(highCounts, _mm_castpd_si128(_mm_cmpnge_pd(highSamples, broadcastThresholds[thresholdIndex])));
+        }
+        __m128i lowDwords = _mm_shuffle_epi32(lowCounts, _MM_SHUFFLE(3, 3, 2, 0));
+        __m128i highDwords = _mm_shuffle_epi32(highCounts, _MM_SHUFFLE(3, 3, 2, 0));
+        __m128i combinedDwords = _mm_unpacklo_epi64(lowDwords, highDwords);
+        __m128i packedWords = _mm_packs_epi32(combinedDwords, combinedDwords);
+        __m128i packedBytes = _mm_packus_epi16(packedWords, packedWords);
+        int fourLevels = _mm_cvtsi128_si32(packedBytes);
+        std::memcpy(levels + sampleIndex, &fourLevels, sizeof(fourLevels));
+    }
+#endif
+
+    // Scalar tail (and the whole batch when no SIMD instruction set is available)
+    for (; sampleIndex < sampleCount; sampleIndex++) {
+        levels[sampleIndex] = mapLightPercentageToLevel(lightPercentages[sampleIndex]);
+    }
+}
+
+std::uint8_t WiperSpeedThresholdTable::mapQuantizedLightToLevel(std::uint16_t lightCentiPercent) const {
+    // Valid levels fit in 15 bits, so as a signed value the invalid marker (0xFFFF) is -1
+    std::int16_t signedLevel = static_cast<std::int16_t>(lightCentiPercent);
+    std::uint8_t level = 0;
+    for (std::size_t thresholdIndex = 0; thresholdIndex < quantizedThresholds.size(); thresholdIndex++) {
+        level += (signedLevel < quantizedThresholds[thresholdIndex]) ? 1 : 0;
+    }
+    return level;
+}
+
+void WiperSpeedThresholdTable::mapQuantizedLightToLevels(const std::uint16_t* lightCentiPercents, std::uint8_t* levels, std::size_t sampleCount) const {
+    const std::size_t thresholdCount = quantizedThresholds.size();
+    std::size_t sampleIndex = 0;
+
+#if defined(__AVX2__)
+    __m256i broadcastThresholds[MAX_THRESHOLD_COUNT];
+    for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+        broadcastThresholds[thresholdIndex] = _mm256_set1_epi16(quantizedThresholds[thresholdIndex]);
+    }
+
+    // Sixteen samples per pass in one vector (four doubles fit in the same width)
+    for (; sampleIndex + 16 <= sampleCount; sampleIndex += 16) {
+        __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lightCentiPercents + sampleIndex));
+        __m256i counts = _mm256_setzero_si256();
+        for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+            counts = _mm256_sub_epi16(counts, _mm256_cmpgt_epi16(broadcastThresholds[thresholdIndex], samples));
+        }
+        __m128i packedBytes = _mm_packus_epi16(_mm256_castsi256_si128(counts), _mm256_extracti128_si256(counts, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(levels + sampleIndex), packedBytes);
+    }
+#elif defined(__SSE2__)
+    __m128i broadcastThresholds[MAX_THRESHOLD_COUNT];
+    for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+        broadcastThresholds[thresholdIndex] = _mm_set1_epi16(quantizedThresholds[thresholdIndex]);
+    }
+
+    // Eight samples per pass in one vector (two doubles fit in the same width)
+    for (; sampleIndex + 8 <= sampleCount; sampleIndex += 8) {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lightCentiPercents + sampleIndex));
+        __m128i counts = _mm_setzero_si128();
+        for (std::size_t thresholdIndex = 0; thresholdIndex < thresholdCount; thresholdIndex++) {
+            counts = _mm_sub_epi16(counts, _mm_cmplt_epi16(samples, broadcastThresholds[thresholdIndex]));
+        }
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(levels + sampleIndex), _mm_packus_epi16(counts, counts));
+    }
+#endif
+
+    // Scalar tail (and the whole batch when no SIMD instruction set is available)
+    for (; sampleIndex < sampleCount; sampleIndex++) {
+        levels[sampleIndex] = mapQuantizedLightToLevel(lightCentiPercents[sampleIndex]);
+    }
+}
+
+void WiperSpeedThresholdTable::mapLightPercentagesToWiperSpeeds(const double* lightPercentages, WindshieldWiperSpeed* wiperSpeeds, std::size_t sampleCount) const {
+    const std::size_t CHUNK_SIZE = 256;
+    std::uint8_t chunkLevels[CHUNK_SIZE];
+    const std::uint8_t highestSpeedLevel = static_cast<std::uint8_t>(WindshieldWiperSpeed::HIGH);
+
+    for (std::size_t chunkStart = 0; chunkStart < sampleCount; chunkStart += CHUNK_SIZE) {
+        std::size_t chunkCount = (sampleCount - chunkStart < CHUNK_SIZE) ? (sampleCount - chunkStart) : CHUNK_SIZE;
+        mapLightPercentagesToLevels(lightPercentages + chunkStart, chunkLevels, chunkCount);
+        for (std::size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++) {
+            std::uint8_t level = (chunkLevels[chunkIndex] < highestSpeedLevel) ? chunkLevels[chunkIndex] : highestSpeedLevel;
+            wiperSpeeds[chunkStart + chunkIndex] = static_cast<WindshieldWiperSpeed>(level);
+        }
+    }
+}
+
+const char* WiperSpeedThresholdTable::getActiveInstructionSet() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "SCALAR";
+#endif
+}
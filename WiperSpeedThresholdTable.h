@@ -0,0 +1,107 @@
+#ifndef WIPER_SPEED_THRESHOLD_TABLE_H
+#define WIPER_SPEED_THRESHOLD_TABLE_H
+
+#include "WiperEnums.h"
+#include "WiperCalibration.h"
+#include "RainSensor.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief WiperSpeedThresholdTable class to map batches of light readings to speed levels
+ *
+ * A table of N descending light thresholds defines N + 1 levels. A reading's level is
+ * the number of thresholds it does not reach, which the batch kernels compute with SIMD
+ * compare-and-count (AVX2 or SSE2 when the compiler targets them, scalar otherwise).
+ * The default table (80/50/20) reproduces mapLightPercentageToWiperSpeed exactly.
+ * Fixed-point readings (0.01 % units) use 16-bit lanes, four times as many per vector.
+ */
+class WiperSpeedThresholdTable {
+public:
+    static const std::size_t MAX_THRESHOLD_COUNT = 16;
+
+    /**
+     * @brief Constructor for WiperSpeedThresholdTable
+     * @param descendingThresholds Strictly descending light thresholds in [0, 100] (at most MAX_THRESHOLD_COUNT)
+     * @throws std::invalid_argument If the thresholds are empty, too many, not descending or out of range
+     */
+    explicit WiperSpeedThresholdTable(const std::vector<double>& descendingThresholds);
+
+    /**
+     * @brief Create the table used by WindshieldWiperController (80/50/20)
+     * @return Default four-level table
+     */
+    static WiperSpeedThresholdTable createDefaultTable();
+
+    /**
+     * @brief Create the table used by BasicWindshieldWiperController<CalibrationPolicy>
+     * @tparam CalibrationPolicy Policy with the OFF/LOW/MEDIUM light thresholds (see DefaultWiperCalibration)
+     * @return Four-level table for that calibration
+     */
+    template <typename CalibrationPolicy>
+    static WiperSpeedThresholdTable createCalibratedTable() {
+        const double calibratedThresholds[] = {
+            CalibrationPolicy::OFF_MIN_LIGHT_PERCENTAGE,
+            CalibrationPolicy::LOW_MIN_LIGHT_PERCENTAGE,
+            CalibrationPolicy::MEDIUM_MIN_LIGHT_PERCENTAGE
+        };
+        return WiperSpeedThresholdTable(std::vector<double>(calibratedThresholds, calibratedThresholds + 3));
+    }
+
+    /**
+     * @brief Get the number of levels defined by the table
+     * @return Threshold count plus one
+     */
+    std::size_t getLevelCount() const;
+
+    /**
+     * @brief Map a single light reading to its level
+     * @param lightPercentage The light percentage from sensor
+     * @return Level index, 0 for the brightest band
+     */
+    std::uint8_t mapLightPercentageToLevel(double lightPercentage) const;
+
+    /**
+     * @brief Map an array of light readings to levels
+     * @param lightPercentages Input light readings
+     * @param levels Output level per reading
+     * @param sampleCount Number of readings
+     */
+    void mapLightPercentagesToLevels(const double* lightPercentages, std::uint8_t* levels, std::size_t sampleCount) const;
+
+    /**
+     * @brief Map an array of light readings to wiper speeds
+     * @param lightPercentages Input light readings
+     * @param wiperSpeeds Output wiper speed per reading (levels above HIGH are clamped)
+     * @param sampleCount Number of readings
+     */
+    void mapLightPercentagesToWiperSpeeds(const double* lightPercentages, WindshieldWiperSpeed* wiperSpeeds, std::size_t sampleCount) const;
+
+    /**
+     * @brief Map a single fixed-point light level to its level
+     * @param lightCentiPercent Light level in 0.01 % units (the invalid marker maps to the last level)
+     * @return Level index, 0 for the brightest band
+     */
+    std::uint8_t mapQuantizedLightToLevel(std::uint16_t lightCentiPercent) const;
+
+    /**
+     * @brief Map an array of fixed-point light levels to levels
+     * @param lightCentiPercents Input light levels in 0.01 % units
+     * @param levels Output level per reading
+     * @param sampleCount Number of readings
+     */
+    void mapQuantizedLightToLevels(const std::uint16_t* lightCentiPercents, std::uint8_t* levels, std::size_t sampleCount) const;
+
+    /**
+     * @brief Get the instruction set the batch kernels were compiled for
+     * @return "AVX2", "SSE2" or "SCALAR"
+     */
+    static const char* getActiveInstructionSet();
+
+private:
+    std::vector<double> thresholds;
+    std::vector<std::int16_t> quantizedThresholds; // Rounded up to the 0.01 % grid
+};
+
+#endif // WIPER_SPEED_THRESHOLD_TABLE_H
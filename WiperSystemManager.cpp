@@ -1,90 +1,120 @@
 #include "WiperSystemManager.h"
 #include <iostream>
-#include <iomanip>
-#include <sstream>
-#include <conio.h>
-#include <windows.h>
 #include <thread>
+#include <algorithm>
+#include "ConsoleInput.h"
+#include "ConsoleEventLoop.h"
+#include "LatencyTracer.h"
 
-WiperSystemManager::WiperSystemManager() : isSystemRunning(true) {
+WiperSystemManager::WiperSystemManager()
+    : isSystemRunning(true),
+      hasBurstInStatusWindow(false),
+      controlTicksSinceStatus(0),
+      statusDecimation(1),
+      headlessOutputDescriptor(-1),
+      lastControlTickTime(systemClock.now()) {
+    timingConfiguration.controlRateHz = 1;
+    timingConfiguration.statusRateHz = 1;
+    timingConfiguration.realtimeCpuIndex = -1;
+    timingConfiguration.isLatenessReportEnabled = false;
+    latestSensorData = RainSensor::SensorReadingData();
+    
+    // Automatic mode only acts on rain, so dew is not generated unless a trace records it
+    rainDetectionSensor.subscribeChannels(RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_FAILURE);
 }
 
-std::string WiperSystemManager::getCurrentTimeString() {
-    auto currentTimePoint = std::chrono::system_clock::now();
-    auto currentTimeValue = std::chrono::system_clock::to_time_t(currentTimePoint);
-    auto timeStructure = *std::localtime(&currentTimeValue);
-    
-    std::ostringstream timeStringStream;
-    timeStringStream << std::put_time(&timeStructure, "%H:%M:%S");
-    return timeStringStream.str();
+bool WiperSystemManager::enableEventLog(const std::string& logFilePath) {
+    return eventLogger.open(logFilePath);
 }
 
-void WiperSystemManager::logSystemEvent(const std::string& eventMessage) {
-    printColoredText("[" + getCurrentTimeString() + "] ", COLOR_CYAN);
-    std::cout << eventMessage << std::endl;
+bool WiperSystemManager::enableSensorTrace(const std::string& traceFilePath) {
+    rainDetectionSensor.subscribeChannels(RainSensor::CHANNEL_ALL);
+    lastControlTickTime = systemClock.now();
+    return sensorTraceRecorder.open(traceFilePath, lastControlTickTime);
 }
 
-void WiperSystemManager::displaySystemStatus(const RainSensor::SensorReadingData& sensorData, const std::string& alertMessage) {
-    // Print timestamp in cyan color
-    printColoredText("[" + getCurrentTimeString() + "] ", COLOR_CYAN);
-    
-    // Print current operating mode
-    std::cout << "Mode: ";
-    std::string operatingModeColor = (wiperController.getCurrentOperatingMode() == OperatingMode::AUTOMATIC) ? COLOR_GREEN : COLOR_BLUE;
-    std::string operatingModeText = (wiperController.getCurrentOperatingMode() == OperatingMode::AUTOMATIC) ? "AUTO" : "MANUAL";
-    printColoredText(operatingModeText, operatingModeColor);
+void WiperSystemManager::setSensorSeed(std::uint64_t seed) {
+    std::uint8_t subscribedChannels = rainDetectionSensor.getSubscribedChannels();
+    rainDetectionSensor = RainSensor(seed, 0);
+    rainDetectionSensor.subscribeChannels(subscribedChannels);
+}
+
+MetricsSnapshot WiperSystemManager::takeMetricsSnapshot() const {
+    return systemMetrics.takeSnapshot(systemClock.now());
+}
+
+bool WiperSystemManager::enableMetricsEndpoint(unsigned short listenPort) {
+    return metricsEndpoint.open(listenPort, [this]() { return takeMetricsSnapshot(); });
+}
+
+unsigned short WiperSystemManager::getMetricsEndpointPort() const {
+    return metricsEndpoint.getListenPort();
+}
+
+bool WiperSystemManager::enableSensorReplay(const std::string& traceFilePath) {
+    return sensorTraceReplayer.open(traceFilePath);
+}
+
+void WiperSystemManager::configureTiming(const SystemTimingConfiguration& newTimingConfiguration) {
+    timingConfiguration = newTimingConfiguration;
+    controlScheduler.setTickRate(timingConfiguration.controlRateHz);
     
-    // Print sensor reading status
-    std::cout << " | Sensor: ";
-    if (!sensorData.isValidReading) {
-        printColoredText("ERROR", COLOR_RED);
+    // Status lines are decimated from the control rate (rounded to a whole number of ticks)
+    unsigned int controlRateHz = controlScheduler.getTickRate();
+    unsigned int statusRateHz = (timingConfiguration.statusRateHz >= 1) ? timingConfiguration.statusRateHz : 1;
+    statusDecimation = (statusRateHz < controlRateHz) ? (controlRateHz + statusRateHz / 2) / statusRateHz : 1;
+}
+
+void WiperSystemManager::enableHeadlessConsole(int outputFileDescriptor) {
+    headlessOutputDescriptor = outputFileDescriptor;
+}
+
+const WindshieldWiperController& WiperSystemManager::getWiperController() const {
+    return wiperController;
+}
+
+bool WiperSystemManager::isRunning() const {
+    return isSystemRunning;
+}
+
+void WiperSystemManager::emitConsoleLine() {
+    if (headlessOutputDescriptor >= 0) {
+        statusLineRenderer.writeToFileDescriptor(headlessOutputDescriptor);
     } else {
-        printColoredText(std::to_string(static_cast<int>(sensorData.lightPercentage)) + "%", COLOR_WHITE);
+        statusLineRenderer.writeToConsole();
     }
+}
+
+void WiperSystemManager::logSystemEvent(const std::string& eventMessage) {
+    statusLineRenderer.renderEventLine(eventMessage);
+    emitConsoleLine();
+}
+
+void WiperSystemManager::recordSettingChange(SystemEventId eventId) {
+    // Replays restore this state, since auto ticks alone cannot reproduce manual changes.
+    // It is stamped on the control timeline: nothing acts on it before the next tick.
+    sensorTraceRecorder.recordStateResync(lastControlTickTime, wiperController);
     
-    // Print current wiper speed
-    std::cout << " | Wiper: ";
-    
-    // Color wiper status based on current speed
-    std::string wiperSpeedColor;
-    switch (wiperController.getCurrentWiperSpeed()) {
-        case WindshieldWiperSpeed::OFF:
-            wiperSpeedColor = COLOR_GRAY;
+    switch (eventId) {
+        case SystemEventId::OPERATING_MODE_CHANGED:
+            eventLogger.logEvent(eventId, 1, static_cast<std::int32_t>(wiperController.getCurrentOperatingMode()));
             break;
-        case WindshieldWiperSpeed::LOW:
-            wiperSpeedColor = COLOR_GREEN;
+        case SystemEventId::WIPER_SPEED_SET:
+            eventLogger.logEvent(eventId, 1, static_cast<std::int32_t>(wiperController.getCurrentWiperSpeed()));
+            systemMetrics.recordWiperSpeed(wiperController.getCurrentWiperSpeed(), systemClock.now());
             break;
-        case WindshieldWiperSpeed::MEDIUM:
-            wiperSpeedColor = COLOR_YELLOW;
+        case SystemEventId::SPRAY_MODE_SET:
+            eventLogger.logEvent(eventId, 1, static_cast<std::int32_t>(wiperController.getCurrentWaterSprayMode()));
             break;
-        case WindshieldWiperSpeed::HIGH:
-            wiperSpeedColor = COLOR_RED;
+        default:
+            eventLogger.logEvent(eventId);
             break;
     }
-    printColoredText(convertWiperSpeedToString(wiperController.getCurrentWiperSpeed()), wiperSpeedColor);
-    
-    // Only show spray status in manual mode
-    if (wiperController.getCurrentWaterSprayMode() != WaterSprayMode::OFF && wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-        std::cout << " | Spray: ";
-        std::string sprayColor = (wiperController.getCurrentWaterSprayMode() == WaterSprayMode::HEAVY_SPRAY) ? COLOR_BLUE : COLOR_CYAN;
-        printColoredText(convertSprayModeToString(wiperController.getCurrentWaterSprayMode()), sprayColor);
-    }
-    
-    // Print special conditions and alerts
-    if (sensorData.isSuddenRainBurst) {
-        printColoredText(" (Sudden Rain Burst)", COLOR_RED);
-    }
-    
-    // Only show dew detection in manual mode
-    if (sensorData.isDewPresent && wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-        printColoredText(" (Dew Detected: " + std::to_string(static_cast<int>(sensorData.dewLevel)) + "%)", COLOR_MAGENTA);
-    }
-    
-    if (!alertMessage.empty()) {
-        printColoredText(" (" + alertMessage + ")", COLOR_RED);
-    }
-    
-    std::cout << std::endl;
+}
+
+void WiperSystemManager::displaySystemStatus(const RainSensor::SensorReadingData& sensorData, const std::string& alertMessage) {
+    statusLineRenderer.renderSystemStatusLine(sensorData, wiperController, alertMessage);
+    emitConsoleLine();
 }
 
 void WiperSystemManager::displayHelpInformation() {
@@ -114,7 +144,7 @@ OperatingMode WiperSystemManager::selectInitialOperatingMode() {
         printColoredText("  2 - Auto Mode (Rain Sensing)\n", COLOR_GREEN);
         std::cout << "Enter your choice (1 or 2): ";
         
-        userChoice = static_cast<char>(_getch());
+        userChoice = readConsoleCharacter();
         std::cout << userChoice << std::endl;
         
         if (userChoice == '1') {
@@ -123,8 +153,8 @@ OperatingMode WiperSystemManager::selectInitialOperatingMode() {
             return OperatingMode::AUTOMATIC;
         } else {
             std::cout << "Invalid choice. Please enter 1 or 2." << std::endl;
-            Sleep(1000);
-            system("cls");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            clearConsoleScreen();
         }
     }
 }
@@ -139,7 +169,7 @@ void WiperSystemManager::selectManualWiperSpeed() {
         printColoredText("  3 - HIGH speed\n", COLOR_GREEN);
         std::cout << "Enter your choice (0-3): ";
         
-        userChoice = static_cast<char>(_getch());
+        userChoice = readConsoleCharacter();
         std::cout << userChoice << std::endl;
         
         switch (userChoice) {
@@ -147,130 +177,156 @@ void WiperSystemManager::selectManualWiperSpeed() {
                 wiperController.setWiperSpeed(WindshieldWiperSpeed::OFF);
                 wiperController.setWaterSprayMode(WaterSprayMode::OFF);
                 logSystemEvent("Manual: Wiper set to OFF");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+                recordSettingChange(SystemEventId::SPRAY_MODE_SET);
                 return;
             case '1':
                 wiperController.setWiperSpeed(WindshieldWiperSpeed::LOW);
                 wiperController.setWaterSprayMode(WaterSprayMode::OFF);
                 logSystemEvent("Manual: Wiper set to LOW");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+                recordSettingChange(SystemEventId::SPRAY_MODE_SET);
                 return;
             case '2':
                 wiperController.setWiperSpeed(WindshieldWiperSpeed::MEDIUM);
                 wiperController.setWaterSprayMode(WaterSprayMode::OFF);
                 logSystemEvent("Manual: Wiper set to MEDIUM");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+                recordSettingChange(SystemEventId::SPRAY_MODE_SET);
                 return;
             case '3':
                 wiperController.setWiperSpeed(WindshieldWiperSpeed::HIGH);
                 wiperController.setWaterSprayMode(WaterSprayMode::OFF);
                 logSystemEvent("Manual: Wiper set to HIGH");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+                recordSettingChange(SystemEventId::SPRAY_MODE_SET);
                 return;
             default:
                 std::cout << "Invalid choice. Please enter 0, 1, 2, or 3." << std::endl;
-                Sleep(1000);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
         }
     }
 }
 
 bool WiperSystemManager::processUserInput() {
-    if (_kbhit()) {
-        char userInput = static_cast<char>(_getch());
-        
-        switch (userInput) {
-            case 'm':
-            case 'M':
-                wiperController.setOperatingMode(OperatingMode::MANUAL);
-                logSystemEvent("Switched to MANUAL mode");
+    if (isConsoleInputAvailable()) {
+        return handleUserCommand(readConsoleCharacter());
+    }
+    return false;
+}
+
+bool WiperSystemManager::handleUserCommand(char userInput) {
+    switch (userInput) {
+        case 'm':
+        case 'M':
+            wiperController.setOperatingMode(OperatingMode::MANUAL);
+            logSystemEvent("Switched to MANUAL mode");
+            recordSettingChange(SystemEventId::OPERATING_MODE_CHANGED);
+            if (headlessOutputDescriptor < 0) {
                 std::cout << std::endl;
                 selectManualWiperSpeed();
-                return true;
-                
-            case 'a':
-            case 'A':
-                wiperController.setOperatingMode(OperatingMode::AUTOMATIC);
-                wiperController.setWaterSprayMode(WaterSprayMode::OFF); // Clear any spray when switching to auto
-                rainDetectionSensor.resetSensorFailureState();
-                logSystemEvent("Switched to AUTO mode (spray cleared)");
-                return true;
-                
-            case 'q':
-            case 'Q':
-                isSystemRunning = false;
-                return true;
-                
-            case '0':
-                if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-                    wiperController.setWiperSpeed(WindshieldWiperSpeed::OFF);
-                    wiperController.setWaterSprayMode(WaterSprayMode::OFF); // Turn off spray when wipers are OFF
-                    logSystemEvent("Manual: Wiper set to OFF (spray cleared)");
-                }
-                return true;
-                
-            case '1':
-                if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-                    wiperController.setWiperSpeed(WindshieldWiperSpeed::LOW);
-                    // Keep current spray mode - don't change it
-                    logSystemEvent("Manual: Wiper set to LOW (spray preserved)");
-                }
-                return true;
-                
-            case '2':
-                if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-                    wiperController.setWiperSpeed(WindshieldWiperSpeed::MEDIUM);
-                    // Keep current spray mode - don't change it
-                    logSystemEvent("Manual: Wiper set to MEDIUM (spray preserved)");
-                }
-                return true;
-                
-            case '3':
-                if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-                    wiperController.setWiperSpeed(WindshieldWiperSpeed::HIGH);
-                    // Keep current spray mode - don't change it
-                    logSystemEvent("Manual: Wiper set to HIGH (spray preserved)");
-                }
-                return true;
-                
-                            
-            // Spray-only controls (work in manual mode only)
-            case 's':
-                if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-                    // Toggle light spray without changing wiper speed
-                    if (wiperController.getCurrentWaterSprayMode() == WaterSprayMode::LIGHT_SPRAY) {
-                        wiperController.setWaterSprayMode(WaterSprayMode::OFF);
-                        logSystemEvent("Light spray turned OFF (wipers continue)");
-                    } else {
-                        wiperController.setWaterSprayMode(WaterSprayMode::LIGHT_SPRAY);
-                        logSystemEvent("Light spray activated (wipers continue)");
-                    }
-                }
-                return true;
-                
-            case 'S':
-                if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-                    // Toggle heavy spray without changing wiper speed
-                    if (wiperController.getCurrentWaterSprayMode() == WaterSprayMode::HEAVY_SPRAY) {
-                        wiperController.setWaterSprayMode(WaterSprayMode::OFF);
-                        logSystemEvent("Heavy spray turned OFF (wipers continue)");
-                    } else {
-                        wiperController.setWaterSprayMode(WaterSprayMode::HEAVY_SPRAY);
-                        logSystemEvent("Heavy spray activated (wipers continue)");
-                    }
+            }
+            return true;
+            
+        case 'a':
+        case 'A':
+            wiperController.setOperatingMode(OperatingMode::AUTOMATIC);
+            wiperController.setWaterSprayMode(WaterSprayMode::OFF); // Clear any spray when switching to auto
+            rainDetectionSensor.resetSensorFailureState();
+            logSystemEvent("Switched to AUTO mode (spray cleared)");
+            recordSettingChange(SystemEventId::OPERATING_MODE_CHANGED);
+            recordSettingChange(SystemEventId::SPRAY_MODE_SET);
+            return true;
+            
+        case 'q':
+        case 'Q':
+            isSystemRunning = false;
+            return true;
+            
+        case '0':
+            if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
+                wiperController.setWiperSpeed(WindshieldWiperSpeed::OFF);
+                wiperController.setWaterSprayMode(WaterSprayMode::OFF); // Turn off spray when wipers are OFF
+                logSystemEvent("Manual: Wiper set to OFF (spray cleared)");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+                recordSettingChange(SystemEventId::SPRAY_MODE_SET);
+            }
+            return true;
+            
+        case '1':
+            if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
+                wiperController.setWiperSpeed(WindshieldWiperSpeed::LOW);
+                // Keep current spray mode - don't change it
+                logSystemEvent("Manual: Wiper set to LOW (spray preserved)");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+            }
+            return true;
+            
+        case '2':
+            if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
+                wiperController.setWiperSpeed(WindshieldWiperSpeed::MEDIUM);
+                // Keep current spray mode - don't change it
+                logSystemEvent("Manual: Wiper set to MEDIUM (spray preserved)");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+            }
+            return true;
+            
+        case '3':
+            if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
+                wiperController.setWiperSpeed(WindshieldWiperSpeed::HIGH);
+                // Keep current spray mode - don't change it
+                logSystemEvent("Manual: Wiper set to HIGH (spray preserved)");
+                recordSettingChange(SystemEventId::WIPER_SPEED_SET);
+            }
+            return true;
+            
+                        
+        // Spray-only controls (work in manual mode only)
+        case 's':
+            if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
+                // Toggle light spray without changing wiper speed
+                if (wiperController.getCurrentWaterSprayMode() == WaterSprayMode::LIGHT_SPRAY) {
+                    wiperController.setWaterSprayMode(WaterSprayMode::OFF);
+                    logSystemEvent("Light spray turned OFF (wipers continue)");
+                    recordSettingChange(SystemEventId::SPRAY_MODE_SET);
+                } else {
+                    wiperController.setWaterSprayMode(WaterSprayMode::LIGHT_SPRAY);
+                    logSystemEvent("Light spray activated (wipers continue)");
+                    recordSettingChange(SystemEventId::SPRAY_MODE_SET);
                 }
-                return true;
-                
-            case 'x':
-            case 'X':
-                if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
-                    // Turn off spray only, keep wipers running
+            }
+            return true;
+            
+        case 'S':
+            if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
+                // Toggle heavy spray without changing wiper speed
+                if (wiperController.getCurrentWaterSprayMode() == WaterSprayMode::HEAVY_SPRAY) {
                     wiperController.setWaterSprayMode(WaterSprayMode::OFF);
-                    logSystemEvent("Water spray turned OFF (wipers continue)");
+                    logSystemEvent("Heavy spray turned OFF (wipers continue)");
+                    recordSettingChange(SystemEventId::SPRAY_MODE_SET);
+                } else {
+                    wiperController.setWaterSprayMode(WaterSprayMode::HEAVY_SPRAY);
+                    logSystemEvent("Heavy spray activated (wipers continue)");
+                    recordSettingChange(SystemEventId::SPRAY_MODE_SET);
                 }
-                return true;
-        }
+            }
+            return true;
+            
+        case 'x':
+        case 'X':
+            if (wiperController.getCurrentOperatingMode() == OperatingMode::MANUAL) {
+                // Turn off spray only, keep wipers running
+                wiperController.setWaterSprayMode(WaterSprayMode::OFF);
+                logSystemEvent("Water spray turned OFF (wipers continue)");
+                recordSettingChange(SystemEventId::SPRAY_MODE_SET);
+            }
+            return true;
     }
     return false;
 }
 
 void WiperSystemManager::initializeSystem() {
-    system("cls");
+    clearConsoleScreen();
     
     // Select initial operating mode
     OperatingMode initialOperatingMode = selectInitialOperatingMode();
@@ -280,7 +336,7 @@ void WiperSystemManager::initializeSystem() {
         selectManualWiperSpeed();
     }
     
-    system("cls");
+    clearConsoleScreen();
     printColoredText("Starting Rain-Sensing Wiper System...\n", COLOR_GREEN);
     std::cout << "Selected mode: ";
     std::string operatingModeColor = (initialOperatingMode == OperatingMode::AUTOMATIC) ? COLOR_GREEN : COLOR_BLUE;
@@ -294,11 +350,74 @@ void WiperSystemManager::initializeSystem() {
     std::cout << std::string(50, '-') << std::endl;
 }
 
-void WiperSystemManager::runSystem() {
-    initializeSystem();
+void WiperSystemManager::runControlTick(SimulationClock::TimePoint currentTime) {
+    WIPER_TRACE_SCOPE("WiperSystemManager::runControlTick");
+    auto tickStartTime = std::chrono::steady_clock::now();
+    systemMetrics.controlTicks.increment();
+    lastControlTickTime = currentTime;
+    
+    if (wiperController.getCurrentOperatingMode() == OperatingMode::AUTOMATIC) {
+        // Automatic mode - read sensor (or the replayed trace) and process data on every control tick
+        if (!sensorTraceReplayer.isOpen()) {
+            latestSensorData = rainDetectionSensor.readSensorData();
+        } else if (!sensorTraceReplayer.readNextReading(latestSensorData, wiperController, currentTime)) {
+            logSystemEvent("Sensor trace replay finished");
+            isSystemRunning = false;
+            return;
+        }
+        TurnOffCountdownEvent countdownEvent = wiperController.processAutomaticModeOperation(latestSensorData, currentTime);
+        sensorTraceRecorder.recordReading(currentTime, latestSensorData, wiperController);
+        
+        // A burst between two status lines must still be reported
+        hasBurstInStatusWindow = hasBurstInStatusWindow || latestSensorData.isSuddenRainBurst;
+        
+        if (!latestSensorData.isValidReading) {
+            systemMetrics.sensorFailures.increment();
+        } else if (latestSensorData.isSuddenRainBurst) {
+            systemMetrics.rainBursts.increment();
+        }
+        systemMetrics.recordTurnOffCountdownEvent(countdownEvent);
+        systemMetrics.recordWiperSpeed(wiperController.getCurrentWiperSpeed(), currentTime);
+        
+        // Raw values only - the offline decoder formats them
+        eventLogger.logEvent(SystemEventId::AUTOMATIC_MODE_TICK, 5,
+                             static_cast<std::int32_t>(latestSensorData.lightPercentage * 100.0),
+                             latestSensorData.isValidReading ? 1 : 0,
+                             latestSensorData.isSuddenRainBurst ? 1 : 0,
+                             static_cast<std::int32_t>(wiperController.getCurrentWiperSpeed()),
+                             wiperController.getRemainingTurnOffSeconds(currentTime));
+    }
+    
+    controlTicksSinceStatus++;
+    if (controlTicksSinceStatus >= statusDecimation) {
+        if (wiperController.getCurrentOperatingMode() == OperatingMode::AUTOMATIC) {
+            displayAutomaticModeStatus(currentTime);
+        } else {
+            displayManualModeStatus();
+            eventLogger.logEvent(SystemEventId::MANUAL_MODE_TICK, 2,
+                                 static_cast<std::int32_t>(wiperController.getCurrentWiperSpeed()),
+                                 static_cast<std::int32_t>(wiperController.getCurrentWaterSprayMode()));
+        }
+        controlTicksSinceStatus = 0;
+        hasBurstInStatusWindow = false;
+    }
     
-    auto lastStatusUpdateTime = std::chrono::steady_clock::now();
-    const auto statusUpdateInterval = std::chrono::milliseconds(1000); // 1 second for status updates
+    auto tickDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tickStartTime);
+    systemMetrics.controlTickLatency.recordValue(static_cast<std::uint64_t>(tickDuration.count()));
+}
+
+void WiperSystemManager::displayAutomaticModeStatus(SimulationClock::TimePoint currentTime) {
+    statusLineRenderer.renderAutomaticModeStatusLine(latestSensorData, hasBurstInStatusWindow, wiperController, currentTime);
+    emitConsoleLine();
+}
+
+void WiperSystemManager::displayManualModeStatus() {
+    statusLineRenderer.renderManualModeStatusLine(wiperController);
+    emitConsoleLine();
+}
+
+void WiperSystemManager::runPollingLoop() {
+    const auto maximumInputDelay = std::chrono::milliseconds(50);
     
     while (isSystemRunning) {
         // Check for user input frequently (every 50ms)
@@ -306,74 +425,67 @@ void WiperSystemManager::runSystem() {
         
         if (!isSystemRunning) break;
         
-        auto currentTime = std::chrono::steady_clock::now();
+        // Sample the clock once per pass and share it with the controller
+        auto currentTime = systemClock.now();
         
-        // Only update status every second, but check input more frequently
-        if (currentTime - lastStatusUpdateTime >= statusUpdateInterval) {
-            if (wiperController.getCurrentOperatingMode() == OperatingMode::AUTOMATIC) {
-                // Automatic mode - read sensor and process data
-                auto currentSensorData = rainDetectionSensor.readSensorData();
-                
-                if (!currentSensorData.isValidReading) {
-                    wiperController.processAutomaticModeOperation(currentSensorData);
-                    // Auto mode simple display - no dew info
-                    printColoredText("[" + getCurrentTimeString() + "] ", COLOR_CYAN);
-                    printColoredText("Mode: AUTO", COLOR_GREEN);
-                    std::cout << " | Sensor: ";
-                    printColoredText("ERROR", COLOR_RED);
-                    std::cout << " | Wiper: ";
-                    std::string wiperSpeedColor = (wiperController.getCurrentWiperSpeed() == WindshieldWiperSpeed::HIGH) ? COLOR_RED : 
-                                                 (wiperController.getCurrentWiperSpeed() == WindshieldWiperSpeed::MEDIUM) ? COLOR_YELLOW :
-                                                 (wiperController.getCurrentWiperSpeed() == WindshieldWiperSpeed::LOW) ? COLOR_GREEN : COLOR_GRAY;
-                    printColoredText(convertWiperSpeedToString(wiperController.getCurrentWiperSpeed()), wiperSpeedColor);
-                    printColoredText(" (Sensor Failure - Switch to Manual)", COLOR_RED);
-                    std::cout << std::endl;
-                } else {
-                    wiperController.processAutomaticModeOperation(currentSensorData);
-                    // Auto mode simple display - only rain info, no dew
-                    printColoredText("[" + getCurrentTimeString() + "] ", COLOR_CYAN);
-                    printColoredText("Mode: AUTO", COLOR_GREEN);
-                    std::cout << " | Sensor: ";
-                    printColoredText(std::to_string(static_cast<int>(currentSensorData.lightPercentage)) + "%", COLOR_WHITE);
-                    std::cout << " | Wiper: ";
-                    std::string wiperSpeedColor = (wiperController.getCurrentWiperSpeed() == WindshieldWiperSpeed::HIGH) ? COLOR_RED : 
-                                                 (wiperController.getCurrentWiperSpeed() == WindshieldWiperSpeed::MEDIUM) ? COLOR_YELLOW :
-                                                 (wiperController.getCurrentWiperSpeed() == WindshieldWiperSpeed::LOW) ? COLOR_GREEN : COLOR_GRAY;
-                    printColoredText(convertWiperSpeedToString(wiperController.getCurrentWiperSpeed()), wiperSpeedColor);
-                    
-                    // Only show sudden rain burst, no dew info
-                    if (currentSensorData.isSuddenRainBurst) {
-                        printColoredText(" (Sudden Rain Burst)", COLOR_RED);
-                    }
-                    
-                    // Show countdown if waiting to turn off wipers
-                    if (wiperController.isWaitingToTurnOffWipers()) {
-                        int remainingSeconds = wiperController.getRemainingTurnOffSeconds();
-                        printColoredText(" (Turning OFF in " + std::to_string(remainingSeconds) + "s)", COLOR_YELLOW);
-                    }
-                    
-                    std::cout << std::endl;
-                }
-            } else {
-                // Manual mode - display current status without sensor data
-                std::string operatingModeString = "MANUAL";
-                std::string wiperSpeedString = convertWiperSpeedToString(wiperController.getCurrentWiperSpeed());
-                std::string statusMessage = "Mode: " + operatingModeString + " | Wiper: " + wiperSpeedString;
-                
-                // Add spray information if active
-                if (wiperController.getCurrentWaterSprayMode() != WaterSprayMode::OFF) {
-                    statusMessage += " | Spray: " + convertSprayModeToString(wiperController.getCurrentWaterSprayMode());
-                }
-                
-                logSystemEvent(statusMessage);
-            }
-            
-            lastStatusUpdateTime = currentTime;
+        // Run a control tick once its absolute deadline has passed, so the cadence never drifts
+        if (currentTime >= controlScheduler.getNextDeadline()) {
+            controlScheduler.recordTickStart(currentTime);
+            runControlTick(currentTime);
         }
         
-        // Short sleep to prevent excessive CPU usage while maintaining responsiveness
-        Sleep(50); // Check input every 50ms
+        if (!isSystemRunning) break;
+        
+        // Sleep until the next deadline, but keep checking input every 50ms
+        auto wakeTime = std::min(systemClock.now() + maximumInputDelay, controlScheduler.getNextDeadline());
+        std::this_thread::sleep_until(wakeTime);
+    }
+}
+
+void WiperSystemManager::runEventDrivenLoop(ConsoleEventLoop& eventLoop) {
+    // Wake only for keystrokes or the control timer, armed on the scheduler's absolute deadlines
+    eventLoop.setPeriodicTimer(controlScheduler.getNextDeadline(), controlScheduler.getTickPeriod());
+    eventLoop.run(
+        [this, &eventLoop](char userInput) {
+            handleUserCommand(userInput);
+            if (!isSystemRunning) {
+                eventLoop.stop();
+            }
+        },
+        [this, &eventLoop](std::uint64_t) {
+            auto currentTime = systemClock.now();
+            controlScheduler.recordTickStart(currentTime);
+            runControlTick(currentTime);
+            if (!isSystemRunning) {
+                eventLoop.stop();
+            }
+        });
+}
+
+void WiperSystemManager::runSystem() {
+    ConsoleRawModeGuard rawModeGuard;
+    initializeSystem();
+    
+    if (timingConfiguration.realtimeCpuIndex >= 0 &&
+        !PeriodicScheduler::enableRealtimeScheduling(timingConfiguration.realtimeCpuIndex, 50)) {
+        printColoredText("Realtime scheduling unavailable - continuing with default scheduling\n", COLOR_YELLOW);
+    }
+    
+    eventLogger.logEvent(SystemEventId::SYSTEM_STARTED, 1, static_cast<std::int32_t>(wiperController.getCurrentOperatingMode()));
+    systemMetrics.recordWiperSpeed(wiperController.getCurrentWiperSpeed(), systemClock.now());
+    controlScheduler.start();
+    ConsoleEventLoop eventLoop;
+    if (eventLoop.isSupported()) {
+        runEventDrivenLoop(eventLoop);
+    } else {
+        runPollingLoop();
     }
     
     printColoredText("\nShutting down Rain-Sensing Wiper System...\n", COLOR_RED);
+    eventLogger.logEvent(SystemEventId::SYSTEM_SHUTDOWN);
+    eventLogger.close();
+    sensorTraceRecorder.close();
+    if (timingConfiguration.isLatenessReportEnabled) {
+        controlScheduler.printLatenessReport(std::cout);
+    }
 }
\ No newline at end of file
@@ -5,6 +5,15 @@
 #include "WindshieldWiperController.h"
 #include "ColorUtilities.h"
 #include "WiperEnums.h"
+#include "SimulationClock.h"
+#include "ConsoleEventLoop.h"
+#include "PeriodicScheduler.h"
+#include "EventLogger.h"
+#include "SensorTraceRecorder.h"
+#include "SensorTraceReplayer.h"
+#include "MetricsRegistry.h"
+#include "MetricsHttpEndpoint.h"
+#include "StatusLineRenderer.h"
 #include <string>
 #include <chrono>
 
@@ -12,16 +21,43 @@
  * @brief WiperSystemManager class to manage the overall wiper system operation
  */
 class WiperSystemManager {
+public:
+    /**
+     * @brief Structure to hold control loop timing options
+     */
+    struct SystemTimingConfiguration {
+        unsigned int controlRateHz;   // Sensor sampling and control ticks per second (1 - 1000)
+        unsigned int statusRateHz;    // Console status lines per second (at most controlRateHz)
+        int realtimeCpuIndex;         // CPU to pin to with SCHED_FIFO, or -1 to stay unpinned
+        bool isLatenessReportEnabled; // Print the tick lateness histogram on shutdown
+    };
+
 private:
     RainSensor rainDetectionSensor;
     WindshieldWiperController wiperController;
+    SimulationClock systemClock;
+    PeriodicScheduler controlScheduler;
+    SystemTimingConfiguration timingConfiguration;
     bool isSystemRunning;
+    EventLogger eventLogger;
+    SensorTraceRecorder sensorTraceRecorder;
+    SensorTraceReplayer sensorTraceReplayer;
+    MetricsRegistry systemMetrics;
+    MetricsHttpEndpoint metricsEndpoint; // Declared after systemMetrics so it stops first
+    
+    // Status window aggregated between two console status lines
+    RainSensor::SensorReadingData latestSensorData;
+    bool hasBurstInStatusWindow;
+    unsigned int controlTicksSinceStatus;
+    unsigned int statusDecimation;
+    StatusLineRenderer statusLineRenderer; // Formats each console line and emits it with one write
+    int headlessOutputDescriptor;          // Console lines go here instead of stdout, or -1 for the console
+    SimulationClock::TimePoint lastControlTickTime; // Timeline position that trace resync records are stamped with
 
     /**
-     * @brief Get current time as formatted string
-     * @return Current time in HH:MM:SS format
+     * @brief Emit the line last formatted by statusLineRenderer on the console (or headless output)
      */
-    std::string getCurrentTimeString();
+    void emitConsoleLine();
 
     /**
      * @brief Log system event with timestamp
@@ -29,6 +65,12 @@ private:
      */
     void logSystemEvent(const std::string& eventMessage);
 
+    /**
+     * @brief Record a controller setting change in the binary event log
+     * @param eventId Which setting changed (operating mode, wiper speed or spray mode)
+     */
+    void recordSettingChange(SystemEventId eventId);
+
     /**
      * @brief Display current system status
      * @param sensorData Current sensor data
@@ -58,12 +100,127 @@ private:
      */
     bool processUserInput();
 
+    /**
+     * @brief Print one auto mode status line for the current status window
+     * @param currentTime Time of this status update
+     */
+    void displayAutomaticModeStatus(SimulationClock::TimePoint currentTime);
+
+    /**
+     * @brief Print one manual mode status line
+     */
+    void displayManualModeStatus();
+
+    /**
+     * @brief Main loop that polls for input at least every 50 ms (platforms without a reactor)
+     */
+    void runPollingLoop();
+
+    /**
+     * @brief Main loop that sleeps until input or the control timer wakes it
+     * @param eventLoop Reactor to run on
+     */
+    void runEventDrivenLoop(ConsoleEventLoop& eventLoop);
+
 public:
     /**
      * @brief Constructor for WiperSystemManager
      */
     WiperSystemManager();
 
+    /**
+     * @brief Configure control loop timing (call before runSystem)
+     * @param newTimingConfiguration Rate, realtime and reporting options
+     */
+    void configureTiming(const SystemTimingConfiguration& newTimingConfiguration);
+
+    /**
+     * @brief Record events to a binary log as well as the console (call before runSystem)
+     * @param logFilePath Path of the binary event log to create
+     * @return True if the log file could be created
+     */
+    bool enableEventLog(const std::string& logFilePath);
+
+    /**
+     * @brief Record every sensor reading and resulting controller state (call before runSystem)
+     * @param traceFilePath Path of the binary sensor trace to create
+     * @return True if the trace file could be created
+     */
+    bool enableSensorTrace(const std::string& traceFilePath);
+
+    /**
+     * @brief Take automatic-mode readings from a recorded trace instead of the simulated sensor
+     * @param traceFilePath Path of a trace written with enableSensorTrace()
+     * @return True if the trace could be opened
+     *
+     * The system shuts down once the trace is exhausted.
+     */
+    bool enableSensorReplay(const std::string& traceFilePath);
+
+    /**
+     * @brief Make the simulated sensor reproducible (call before runSystem)
+     * @param seed Seed for the counter-based sensor generator
+     */
+    void setSensorSeed(std::uint64_t seed);
+
+    /**
+     * @brief Copy the control loop metrics (safe to call from any thread while runSystem runs)
+     * @return Counters, dwell times and tick latency histogram so far
+     */
+    MetricsSnapshot takeMetricsSnapshot() const;
+
+    /**
+     * @brief Serve the metrics in Prometheus text format on http://127.0.0.1:PORT/metrics
+     * @param listenPort TCP port on the loopback interface, or 0 for any free port
+     * @return True if the listener could be started
+     *
+     * Scrapes are answered on the endpoint's own thread from metric snapshots and never
+     * block the control loop.
+     */
+    bool enableMetricsEndpoint(unsigned short listenPort);
+
+    /**
+     * @brief Get the port the metrics endpoint listens on
+     * @return Bound port, or 0 if the endpoint is not running
+     */
+    unsigned short getMetricsEndpointPort() const;
+
+    /**
+     * @brief Run without a terminal: console lines go to a descriptor and commands never prompt
+     * @param outputFileDescriptor Descriptor that receives every console line
+     *
+     * Used by tests and tools that drive handleUserCommand() and runControlTick() directly.
+     * Switching to manual mode keeps the current wiper speed instead of asking for one.
+     */
+    void enableHeadlessConsole(int outputFileDescriptor);
+
+    /**
+     * @brief Apply a single keystroke command
+     * @param userInput The key that was pressed
+     * @return True if the key was a known command, false otherwise
+     */
+    bool handleUserCommand(char userInput);
+
+    /**
+     * @brief Run one control tick: sample and actuate (auto mode), print status when due
+     * @param currentTime Time of this control tick
+     *
+     * Called by the main loops on each deadline; headless callers may drive it directly.
+     */
+    void runControlTick(SimulationClock::TimePoint currentTime);
+
+    /**
+     * @brief Get the controller the system drives
+     * @return Controller state after the last tick or command
+     */
+    const WindshieldWiperController& getWiperController() const;
+
+    /**
+     * @brief Check if the system is still running (false after 'q' or the end of a replay)
+     * @return True while running
+     */
+    bool isRunning() const;
+
     /**
      * @brief Initialize the wiper system
      */
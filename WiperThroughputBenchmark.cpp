@@ -0,0 +1,349 @@
+#include "LatencyTracer.h"
+#include "RainSensor.h"
+#include "StatusDisplay.h"
+#include "StatusLineRenderer.h"
+#include "WindshieldWiperController.h"
+#include "WorkStealingThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Structure to hold the measurements of one vehicle/thread count configuration
+ */
+struct ThroughputResult {
+    std::size_t vehicleCount;
+    unsigned int threadCount;
+    std::uint64_t tickCount;
+    double ticksPerSecond;
+    double vehicleTicksPerSecond;
+    double p50TickMicroseconds;
+    double p99TickMicroseconds;
+    double p999TickMicroseconds;
+    std::uint64_t residentSetBytes;
+};
+
+/**
+ * @brief Structure to hold the headless control loops of a group of vehicles
+ */
+struct VehicleShard {
+    std::vector<RainSensor> vehicleSensors;
+    std::vector<WindshieldWiperController> wiperControllers;
+    std::vector<std::uint8_t> burstInStatusWindowFlags;
+    StatusLineRenderer statusLineRenderer; // One per shard, since a renderer is single-threaded
+    DiscardingStreamBuffer discardingBuffer;
+    std::ostream statusStream;
+
+    VehicleShard() : statusStream(&discardingBuffer) {}
+};
+
+const std::size_t VEHICLES_PER_SHARD = 256;
+const std::uint64_t WARMUP_TICK_COUNT = 5;
+
+/**
+ * @brief Get the resident set size of this process
+ * @return Resident bytes (peak resident bytes where the current figure is unavailable, 0 on Windows)
+ */
+static std::uint64_t getResidentSetBytes() {
+    #ifdef _WIN32
+    return 0;
+    #else
+    std::FILE* statmFile = std::fopen("/proc/self/statm", "r");
+    if (statmFile != nullptr) {
+        unsigned long totalPages = 0;
+        unsigned long residentPages = 0;
+        int parsedCount = std::fscanf(statmFile, "%lu %lu", &totalPages, &residentPages);
+        std::fclose(statmFile);
+        if (parsedCount == 2) {
+            return static_cast<std::uint64_t>(residentPages) * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+        }
+    }
+    struct rusage resourceUsage;
+    getrusage(RUSAGE_SELF, &resourceUsage);
+    #ifdef __APPLE__
+    return static_cast<std::uint64_t>(resourceUsage.ru_maxrss);
+    #else
+    return static_cast<std::uint64_t>(resourceUsage.ru_maxrss) * 1024;
+    #endif
+    #endif
+}
+
+/**
+ * @brief Pick a percentile from sorted samples (nearest rank)
+ * @param sortedSamples Samples in ascending order
+ * @param percentile Percentile in (0, 100]
+ * @return The sample at that rank
+ */
+static std::uint64_t getPercentile(const std::vector<std::uint64_t>& sortedSamples, double percentile) {
+    std::size_t sampleRank = static_cast<std::size_t>(percentile / 100.0 * sortedSamples.size() + 0.999999);
+    sampleRank = std::max<std::size_t>(1, std::min(sampleRank, sortedSamples.size()));
+    return sortedSamples[sampleRank - 1];
+}
+
+/**
+ * @brief Run the sense, decide and report loop for a fleet of vehicles and time every tick
+ * @param vehicleCount Number of vehicles, each with its own sensor and controller
+ * @param threadCount Threads stepping the vehicles (1 = serial)
+ * @param tickCount Measured ticks
+ * @param tickIntervalMilliseconds Virtual time between ticks
+ * @param statusDecimation Control ticks per status line, as runSystem decimates to --status-hz
+ * @param randomSeed Sensor seed (vehicle index is the stream ID)
+ * @return Throughput, tick latency percentiles and resident memory
+ */
+static ThroughputResult measureThroughput(std::size_t vehicleCount, unsigned int threadCount, std::uint64_t tickCount,
+                                          unsigned int tickIntervalMilliseconds, unsigned int statusDecimation,
+                                          std::uint64_t randomSeed) {
+    // Each shard reports into its own stream, so threads never share output state
+    std::size_t shardCount = (vehicleCount + VEHICLES_PER_SHARD - 1) / VEHICLES_PER_SHARD;
+    std::vector<std::unique_ptr<VehicleShard>> vehicleShards;
+    for (std::size_t shardIndex = 0; shardIndex < shardCount; shardIndex++) {
+        std::size_t firstVehicleIndex = shardIndex * VEHICLES_PER_SHARD;
+        std::size_t shardVehicleCount = std::min(VEHICLES_PER_SHARD, vehicleCount - firstVehicleIndex);
+        vehicleShards.push_back(std::unique_ptr<VehicleShard>(new VehicleShard()));
+        VehicleShard& vehicleShard = *vehicleShards.back();
+        vehicleShard.vehicleSensors.reserve(shardVehicleCount);
+        for (std::size_t vehicleIndex = 0; vehicleIndex < shardVehicleCount; vehicleIndex++) {
+            vehicleShard.vehicleSensors.emplace_back(randomSeed, static_cast<std::uint64_t>(firstVehicleIndex + vehicleIndex));
+            vehicleShard.vehicleSensors.back().subscribeChannels(RainSensor::CHANNEL_LIGHT | RainSensor::CHANNEL_BURST | RainSensor::CHANNEL_FAILURE);
+        }
+        vehicleShard.wiperControllers.resize(shardVehicleCount);
+        vehicleShard.burstInStatusWindowFlags.assign(shardVehicleCount, 0);
+    }
+
+    std::unique_ptr<WorkStealingThreadPool> workerThreadPool;
+    if (threadCount > 1) {
+        workerThreadPool.reset(new WorkStealingThreadPool(threadCount));
+    }
+
+    const std::chrono::steady_clock::time_point startTime;
+    std::uint64_t currentTick = 0;
+    // Same per-tick work as WiperSystemManager::runControlTick in auto mode
+    auto stepShard = [&vehicleShards, &currentTick, startTime, tickIntervalMilliseconds, statusDecimation](std::size_t shardIndex) {
+        WIPER_TRACE_SCOPE("stepShard");
+        VehicleShard& vehicleShard = *vehicleShards[shardIndex];
+        std::chrono::steady_clock::time_point currentTime = startTime + std::chrono::milliseconds(currentTick * tickIntervalMilliseconds);
+        bool isStatusDue = ((currentTick + 1) % statusDecimation) == 0;
+        for (std::size_t vehicleIndex = 0; vehicleIndex < vehicleShard.vehicleSensors.size(); vehicleIndex++) {
+            RainSensor::SensorReadingData sensorData = vehicleShard.vehicleSensors[vehicleIndex].readSensorData();
+            WindshieldWiperController& wiperController = vehicleShard.wiperControllers[vehicleIndex];
+            wiperController.processAutomaticModeOperation(sensorData, currentTime);
+            vehicleShard.burstInStatusWindowFlags[vehicleIndex] |= sensorData.isSuddenRainBurst ? 1 : 0;
+            if (isStatusDue) {
+                vehicleShard.statusLineRenderer.renderAutomaticModeStatusLine(sensorData,
+                    vehicleShard.burstInStatusWindowFlags[vehicleIndex] != 0, wiperController, currentTime);
+                vehicleShard.statusLineRenderer.writeToStream(vehicleShard.statusStream);
+                vehicleShard.burstInStatusWindowFlags[vehicleIndex] = 0;
+            }
+        }
+    };
+    auto stepTick = [&vehicleShards, &workerThreadPool, &stepShard]() {
+        if (workerThreadPool) {
+            workerThreadPool->parallelFor(vehicleShards.size(), stepShard);
+        } else {
+            for (std::size_t shardIndex = 0; shardIndex < vehicleShards.size(); shardIndex++) {
+                stepShard(shardIndex);
+            }
+        }
+    };
+
+    for (; currentTick < WARMUP_TICK_COUNT; currentTick++) {
+        stepTick();
+    }
+
+    std::vector<std::uint64_t> tickNanoseconds;
+    tickNanoseconds.reserve(tickCount);
+    auto runStartTime = std::chrono::steady_clock::now();
+    for (std::uint64_t tickIndex = 0; tickIndex < tickCount; tickIndex++, currentTick++) {
+        auto tickStartTime = std::chrono::steady_clock::now();
+        stepTick();
+        auto tickEndTime = std::chrono::steady_clock::now();
+        tickNanoseconds.push_back(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(tickEndTime - tickStartTime).count()));
+    }
+    double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStartTime).count();
+    elapsedSeconds = (elapsedSeconds > 0.0) ? elapsedSeconds : 1e-9;
+
+    std::sort(tickNanoseconds.begin(), tickNanoseconds.end());
+    ThroughputResult throughputResult;
+    throughputResult.vehicleCount = vehicleCount;
+    throughputResult.threadCount = workerThreadPool ? workerThreadPool->getThreadCount() : 1;
+    throughputResult.tickCount = tickCount;
+    throughputResult.ticksPerSecond = tickCount / elapsedSeconds;
+    throughputResult.vehicleTicksPerSecond = throughputResult.ticksPerSecond * vehicleCount;
+    throughputResult.p50TickMicroseconds = getPercentile(tickNanoseconds, 50.0) / 1000.0;
+    throughputResult.p99TickMicroseconds = getPercentile(tickNanoseconds, 99.0) / 1000.0;
+    throughputResult.p999TickMicroseconds = getPercentile(tickNanoseconds, 99.9) / 1000.0;
+    throughputResult.residentSetBytes = getResidentSetBytes();
+    return throughputResult;
+}
+
+/**
+ * @brief Parse a comma-separated list of counts
+ * @param listText Text such as "1,1000,100000"
+ * @return Parsed counts (zeros are skipped)
+ */
+static std::vector<std::size_t> parseCountList(const char* listText) {
+    std::vector<std::size_t> parsedCounts;
+    const char* cursor = listText;
+    while (*cursor != '\0') {
+        char* parseEnd = nullptr;
+        unsigned long long parsedCount = std::strtoull(cursor, &parseEnd, 10);
+        if (parseEnd == cursor) {
+            break;
+        }
+        if (parsedCount > 0) {
+            parsedCounts.push_back(static_cast<std::size_t>(parsedCount));
+        }
+        cursor = (*parseEnd == ',') ? parseEnd + 1 : parseEnd;
+    }
+    return parsedCounts;
+}
+
+/**
+ * @brief Write the scaling curve as JSON for comparison across releases and hardware
+ * @param outputStream Stream to write to
+ * @param throughputResults Results to write
+ */
+static void writeJsonResults(std::ostream& outputStream, const std::vector<ThroughputResult>& throughputResults) {
+    outputStream << "{\n  \"context\": {\"hardware_threads\": " << std::thread::hardware_concurrency() << "},\n  \"runs\": [\n";
+    for (std::size_t resultIndex = 0; resultIndex < throughputResults.size(); resultIndex++) {
+        const ThroughputResult& throughputResult = throughputResults[resultIndex];
+        outputStream << "    {\"vehicles\": " << throughputResult.vehicleCount
+                     << ", \"threads\": " << throughputResult.threadCount
+                     << ", \"ticks\": " << throughputResult.tickCount
+                     << std::fixed << std::setprecision(3)
+                     << ", \"ticks_per_second\": " << throughputResult.ticksPerSecond
+                     << ", \"vehicle_ticks_per_second\": " << throughputResult.vehicleTicksPerSecond
+                     << ", \"p50_tick_us\": " << throughputResult.p50TickMicroseconds
+                     << ", \"p99_tick_us\": " << throughputResult.p99TickMicroseconds
+                     << ", \"p999_tick_us\": " << throughputResult.p999TickMicroseconds
+                     << ", \"rss_bytes\": " << throughputResult.residentSetBytes << "}"
+                     << (resultIndex + 1 < throughputResults.size() ? ",\n" : "\n");
+    }
+    outputStream << "  ]\n}\n";
+}
+
+/**
+ * @brief Headless end-to-end benchmark of the auto mode control loop
+ *
+ * Usage: WiperThroughputBenchmark [--vehicles=LIST] [--threads=LIST] [--ticks=N] [--tick-ms=N]
+ *                                 [--status-every=N] [--seed=S] [--json=PATH] [--trace-output=PATH]
+ * Every vehicle runs runSystem's auto mode tick (sample, decide, format the status line
+ * into a discarded stream) on virtual time. For each vehicle count and thread count the
+ * tool reports ticks/s, p50/p99/p99.9 tick latency, resident memory and the speedup over
+ * the first thread count, i.e. one point of the core-scaling curve per row.
+ * --trace-output writes the spans of the last configuration as a Chrome trace
+ * (instrumentation needs a WIPER_ENABLE_TRACING build).
+ * @return Exit status code
+ */
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> vehicleCounts = parseCountList("1,1000,10000");
+    std::vector<std::size_t> threadCounts;
+    std::uint64_t tickCount = 100;
+    unsigned int tickIntervalMilliseconds = 1000;
+    unsigned int statusDecimation = 1;
+    std::uint64_t randomSeed = 1;
+    const char* jsonOutputPath = nullptr;
+    const char* latencyTracePath = nullptr;
+
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        const char* argument = argv[argumentIndex];
+        if (std::strncmp(argument, "--vehicles=", 11) == 0) {
+            vehicleCounts = parseCountList(argument + 11);
+        } else if (std::strncmp(argument, "--threads=", 10) == 0) {
+            threadCounts = parseCountList(argument + 10);
+        } else if (std::strncmp(argument, "--ticks=", 8) == 0) {
+            tickCount = std::strtoull(argument + 8, nullptr, 10);
+        } else if (std::strncmp(argument, "--tick-ms=", 10) == 0) {
+            tickIntervalMilliseconds = static_cast<unsigned int>(std::strtoul(argument + 10, nullptr, 10));
+        } else if (std::strncmp(argument, "--status-every=", 15) == 0) {
+            statusDecimation = static_cast<unsigned int>(std::strtoul(argument + 15, nullptr, 10));
+        } else if (std::strncmp(argument, "--seed=", 7) == 0) {
+            randomSeed = std::strtoull(argument + 7, nullptr, 10);
+        } else if (std::strncmp(argument, "--json=", 7) == 0) {
+            jsonOutputPath = argument + 7;
+        } else if (std::strncmp(argument, "--trace-output=", 15) == 0) {
+            latencyTracePath = argument + 15;
+        } else {
+            vehicleCounts.clear();
+            break;
+        }
+    }
+
+    if (vehicleCounts.empty() || tickCount == 0 || tickIntervalMilliseconds == 0 || statusDecimation == 0) {
+        std::cerr << "Usage: " << argv[0] << " [--vehicles=LIST] [--threads=LIST] [--ticks=N] [--tick-ms=N]"
+                  << " [--status-every=N] [--seed=S] [--json=PATH] [--trace-output=PATH]" << std::endl;
+        return 1;
+    }
+
+    if (threadCounts.empty()) {
+        // Default curve: 1, 2, 4 ... up to every hardware thread
+        unsigned int hardwareThreadCount = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int threadCount = 1; threadCount < hardwareThreadCount; threadCount *= 2) {
+            threadCounts.push_back(threadCount);
+        }
+        threadCounts.push_back(hardwareThreadCount);
+    }
+
+    std::cout << std::setw(10) << "Vehicles" << std::setw(9) << "Threads" << std::setw(14) << "Ticks/s"
+              << std::setw(18) << "Vehicle-ticks/s" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us"
+              << std::setw(12) << "p99.9 us" << std::setw(10) << "RSS MB" << std::setw(10) << "Speedup" << std::endl;
+
+    std::vector<ThroughputResult> throughputResults;
+    for (std::size_t vehicleCount : vehicleCounts) {
+        double baselineTicksPerSecond = 0.0;
+        for (std::size_t threadCount : threadCounts) {
+            LatencyTracer::clear();
+            ThroughputResult throughputResult = measureThroughput(vehicleCount, static_cast<unsigned int>(threadCount), tickCount,
+                                                                  tickIntervalMilliseconds, statusDecimation, randomSeed);
+            if (baselineTicksPerSecond == 0.0) {
+                baselineTicksPerSecond = throughputResult.ticksPerSecond;
+            }
+            std::cout << std::setw(10) << throughputResult.vehicleCount << std::setw(9) << throughputResult.threadCount
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(14) << throughputResult.ticksPerSecond
+                      << std::setw(18) << throughputResult.vehicleTicksPerSecond
+                      << std::setw(12) << throughputResult.p50TickMicroseconds
+                      << std::setw(12) << throughputResult.p99TickMicroseconds
+                      << std::setw(12) << throughputResult.p999TickMicroseconds
+                      << std::setw(10) << (throughputResult.residentSetBytes / (1024.0 * 1024.0))
+                      << std::setw(9) << std::setprecision(2) << (throughputResult.ticksPerSecond / baselineTicksPerSecond) << "x"
+                      << std::endl;
+            throughputResults.push_back(throughputResult);
+        }
+    }
+
+    if (latencyTracePath != nullptr) {
+        if (!LatencyTracer::isCompiledIn()) {
+            std::cerr << "Latency tracing is not compiled in - rebuild with WIPER_ENABLE_TRACING" << std::endl;
+        }
+        if (!LatencyTracer::writeChromeTrace(latencyTracePath)) {
+            std::cerr << "Could not create " << latencyTracePath << std::endl;
+            return 1;
+        }
+    }
+
+    if (jsonOutputPath != nullptr) {
+        std::ofstream jsonFile(jsonOutputPath);
+        if (!jsonFile) {
+            std::cerr << "Could not create " << jsonOutputPath << std::endl;
+            return 1;
+        }
+        writeJsonResults(jsonFile, throughputResults);
+    }
+
+    return 0;
+}
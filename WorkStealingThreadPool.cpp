@@ -0,0 +1,132 @@
+#include "WorkStealingThreadPool.h"
+
+WorkStealingThreadPool::WorkStealingThreadPool(unsigned int threadCount)
+    : jobGeneration(0),
+      isShuttingDown(false),
+      currentTaskFunction(nullptr),
+      remainingTaskCount(0),
+      stolenTaskCount(0) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (unsigned int workerIndex = 0; workerIndex < threadCount; workerIndex++) {
+        workerQueues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    // Worker 0 is whichever thread calls parallelFor()
+    for (unsigned int workerIndex = 1; workerIndex < threadCount; workerIndex++) {
+        workerThreads.push_back(std::thread(&WorkStealingThreadPool::runWorker, this, workerIndex));
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+        isShuttingDown = true;
+    }
+    dispatchCondition.notify_all();
+    for (std::thread& workerThread : workerThreads) {
+        workerThread.join();
+    }
+}
+
+unsigned int WorkStealingThreadPool::getThreadCount() const {
+    return static_cast<unsigned int>(workerQueues.size());
+}
+
+void WorkStealingThreadPool::parallelFor(std::size_t taskCount, const TaskFunction& taskFunction) {
+    if (taskCount == 0) {
+        return;
+    }
+
+    // Publish the task body before any task becomes visible in a queue
+    currentTaskFunction.store(&taskFunction, std::memory_order_release);
+    remainingTaskCount.store(taskCount, std::memory_order_release);
+
+    // Deal contiguous runs so each worker starts on neighbouring data
+    std::size_t workerCount = workerQueues.size();
+    for (std::size_t workerIndex = 0; workerIndex < workerCount; workerIndex++) {
+        std::size_t firstTask = taskCount * workerIndex / workerCount;
+        std::size_t endTask = taskCount * (workerIndex + 1) / workerCount;
+        std::lock_guard<std::mutex> queueLock(workerQueues[workerIndex]->queueMutex);
+        for (std::size_t taskIndex = firstTask; taskIndex < endTask; taskIndex++) {
+            workerQueues[workerIndex]->taskIndices.push_back(taskIndex);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+        jobGeneration++;
+    }
+    dispatchCondition.notify_all();
+
+    runAvailableTasks(0);
+
+    std::unique_lock<std::mutex> dispatchLock(dispatchMutex);
+    completionCondition.wait(dispatchLock, [this] {
+        return remainingTaskCount.load(std::memory_order_acquire) == 0;
+    });
+}
+
+std::uint64_t WorkStealingThreadPool::getStolenTaskCount() const {
+    return stolenTaskCount.load(std::memory_order_relaxed);
+}
+
+void WorkStealingThreadPool::runWorker(unsigned int workerIndex) {
+    std::uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> dispatchLock(dispatchMutex);
+            dispatchCondition.wait(dispatchLock, [this, seenGeneration] {
+                return isShuttingDown || jobGeneration != seenGeneration;
+            });
+            if (isShuttingDown) {
+                return;
+            }
+            seenGeneration = jobGeneration;
+        }
+        runAvailableTasks(workerIndex);
+    }
+}
+
+void WorkStealingThreadPool::runAvailableTasks(unsigned int workerIndex) {
+    std::size_t taskIndex;
+    while (takeTask(workerIndex, taskIndex)) {
+        // A task is only in a queue while its job runs, so the published body is the right one
+        (*currentTaskFunction.load(std::memory_order_acquire))(taskIndex);
+
+        if (remainingTaskCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+            completionCondition.notify_all();
+        }
+    }
+}
+
+bool WorkStealingThreadPool::takeTask(unsigned int workerIndex, std::size_t& taskIndex) {
+    {
+        WorkerQueue& ownQueue = *workerQueues[workerIndex];
+        std::lock_guard<std::mutex> queueLock(ownQueue.queueMutex);
+        if (!ownQueue.taskIndices.empty()) {
+            taskIndex = ownQueue.taskIndices.front();
+            ownQueue.taskIndices.pop_front();
+            return true;
+        }
+    }
+
+    // Own queue is empty - steal from the far end of the next non-empty queue
+    std::size_t workerCount = workerQueues.size();
+    for (std::size_t victimOffset = 1; victimOffset < workerCount; victimOffset++) {
+        WorkerQueue& victimQueue = *workerQueues[(workerIndex + victimOffset) % workerCount];
+        std::lock_guard<std::mutex> queueLock(victimQueue.queueMutex);
+        if (!victimQueue.taskIndices.empty()) {
+            taskIndex = victimQueue.taskIndices.back();
+            victimQueue.taskIndices.pop_back();
+            stolenTaskCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,104 @@
+#ifndef WORK_STEALING_THREAD_POOL_H
+#define WORK_STEALING_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief WorkStealingThreadPool class to run indexed tasks across all cores
+ *
+ * parallelFor() deals the task indices out to per-worker queues in contiguous runs.
+ * Each worker drains its own queue front to back and, once empty, steals from the
+ * back of another worker's queue, so uneven shards balance without a central queue.
+ * The calling thread works as worker 0 while it waits.
+ */
+class WorkStealingThreadPool {
+public:
+    typedef std::function<void(std::size_t)> TaskFunction;
+
+    /**
+     * @brief Constructor for WorkStealingThreadPool
+     * @param threadCount Total workers including the calling thread (0 = one per hardware thread)
+     */
+    explicit WorkStealingThreadPool(unsigned int threadCount);
+
+    /**
+     * @brief Destructor that stops and joins the worker threads
+     */
+    ~WorkStealingThreadPool();
+
+    /**
+     * @brief Get the number of workers, including the calling thread
+     * @return Worker count
+     */
+    unsigned int getThreadCount() const;
+
+    /**
+     * @brief Run taskFunction(i) once for every i in [0, taskCount) and wait for all of them
+     * @param taskCount Number of tasks
+     * @param taskFunction Task body, called concurrently from several threads
+     */
+    void parallelFor(std::size_t taskCount, const TaskFunction& taskFunction);
+
+    /**
+     * @brief Get the number of tasks run by a worker other than the one they were dealt to
+     * @return Stolen task count since construction
+     */
+    std::uint64_t getStolenTaskCount() const;
+
+private:
+    WorkStealingThreadPool(const WorkStealingThreadPool&);
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&);
+
+    /**
+     * @brief Structure for one worker's task queue (padded so queues never share a cache line)
+     */
+    struct WorkerQueue {
+        std::mutex queueMutex;
+        std::deque<std::size_t> taskIndices;
+        char cacheLinePadding[64];
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
+    std::vector<std::thread> workerThreads;
+
+    std::mutex dispatchMutex;
+    std::condition_variable dispatchCondition;
+    std::condition_variable completionCondition;
+    std::uint64_t jobGeneration;
+    bool isShuttingDown;
+
+    std::atomic<const TaskFunction*> currentTaskFunction;
+    std::atomic<std::size_t> remainingTaskCount;
+    std::atomic<std::uint64_t> stolenTaskCount;
+
+    /**
+     * @brief Thread body for workers 1..N-1
+     * @param workerIndex Index of this worker's queue
+     */
+    void runWorker(unsigned int workerIndex);
+
+    /**
+     * @brief Run tasks from the own queue, then stolen ones, until none are left anywhere
+     * @param workerIndex Index of the calling worker
+     */
+    void runAvailableTasks(unsigned int workerIndex);
+
+    /**
+     * @brief Take the next task, preferring the worker's own queue
+     * @param workerIndex Index of the calling worker
+     * @param taskIndex Receives the task index
+     * @return False if every queue is empty
+     */
+    bool takeTask(unsigned int workerIndex, std::size_t& taskIndex);
+};
+
+#endif // WORK_STEALING_THREAD_POOL_H
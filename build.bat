@@ -2,7 +2,7 @@
 echo Building Rain-Sensing Wiper System...
 echo.
 
-g++ -Wall -Wextra -Wpedantic -std=c++11 main.cpp ColorUtilities.cpp WiperEnums.cpp RainSensor.cpp WindshieldWiperController.cpp WiperSystemManager.cpp -o WiperSystemPureAuto.exe
+g++ -Wall -Wextra -Wpedantic -std=c++11 main.cpp ColorUtilities.cpp WiperEnums.cpp RainSensor.cpp CounterBasedRandom.cpp LatencyTracer.cpp WindshieldWiperController.cpp SimulationClock.cpp ConsoleInput.cpp ConsoleEventLoop.cpp PeriodicScheduler.cpp EventLogger.cpp SensorTraceRecorder.cpp SensorTraceReplayer.cpp StatusDisplay.cpp StatusLineRenderer.cpp MetricsRegistry.cpp MetricsHttpEndpoint.cpp WiperSystemManager.cpp -o WiperSystemPureAuto.exe
 
 if %ERRORLEVEL% EQU 0 (
     echo.
@@ -1,17 +1,105 @@
 #include "WiperSystemManager.h"
 #include "ColorUtilities.h"
+#include "LatencyTracer.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 
 /**
  * @brief Main entry point for the Rain-Sensing Wiper System
+ *
+ * Options: --rate-hz=N (sensor sampling/control ticks per second, 1-1000),
+ * --status-hz=N (console status lines per second), --realtime-cpu=K
+ * (pin to CPU K with SCHED_FIFO), --lateness-report (print tick lateness on exit),
+ * --event-log=PATH (binary event log, decode with WiperEventLogDecoder),
+ * --sensor-trace=PATH (record every sensor reading and controller state),
+ * --replay-trace=PATH (use a recorded trace instead of the simulated sensor),
+ * --seed=S (reproducible simulated sensor readings),
+ * --trace-output=PATH (Chrome trace of the control loop spans, needs WIPER_ENABLE_TRACING),
+ * --metrics-report (print counters, dwell times and tick latency percentiles on exit),
+ * --metrics-port=N (serve Prometheus metrics on http://127.0.0.1:N/metrics)
  * @return Exit status code
  */
-int main() {
+int main(int argc, char* argv[]) {
     // Enable ANSI colors for Windows terminal
     enableAnsiColorSupport();
     
+    WiperSystemManager::SystemTimingConfiguration timingConfiguration;
+    timingConfiguration.controlRateHz = 1;
+    timingConfiguration.statusRateHz = 1;
+    timingConfiguration.realtimeCpuIndex = -1;
+    timingConfiguration.isLatenessReportEnabled = false;
+    
+    const char* eventLogPath = nullptr;
+    const char* sensorTracePath = nullptr;
+    const char* replayTracePath = nullptr;
+    const char* sensorSeedText = nullptr;
+    const char* latencyTracePath = nullptr;
+    bool isMetricsReportEnabled = false;
+    const char* metricsPortText = nullptr;
+    
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        const char* argument = argv[argumentIndex];
+        if (std::strncmp(argument, "--rate-hz=", 10) == 0) {
+            timingConfiguration.controlRateHz = static_cast<unsigned int>(std::strtoul(argument + 10, nullptr, 10));
+        } else if (std::strncmp(argument, "--status-hz=", 12) == 0) {
+            timingConfiguration.statusRateHz = static_cast<unsigned int>(std::strtoul(argument + 12, nullptr, 10));
+        } else if (std::strncmp(argument, "--realtime-cpu=", 15) == 0) {
+            timingConfiguration.realtimeCpuIndex = std::atoi(argument + 15);
+        } else if (std::strcmp(argument, "--lateness-report") == 0) {
+            timingConfiguration.isLatenessReportEnabled = true;
+        } else if (std::strncmp(argument, "--event-log=", 12) == 0) {
+            eventLogPath = argument + 12;
+        } else if (std::strncmp(argument, "--sensor-trace=", 15) == 0) {
+            sensorTracePath = argument + 15;
+        } else if (std::strncmp(argument, "--replay-trace=", 15) == 0) {
+            replayTracePath = argument + 15;
+        } else if (std::strncmp(argument, "--seed=", 7) == 0) {
+            sensorSeedText = argument + 7;
+        } else if (std::strncmp(argument, "--trace-output=", 15) == 0) {
+            latencyTracePath = argument + 15;
+        } else if (std::strcmp(argument, "--metrics-report") == 0) {
+            isMetricsReportEnabled = true;
+        } else if (std::strncmp(argument, "--metrics-port=", 15) == 0) {
+            metricsPortText = argument + 15;
+        }
+    }
+    
     // Create and run the wiper system
     WiperSystemManager wiperSystem;
+    wiperSystem.configureTiming(timingConfiguration);
+    if (sensorSeedText != nullptr) {
+        wiperSystem.setSensorSeed(std::strtoull(sensorSeedText, nullptr, 10));
+    }
+    if (eventLogPath != nullptr && !wiperSystem.enableEventLog(eventLogPath)) {
+        printColoredText(std::string("Could not create event log ") + eventLogPath + "\n", COLOR_RED);
+    }
+    if (sensorTracePath != nullptr && !wiperSystem.enableSensorTrace(sensorTracePath)) {
+        printColoredText(std::string("Could not create sensor trace ") + sensorTracePath + "\n", COLOR_RED);
+    }
+    if (replayTracePath != nullptr && !wiperSystem.enableSensorReplay(replayTracePath)) {
+        printColoredText(std::string("Could not open sensor trace ") + replayTracePath + "\n", COLOR_RED);
+        return 1;
+    }
+    if (metricsPortText != nullptr) {
+        unsigned short metricsPort = static_cast<unsigned short>(std::strtoul(metricsPortText, nullptr, 10));
+        if (wiperSystem.enableMetricsEndpoint(metricsPort)) {
+            printColoredText("Serving metrics on http://127.0.0.1:" + std::to_string(wiperSystem.getMetricsEndpointPort()) + "/metrics\n", COLOR_GREEN);
+        } else {
+            printColoredText(std::string("Could not serve metrics on port ") + metricsPortText + "\n", COLOR_RED);
+        }
+    }
+    if (latencyTracePath != nullptr && !LatencyTracer::isCompiledIn()) {
+        printColoredText("Latency tracing is not compiled in - rebuild with WIPER_ENABLE_TRACING\n", COLOR_YELLOW);
+    }
     wiperSystem.runSystem();
     
+    if (latencyTracePath != nullptr && !LatencyTracer::writeChromeTrace(latencyTracePath)) {
+        printColoredText(std::string("Could not write latency trace ") + latencyTracePath + "\n", COLOR_RED);
+    }
+    if (isMetricsReportEnabled) {
+        MetricsRegistry::printMetricsReport(wiperSystem.takeMetricsSnapshot(), std::cout);
+    }
+    
     return 0;
-}
\ No newline at end of file
+}
@@ -5,7 +5,7 @@ echo ========================================
 echo.
 
 echo Compiling automated test suite...
-g++ -Wall -Wextra -Wpedantic -std=c++11 AutomatedTests.cpp ColorUtilities.cpp WiperEnums.cpp RainSensor.cpp WindshieldWiperController.cpp -o AutomatedTests.exe
+g++ -Wall -Wextra -Wpedantic -std=c++11 AutomatedTests.cpp ColorUtilities.cpp WiperEnums.cpp RainSensor.cpp CounterBasedRandom.cpp LatencyTracer.cpp WindshieldWiperController.cpp SimulationClock.cpp WiperSpeedThresholdTable.cpp AutomaticModeTransitionTable.cpp PackedControllerState.cpp PeriodicScheduler.cpp EventLogger.cpp SensorTraceRecorder.cpp SensorTraceReplayer.cpp FleetSimulationEngine.cpp WorkStealingThreadPool.cpp HierarchicalTimerWheel.cpp MetricsRegistry.cpp MetricsHttpEndpoint.cpp StatusDisplay.cpp StatusLineRenderer.cpp ConsoleInput.cpp ConsoleEventLoop.cpp WiperSystemManager.cpp AllocationCounter.cpp -o AutomatedTests.exe
 
 if %ERRORLEVEL% NEQ 0 (
     echo COMPILATION FAILED!